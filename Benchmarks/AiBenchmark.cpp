@@ -0,0 +1,323 @@
+// AI request latency benchmark: the real processor and AI client against
+// MockProviderServer, run in-process on a free port, so no network, API key or
+// model is needed and every provider's streaming path can be timed.
+//
+// For each provider, a fresh processor sends the given number of suggestion
+// requests and then chat messages, one at a time. The message thread polls at
+// 30 Hz like the editor timer: it drains the chat stream and reports results as
+// shown. Each suggestion uses a different mic setting so the response cache
+// never answers it.
+//
+// Reported per provider and request kind: the client's own stage timings
+// (connect, first token, total, parse, apply; p50/p90/max from getAiLatencyStats),
+// the end-to-end time the benchmark saw from request to result, and failures.
+// With --error-rate, --stream-error-rate or --rate-limit the mock injects
+// failures; the run then reports how they surfaced instead of failing on them.
+//
+//   AR3SAiBenchmark [--requests=10] [--providers=ollama,openai,anthropic,openrouter,minimax]
+//                   [--connect-ms=50] [--first-token-ms=200] [--token-ms=15] [--jitter=0]
+//                   [--error-rate=0] [--stream-error-rate=0] [--rate-limit=0] [--seed=1]
+
+#include "../Source/PluginProcessor.h"
+#include "MockProviderServer.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr int POLL_MS = 33;  // Editor timer rate
+    constexpr int REQUEST_TIMEOUT_MS = 30000;
+
+    struct ProviderInfo
+    {
+        const char* name;
+        SimpleGainAudioProcessor::AiProvider provider;
+        const char* model;
+    };
+
+    const ProviderInfo allProviders[] = {
+        { "ollama",     SimpleGainAudioProcessor::AiProvider::Ollama,     "llama3" },
+        { "openai",     SimpleGainAudioProcessor::AiProvider::OpenAI,     "gpt-4o-mini" },
+        { "anthropic",  SimpleGainAudioProcessor::AiProvider::Anthropic,  "claude-3-5-haiku-20241022" },
+        { "openrouter", SimpleGainAudioProcessor::AiProvider::OpenRouter, "openai/gpt-4o" },
+        { "minimax",    SimpleGainAudioProcessor::AiProvider::MiniMax,    "abab6.5s-chat" }
+    };
+
+    struct Options
+    {
+        int requests = 10;
+        juce::StringArray providers { "ollama", "openai", "anthropic", "openrouter", "minimax" };
+        MockProviderServer::Settings mock;
+    };
+
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg(argv[i]);
+            const auto equals = arg.find('=');
+            const auto name = arg.substr(0, equals);
+            const auto value = equals == std::string::npos ? std::string() : arg.substr(equals + 1);
+
+            if (name == "--requests")
+                options.requests = std::atoi(value.c_str());
+            else if (name == "--providers")
+                options.providers = juce::StringArray::fromTokens(juce::String(value), ",", {});
+            else if (name == "--connect-ms")
+                options.mock.connectDelayMs = std::atoi(value.c_str());
+            else if (name == "--first-token-ms")
+                options.mock.firstTokenDelayMs = std::atoi(value.c_str());
+            else if (name == "--token-ms")
+                options.mock.tokenDelayMs = std::atoi(value.c_str());
+            else if (name == "--jitter")
+                options.mock.jitter = static_cast<float>(std::atof(value.c_str()));
+            else if (name == "--error-rate")
+                options.mock.errorRate = static_cast<float>(std::atof(value.c_str()));
+            else if (name == "--stream-error-rate")
+                options.mock.streamErrorRate = static_cast<float>(std::atof(value.c_str()));
+            else if (name == "--rate-limit")
+                options.mock.rateLimitPerMinute = std::atoi(value.c_str());
+            else if (name == "--seed")
+                options.mock.seed = std::atoll(value.c_str());
+            else
+            {
+                std::fprintf(stderr, "Usage: %s [--requests=10] [--providers=ollama,openai,anthropic,openrouter,minimax]\n"
+                                     "       [--connect-ms=50] [--first-token-ms=200] [--token-ms=15] [--jitter=0]\n"
+                                     "       [--error-rate=0] [--stream-error-rate=0] [--rate-limit=0] [--seed=1]\n", argv[0]);
+                return false;
+            }
+        }
+
+        if (options.requests < 1)
+        {
+            std::fprintf(stderr, "--requests must be at least 1\n");
+            return false;
+        }
+        for (const auto& provider : options.providers)
+        {
+            if (std::none_of(std::begin(allProviders), std::end(allProviders),
+                             [&provider](const ProviderInfo& info) { return provider == info.name; }))
+            {
+                std::fprintf(stderr, "Unknown provider '%s'\n", provider.toRawUTF8());
+                return false;
+            }
+        }
+        return true;
+    }
+
+    struct RunResult
+    {
+        int succeeded = 0;
+        int failed = 0;     // Error text, cut-off stream or no usable suggestion
+        int timedOut = 0;
+        std::vector<double> endToEndMs;  // Successful requests only
+    };
+
+    double percentile(std::vector<double> values, double fraction)
+    {
+        if (values.empty())
+            return 0.0;
+        std::sort(values.begin(), values.end());
+        const auto index = static_cast<size_t>(fraction * static_cast<double>(values.size() - 1) + 0.5);
+        return values[std::min(index, values.size() - 1)];
+    }
+
+    std::unique_ptr<SimpleGainAudioProcessor> createProcessor(const ProviderInfo& info)
+    {
+        auto processor = std::make_unique<SimpleGainAudioProcessor>();
+        processor->setPlayConfigDetails(2, 2, 48000.0, 512);
+        processor->prepareToPlay(48000.0, 512);
+        processor->setSpeculativeSuggestionsPerHour(0);  // Only the requests sent here
+        processor->setAiRaceMode(false);
+        processor->setApiKey("mock-key");
+        processor->setAiProvider(info.provider);
+        processor->setSelectedModel(info.model);
+
+        // Let the model list request triggered by setAiProvider finish first
+        juce::MessageManager::getInstance()->runDispatchLoopUntil(500);
+        processor->noteAiResultShown();
+        return processor;
+    }
+
+    // One editor timer tick: drain the chat stream, then report what's on screen as shown
+    void pollLikeEditor(SimpleGainAudioProcessor& processor, juce::String& chatText, bool& chatEnded)
+    {
+        juce::MessageManager::getInstance()->runDispatchLoopUntil(POLL_MS);
+
+        AiStreamChunk chunk;
+        while (processor.popChatStreamChunk(chunk))
+        {
+            if (chunk.kind == AiStreamChunk::Kind::Begin)
+                chatText.clear();
+            else if (chunk.kind == AiStreamChunk::Kind::Text)
+                chatText += chunk.getText();
+            else
+                chatEnded = true;
+        }
+        processor.noteAiResultShown();
+    }
+
+    RunResult runSuggestions(SimpleGainAudioProcessor& processor, int requests)
+    {
+        RunResult result;
+        for (int i = 0; i < requests; ++i)
+        {
+            processor.setSelectedMic("Benchmark mic " + juce::String(i));
+            const auto notesBefore = processor.getAiNotes();
+            const auto startMs = juce::Time::getMillisecondCounterHiRes();
+            processor.requestAiSuggestion("Rock", "Vocals", "Mixing");
+
+            // Every mock reply and error carries its request number, so the notes always change
+            juce::String chatText;
+            bool chatEnded = false;
+            bool done = false;
+            while (! done && juce::Time::getMillisecondCounterHiRes() - startMs < REQUEST_TIMEOUT_MS)
+            {
+                pollLikeEditor(processor, chatText, chatEnded);
+                done = processor.getAiNotes() != notesBefore;
+            }
+
+            if (! done)
+                ++result.timedOut;
+            else if (processor.getAiNotes().startsWith("Mock suggestion #"))
+            {
+                ++result.succeeded;
+                result.endToEndMs.push_back(juce::Time::getMillisecondCounterHiRes() - startMs);
+            }
+            else
+                ++result.failed;
+        }
+        return result;
+    }
+
+    RunResult runChat(SimpleGainAudioProcessor& processor, int requests)
+    {
+        RunResult result;
+        for (int i = 0; i < requests; ++i)
+        {
+            // A fresh conversation each time keeps the turns the same size
+            processor.startNewChatConversation();
+            const auto versionBefore = processor.getChatResponseVersion();
+            const auto startMs = juce::Time::getMillisecondCounterHiRes();
+            processor.requestChatMessage("How should I set the vocal compressor for this song?");
+
+            // Streamed replies end with an End chunk; errors replace the response instead
+            juce::String chatText;
+            bool chatEnded = false;
+            bool errorShown = false;
+            while (! chatEnded && ! errorShown && juce::Time::getMillisecondCounterHiRes() - startMs < REQUEST_TIMEOUT_MS)
+            {
+                pollLikeEditor(processor, chatText, chatEnded);
+                errorShown = processor.getChatResponseVersion() != versionBefore;
+            }
+
+            if (! chatEnded && ! errorShown)
+                ++result.timedOut;
+            else if (chatEnded && chatText.startsWith("Mock reply #") && ! chatText.contains("\n["))
+            {
+                ++result.succeeded;
+                result.endToEndMs.push_back(juce::Time::getMillisecondCounterHiRes() - startMs);
+            }
+            else
+                ++result.failed;
+        }
+        return result;
+    }
+
+    void printResult(const char* provider, const char* kind, const RunResult& result, const AiLatencyStats& stats)
+    {
+        std::printf("%-10s %-10s ok %3d  failed %3d  timed out %3d  end-to-end p50 %7.1f ms  p90 %7.1f ms\n",
+                    provider, kind, result.succeeded, result.failed, result.timedOut,
+                    percentile(result.endToEndMs, 0.5), percentile(result.endToEndMs, 0.9));
+
+        for (int stage = 0; stage < AiLatencyStats::NUM_STAGES; ++stage)
+        {
+            const auto summary = stats.get(static_cast<AiLatencyStats::Stage>(stage));
+            if (summary.samples == 0)
+                continue;
+            std::printf("%22s %-12s n %3d  p50 %7.1f ms  p90 %7.1f ms  max %7.1f ms\n", "",
+                        AiLatencyStats::getStageName(static_cast<AiLatencyStats::Stage>(stage)),
+                        summary.samples, summary.p50Ms, summary.p90Ms, summary.maxMs);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (! parseOptions(argc, argv, options))
+        return 1;
+
+    MockProviderServer server(options.mock);
+    if (! server.start(0))
+    {
+        std::fprintf(stderr, "Could not start the mock provider\n");
+        return 1;
+    }
+
+    // Scratch shared memory and data folder, so a running session and the
+    // user's settings, caches and logs are never touched; every provider at the mock
+    const auto scratch = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                             .getChildFile("ar3s_ai_bench_" + juce::String(static_cast<int>(::getpid())));
+    scratch.createDirectory();
+    ::setenv("AR3S_DATA_DIR", scratch.getFullPathName().toRawUTF8(), 1);
+    ::setenv("AR3S_SHARED_MEMORY_FILE", scratch.getChildFile("shared_memory.bin").getFullPathName().toRawUTF8(), 1);
+
+    const auto baseUrl = server.getBaseUrl();
+    ::setenv("OLLAMA_API_URL", baseUrl.toRawUTF8(), 1);
+    ::unsetenv("OLLAMA_API_KEY");
+    ::setenv("OPENAI_BASE_URL", (baseUrl + "/v1").toRawUTF8(), 1);
+    ::setenv("OPENROUTER_BASE_URL", (baseUrl + "/v1").toRawUTF8(), 1);
+    ::setenv("MINIMAX_BASE_URL", (baseUrl + "/v1").toRawUTF8(), 1);
+    ::setenv("ANTHROPIC_BASE_URL", baseUrl.toRawUTF8(), 1);
+
+    const bool injectingFailures = options.mock.errorRate > 0.0f || options.mock.streamErrorRate > 0.0f
+                                || options.mock.rateLimitPerMinute > 0;
+    std::printf("AI benchmark: mock at %s, %d requests of each kind per provider, "
+                "connect %d ms, first token %d ms, %d ms/token\n",
+                baseUrl.toRawUTF8(), options.requests, options.mock.connectDelayMs,
+                options.mock.firstTokenDelayMs, options.mock.tokenDelayMs);
+
+    bool ok = true;
+    {
+        juce::ScopedJuceInitialiser_GUI juceInitialiser;
+        for (const auto& info : allProviders)
+        {
+            if (! options.providers.contains(info.name))
+                continue;
+
+            // A processor per kind, so each keeps its own stage timings
+            {
+                auto processor = createProcessor(info);
+                const auto result = runSuggestions(*processor, options.requests);
+                printResult(info.name, "suggestion", result, processor->getAiLatencyStats());
+                if (! injectingFailures && result.succeeded != options.requests)
+                    ok = false;
+            }
+            {
+                auto processor = createProcessor(info);
+                const auto result = runChat(*processor, options.requests);
+                printResult(info.name, "chat", result, processor->getAiLatencyStats());
+                if (! injectingFailures && result.succeeded != options.requests)
+                    ok = false;
+            }
+        }
+    }
+
+    server.stop();
+    const auto stats = server.getStats();
+    std::printf("Mock provider: %llu requests, %llu streamed, %llu errors, %llu rate limited, %llu unauthorised\n",
+                static_cast<unsigned long long>(stats.requests), static_cast<unsigned long long>(stats.streamed),
+                static_cast<unsigned long long>(stats.errors), static_cast<unsigned long long>(stats.rateLimited),
+                static_cast<unsigned long long>(stats.unauthorised));
+
+    scratch.deleteRecursively();
+    if (! ok)
+        std::fprintf(stderr, "FAILED: requests failed with no failures injected\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,478 @@
+// Forking benchmark of the master <-> satellite shared-memory path.
+//
+// Each child process plays one satellite: it claims a slot and, at the block
+// rate of a 512-sample / 48 kHz host, heartbeats, writes its metering, pushes
+// meter history at 20 Hz and drains its command queue the way
+// SatelliteProcessor::drainMasterCommands does. The parent plays the master:
+// it queues batched SetControl commands to every slot at a fixed rate and
+// times full sweeps of every slot (the reads getSatelliteInfo does).
+//
+// Reported per satellite count: sweep cost (p50/p99, and per slot), cache
+// misses per sweep (Linux perf counters, "n/a" where unavailable), command
+// latency from push to apply (p50/p90/p99/max) and dropped commands. Latency
+// includes waiting for the satellite's next block boundary, as it does in a host.
+//
+// The shared-memory layout holds MAX_SATELLITES (32) slots, so that is the
+// largest count this can run; going beyond it needs a layout change.
+//
+//   AR3SIpcBenchmark [--satellites=1,2,4,8,16,32] [--seconds=5] [--batches-per-second=50]
+
+#include "../Source/SharedMemory.h"
+
+#include <sys/wait.h>
+#include <algorithm>
+#include <cstdio>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+#endif
+
+namespace
+{
+    constexpr int BLOCK_SIZE = 512;
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int MAX_SAMPLES_PER_SATELLITE = 1 << 16;
+
+    // What each child reports back, in an anonymous mapping shared across the fork
+    struct SatelliteReport
+    {
+        std::atomic<int> state { 0 };  // 0 = starting, 1 = slot claimed, -1 = no slot
+        std::atomic<uint32_t> samples { 0 };
+        std::atomic<uint32_t> resyncs { 0 };
+        std::atomic<uint32_t> lateBlocks { 0 };  // Block work finished past its deadline
+        int64_t latencyUs[MAX_SAMPLES_PER_SATELLITE];
+    };
+
+    struct BenchmarkShared
+    {
+        std::atomic<bool> stop { false };
+        SatelliteReport satellites[MAX_SATELLITES];
+    };
+
+    struct Options
+    {
+        std::vector<int> satelliteCounts { 1, 2, 4, 8, 16, 32 };
+        double seconds = 5.0;
+        double batchesPerSecond = 50.0;
+    };
+
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg(argv[i]);
+            const auto equals = arg.find('=');
+            const auto name = arg.substr(0, equals);
+            const auto value = equals == std::string::npos ? std::string() : arg.substr(equals + 1);
+
+            if (name == "--satellites")
+            {
+                options.satelliteCounts.clear();
+                size_t start = 0;
+                while (start < value.size())
+                {
+                    const auto comma = value.find(',', start);
+                    const auto count = std::atoi(value.substr(start, comma - start).c_str());
+                    if (count < 1 || count > MAX_SATELLITES)
+                    {
+                        std::fprintf(stderr, "Satellite counts must be 1-%d (the shared-memory layout has %d slots)\n",
+                                     MAX_SATELLITES, MAX_SATELLITES);
+                        return false;
+                    }
+                    options.satelliteCounts.push_back(count);
+                    start = comma == std::string::npos ? value.size() : comma + 1;
+                }
+            }
+            else if (name == "--seconds")
+            {
+                options.seconds = std::atof(value.c_str());
+            }
+            else if (name == "--batches-per-second")
+            {
+                options.batchesPerSecond = std::atof(value.c_str());
+            }
+            else
+            {
+                std::fprintf(stderr, "Usage: %s [--satellites=1,2,4,8,16,32] [--seconds=5] [--batches-per-second=50]\n", argv[0]);
+                return false;
+            }
+        }
+
+        return ! options.satelliteCounts.empty() && options.seconds > 0.0 && options.batchesPerSecond > 0.0;
+    }
+
+    template <typename T>
+    T percentile(std::vector<T>& sorted, double fraction)
+    {
+        if (sorted.empty())
+            return T {};
+        return sorted[static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1))];
+    }
+
+    // Hardware cache misses of the calling thread, where the kernel lets us count them
+    class CacheMissCounter
+    {
+    public:
+        CacheMissCounter()
+        {
+#if defined(__linux__)
+            perf_event_attr attr {};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd = static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+        }
+
+        ~CacheMissCounter()
+        {
+            if (fd >= 0)
+                ::close(fd);
+        }
+
+        bool isAvailable() const { return fd >= 0; }
+
+        void start()
+        {
+#if defined(__linux__)
+            if (fd >= 0)
+            {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        uint64_t stop()
+        {
+            uint64_t count = 0;
+#if defined(__linux__)
+            if (fd >= 0)
+            {
+                ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                if (::read(fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count)))
+                    count = 0;
+            }
+#endif
+            return count;
+        }
+
+    private:
+        int fd = -1;
+    };
+
+    // One satellite process: claim a slot, then run blocks until told to stop
+    [[noreturn]] void runSatellite(int child, BenchmarkShared& shared)
+    {
+        auto& report = shared.satellites[child];
+
+        SharedMemoryManager sharedMemory;
+        if (! sharedMemory.openOrCreate())
+        {
+            report.state.store(-1);
+            ::_exit(2);
+        }
+
+        auto* memData = sharedMemory.getData();
+        const auto instanceId = (static_cast<uint64_t>(::getpid()) << 16) | static_cast<uint64_t>(child);
+        uint32_t generation = 0;
+        const int index = memData->claimSlot(instanceId, static_cast<int32_t>(::getpid()), generation);
+        if (index < 0)
+        {
+            report.state.store(-1);
+            ::_exit(3);
+        }
+
+        auto& sat = memData->satellites[index];
+        std::snprintf(sat.channelName, sizeof(sat.channelName), "Bench %d", child + 1);
+        sat.commands.skipAll();
+        report.state.store(1);
+
+        const auto blockPeriod = std::chrono::duration<double>(BLOCK_SIZE / SAMPLE_RATE);
+        auto deadline = std::chrono::steady_clock::now();
+        int64_t lastHistoryMs = 0;
+        float level = -18.0f - static_cast<float>(child % 7);
+
+        while (! shared.stop.load(std::memory_order_acquire))
+        {
+            deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(blockPeriod);
+            const auto nowMs = getMonotonicMillis();
+
+            sat.rmsDb.store(level);
+            sat.peakDb.store(level + 9.0f);
+            sat.crestDb.store(9.0f);
+            sat.currentGain.store(1.0f);
+            sat.lastUpdateTime.store(nowMs);
+            if (nowMs - lastHistoryMs >= 1000 / MeterHistoryRing::RATE_HZ)
+            {
+                sat.history.push(nowMs, level, level + 9.0f, 9.0f);
+                lastHistoryMs = nowMs;
+            }
+
+            if (sat.commands.resyncRequested.exchange(false))
+            {
+                sat.commands.skipAll();
+                report.resyncs.fetch_add(1);
+            }
+
+            const auto committedBatch = memData->committedBatch.load(std::memory_order_acquire);
+            const auto nowUs = getMonotonicMicros();
+            SatelliteCommand command;
+            uint64_t lastApplied = 0;
+            while (sat.commands.pop(command, committedBatch))
+            {
+                if (command.type == SatelliteCommandType::None || command.issuedAtUs <= 0)
+                    continue;
+
+                const auto latencyUs = nowUs - command.issuedAtUs;
+                sat.commandLatency.record(latencyUs);
+                const auto n = report.samples.load(std::memory_order_relaxed);
+                if (n < MAX_SAMPLES_PER_SATELLITE)
+                {
+                    report.latencyUs[n] = latencyUs;
+                    report.samples.store(n + 1, std::memory_order_release);
+                }
+                lastApplied = command.sequence;
+                level = -18.0f + command.gainDb;
+            }
+            if (lastApplied != 0)
+                sat.appliedCommandSequence.store(lastApplied);
+
+            if (std::chrono::steady_clock::now() > deadline)
+                report.lateBlocks.fetch_add(1);
+            std::this_thread::sleep_until(deadline);
+        }
+
+        memData->releaseSlot(index, instanceId);
+        ::_exit(0);
+    }
+
+    // The master's reads of one slot (what getSatelliteInfo copies out)
+    float readSlot(const SharedPluginData& memData, int index, int64_t nowMs)
+    {
+        const auto& sat = memData.satellites[index];
+        if (! memData.isSlotLive(index, nowMs, 3000))
+            return 0.0f;
+
+        char name[sizeof(sat.channelName)];
+        std::memcpy(name, sat.channelName, sizeof(name));
+        float sum = static_cast<float>(name[0]);
+        sum += sat.rmsDb.load() + sat.peakDb.load() + sat.crestDb.load() + sat.phaseCorrelation.load();
+        sum += sat.currentGain.load() + static_cast<float>(sat.sourceType.load() + sat.groupId.load());
+        sum += sat.momentaryLufs.load() + sat.shortTermLufs.load() + sat.integratedLufs.load() + sat.truePeakDb.load();
+        sum += static_cast<float>(sat.generation.load());
+        sum += sat.control.gainDb.load() + sat.control.targetDb.load() + sat.control.ceilingDb.load();
+        sum += sat.control.riderAmount.load() + (sat.control.autoEnabled.load() ? 1.0f : 0.0f);
+        return sum;
+    }
+
+    struct RunResult
+    {
+        bool ok = false;
+        std::vector<int64_t> sweepNs;
+        std::vector<int64_t> latencyUs;
+        uint64_t cacheMisses = 0;
+        bool cacheMissesAvailable = false;
+        uint64_t sent = 0;
+        uint64_t dropped = 0;
+        uint64_t resyncs = 0;
+        uint64_t lateBlocks = 0;
+    };
+
+    RunResult runWithSatellites(int numSatellites, const Options& options, const std::string& shmPath)
+    {
+        RunResult result;
+
+        // Every run starts from a freshly created file
+        ::unlink(shmPath.c_str());
+        SharedMemoryManager sharedMemory;
+        if (! sharedMemory.openOrCreate())
+        {
+            std::fprintf(stderr, "Could not map %s\n", shmPath.c_str());
+            return result;
+        }
+        auto* memData = sharedMemory.getData();
+
+        void* mapping = ::mmap(nullptr, sizeof(BenchmarkShared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED)
+        {
+            std::fprintf(stderr, "Could not map the report area, errno=%d\n", errno);
+            return result;
+        }
+        auto* shared = new (mapping) BenchmarkShared();
+
+        std::vector<pid_t> children;
+        for (int child = 0; child < numSatellites; ++child)
+        {
+            const auto pid = ::fork();
+            if (pid == 0)
+                runSatellite(child, *shared);
+            if (pid < 0)
+            {
+                std::fprintf(stderr, "fork failed, errno=%d\n", errno);
+                break;
+            }
+            children.push_back(pid);
+        }
+
+        // Wait for every satellite to hold a slot before timing anything
+        bool allClaimed = static_cast<int>(children.size()) == numSatellites;
+        const auto claimDeadline = getMonotonicMillis() + 5000;
+        for (int child = 0; allClaimed && child < numSatellites; ++child)
+        {
+            while (shared->satellites[child].state.load() == 0 && getMonotonicMillis() < claimDeadline)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            allClaimed = shared->satellites[child].state.load() == 1;
+        }
+
+        if (allClaimed)
+        {
+            CacheMissCounter cacheMisses;
+            result.cacheMissesAvailable = cacheMisses.isAvailable();
+
+            const auto startUs = getMonotonicMicros();
+            const auto endUs = startUs + static_cast<int64_t>(options.seconds * 1.0e6);
+            const auto batchPeriodUs = static_cast<int64_t>(1.0e6 / options.batchesPerSecond);
+            auto nextBatchUs = startUs;
+            float sink = 0.0f;
+            int batchNumber = 0;
+
+            while (getMonotonicMicros() < endUs)
+            {
+                // Master: one batch = one SetControl per slot, committed together
+                if (getMonotonicMicros() >= nextBatchUs)
+                {
+                    nextBatchUs += batchPeriodUs;
+                    const auto batchId = memData->allocateBatchId();
+                    SatelliteCommand command;
+                    command.type = SatelliteCommandType::SetControl;
+                    command.batchId = batchId;
+                    command.gainDb = static_cast<float>(batchNumber++ % 13 - 6);
+                    for (int i = 0; i < MAX_SATELLITES; ++i)
+                    {
+                        if (! memData->satellites[i].active.load())
+                            continue;
+                        command.issuedAtUs = getMonotonicMicros();
+                        ++result.sent;
+                        if (! memData->satellites[i].commands.push(command))
+                            ++result.dropped;
+                    }
+                    memData->commitBatch(batchId);
+                }
+
+                // Master: a full sweep, as the editor and AI context do
+                const auto nowMs = getMonotonicMillis();
+                cacheMisses.start();
+                const auto sweepStart = std::chrono::steady_clock::now();
+                for (int i = 0; i < MAX_SATELLITES; ++i)
+                    sink += readSlot(*memData, i, nowMs);
+                const auto sweepEnd = std::chrono::steady_clock::now();
+                result.cacheMisses += cacheMisses.stop();
+                result.sweepNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(sweepEnd - sweepStart).count());
+
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+            }
+
+            if (sink == 1.0e30f)
+                std::printf("\n");  // Keeps the sweep reads from being optimised away
+            result.ok = true;
+        }
+        else
+        {
+            int claimed = 0;
+            for (int child = 0; child < numSatellites; ++child)
+                claimed += shared->satellites[child].state.load() == 1 ? 1 : 0;
+            std::fprintf(stderr, "Only %d of %d satellites got a slot\n", claimed, numSatellites);
+        }
+
+        // Let the satellites drain the last batch, then stop them
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        shared->stop.store(true, std::memory_order_release);
+        for (const auto pid : children)
+        {
+            int status = 0;
+            ::waitpid(pid, &status, 0);
+            if (! WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                result.ok = false;
+        }
+
+        for (int child = 0; child < numSatellites; ++child)
+        {
+            const auto& report = shared->satellites[child];
+            const auto samples = report.samples.load(std::memory_order_acquire);
+            result.latencyUs.insert(result.latencyUs.end(), report.latencyUs, report.latencyUs + samples);
+            result.resyncs += report.resyncs.load();
+            result.lateBlocks += report.lateBlocks.load();
+        }
+
+        shared->~BenchmarkShared();
+        ::munmap(mapping, sizeof(BenchmarkShared));
+        sharedMemory.close();
+        ::unlink(shmPath.c_str());
+        return result;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (! parseOptions(argc, argv, options))
+        return 1;
+
+    // Keep off the file a running session uses
+    const std::string shmPath = "/tmp/ar3s_ipc_benchmark_" + std::to_string(::getpid()) + ".bin";
+    ::setenv("AR3S_SHARED_MEMORY_FILE", shmPath.c_str(), 1);
+
+    std::printf("Block %d samples @ %.0f Hz, %.1f s per run, %.0f command batches/s\n",
+                BLOCK_SIZE, SAMPLE_RATE, options.seconds, options.batchesPerSecond);
+    std::printf("%5s | %9s %9s %9s | %12s | %8s %8s %8s %8s | %8s %8s %8s %6s\n",
+                "sats", "sweep p50", "p99 ns", "ns/slot", "misses/sweep",
+                "lat p50", "p90", "p99", "max us", "sent", "applied", "dropped", "late");
+
+    bool allOk = true;
+    for (const auto numSatellites : options.satelliteCounts)
+    {
+        auto result = runWithSatellites(numSatellites, options, shmPath);
+        std::sort(result.sweepNs.begin(), result.sweepNs.end());
+        std::sort(result.latencyUs.begin(), result.latencyUs.end());
+
+        char misses[32];
+        if (result.cacheMissesAvailable && ! result.sweepNs.empty())
+            std::snprintf(misses, sizeof(misses), "%.1f", static_cast<double>(result.cacheMisses) / static_cast<double>(result.sweepNs.size()));
+        else
+            std::snprintf(misses, sizeof(misses), "n/a");
+
+        const auto sweepP50 = percentile(result.sweepNs, 0.5);
+        std::printf("%5d | %9lld %9lld %9lld | %12s | %8lld %8lld %8lld %8lld | %8llu %8llu %8llu %6llu\n",
+                    numSatellites,
+                    static_cast<long long>(sweepP50),
+                    static_cast<long long>(percentile(result.sweepNs, 0.99)),
+                    static_cast<long long>(sweepP50 / MAX_SATELLITES),
+                    misses,
+                    static_cast<long long>(percentile(result.latencyUs, 0.5)),
+                    static_cast<long long>(percentile(result.latencyUs, 0.9)),
+                    static_cast<long long>(percentile(result.latencyUs, 0.99)),
+                    static_cast<long long>(result.latencyUs.empty() ? 0 : result.latencyUs.back()),
+                    static_cast<unsigned long long>(result.sent),
+                    static_cast<unsigned long long>(result.latencyUs.size()),
+                    static_cast<unsigned long long>(result.dropped),
+                    static_cast<unsigned long long>(result.lateBlocks));
+
+        if (! result.ok || (result.sent > 0 && result.latencyUs.empty()))
+        {
+            std::fprintf(stderr, "Run with %d satellites failed\n", numSatellites);
+            allOk = false;
+        }
+    }
+
+    return allOk ? 0 : 1;
+}
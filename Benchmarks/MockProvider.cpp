@@ -0,0 +1,90 @@
+// Runs MockProviderServer on its own, to point a plugin (or curl) at by hand.
+//
+//   AR3SMockProvider [--port=11434] [--connect-ms=50] [--first-token-ms=200] [--token-ms=15]
+//                    [--jitter=0] [--error-rate=0] [--stream-error-rate=0] [--rate-limit=0] [--seed=1]
+
+#include "MockProviderServer.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    std::atomic<bool> quitRequested { false };
+
+    void requestQuit(int)
+    {
+        quitRequested.store(true);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int port = 11434;
+    MockProviderServer::Settings settings;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        const auto equals = arg.find('=');
+        const auto name = arg.substr(0, equals);
+        const auto value = equals == std::string::npos ? std::string() : arg.substr(equals + 1);
+
+        if (name == "--port")
+            port = std::atoi(value.c_str());
+        else if (name == "--connect-ms")
+            settings.connectDelayMs = std::atoi(value.c_str());
+        else if (name == "--first-token-ms")
+            settings.firstTokenDelayMs = std::atoi(value.c_str());
+        else if (name == "--token-ms")
+            settings.tokenDelayMs = std::atoi(value.c_str());
+        else if (name == "--jitter")
+            settings.jitter = static_cast<float>(std::atof(value.c_str()));
+        else if (name == "--error-rate")
+            settings.errorRate = static_cast<float>(std::atof(value.c_str()));
+        else if (name == "--stream-error-rate")
+            settings.streamErrorRate = static_cast<float>(std::atof(value.c_str()));
+        else if (name == "--rate-limit")
+            settings.rateLimitPerMinute = std::atoi(value.c_str());
+        else if (name == "--seed")
+            settings.seed = std::atoll(value.c_str());
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [--port=11434] [--connect-ms=50] [--first-token-ms=200] [--token-ms=15]\n"
+                                 "       [--jitter=0] [--error-rate=0] [--stream-error-rate=0] [--rate-limit=0] [--seed=1]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    MockProviderServer server(settings);
+    if (! server.start(port))
+    {
+        std::fprintf(stderr, "Could not listen on 127.0.0.1:%d\n", port);
+        return 1;
+    }
+
+    const auto baseUrl = server.getBaseUrl();
+    std::printf("Mock provider listening on %s. Point AR3S at it with:\n"
+                "  OLLAMA_API_URL=%s\n"
+                "  OPENAI_BASE_URL=%s/v1 OPENROUTER_BASE_URL=%s/v1 MINIMAX_BASE_URL=%s/v1\n"
+                "  ANTHROPIC_BASE_URL=%s\n"
+                "Ctrl-C to stop.\n",
+                baseUrl.toRawUTF8(), baseUrl.toRawUTF8(), baseUrl.toRawUTF8(), baseUrl.toRawUTF8(),
+                baseUrl.toRawUTF8(), baseUrl.toRawUTF8());
+    std::fflush(stdout);
+
+    std::signal(SIGINT, requestQuit);
+    std::signal(SIGTERM, requestQuit);
+    while (! quitRequested.load())
+        juce::Thread::sleep(100);
+
+    server.stop();
+    const auto stats = server.getStats();
+    std::printf("\n%llu requests: %llu streamed, %llu errors, %llu rate limited, %llu unauthorised\n",
+                static_cast<unsigned long long>(stats.requests), static_cast<unsigned long long>(stats.streamed),
+                static_cast<unsigned long long>(stats.errors), static_cast<unsigned long long>(stats.rateLimited),
+                static_cast<unsigned long long>(stats.unauthorised));
+    return 0;
+}
@@ -0,0 +1,441 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <deque>
+#include <map>
+
+// Local HTTP stand-in for the AI providers, so the AI path can be timed and
+// exercised offline. It answers the endpoints PluginProcessor.cpp uses, in each
+// provider's streaming format:
+//   Ollama      POST /api/chat (NDJSON), POST /api/generate (warm-up), GET /api/tags
+//   OpenAI      POST .../chat/completions (SSE), GET .../models       (also OpenRouter)
+//   MiniMax     POST .../text/chatcompletion_v2 (OpenAI-style SSE)
+//   Anthropic   POST .../v1/messages (SSE)
+// Point the plugin at it with OLLAMA_API_URL=http://127.0.0.1:<port> and
+// OPENAI_BASE_URL / OPENROUTER_BASE_URL / MINIMAX_BASE_URL=http://127.0.0.1:<port>/v1,
+// ANTHROPIC_BASE_URL=http://127.0.0.1:<port>.
+//
+// Requests whose prompt asks for the gain_db JSON get a structured suggestion
+// (what applyAiResponseText accepts); anything else gets a short chat reply.
+// Replies are streamed a few characters per token. Latency, injected errors and
+// rate limiting are set through Settings.
+class MockProviderServer
+{
+public:
+    struct Settings
+    {
+        int connectDelayMs = 50;       // Before the response headers (connection + queueing + model load)
+        int firstTokenDelayMs = 200;   // Headers -> first token
+        int tokenDelayMs = 15;         // Between tokens
+        float jitter = 0.0f;           // Each delay is scaled by 1 +/- jitter at random
+        float errorRate = 0.0f;        // Fraction of requests answered with HTTP 500
+        float streamErrorRate = 0.0f;  // Fraction of replies cut off by an error event halfway through
+        int rateLimitPerMinute = 0;    // Requests over this in any 60 s get HTTP 429 (0 = no limit)
+        int64_t seed = 1;
+    };
+
+    struct Stats
+    {
+        uint64_t requests = 0;
+        uint64_t streamed = 0;      // Replies streamed to the end
+        uint64_t errors = 0;        // HTTP 500 and mid-stream errors
+        uint64_t rateLimited = 0;
+        uint64_t unauthorised = 0;
+    };
+
+    explicit MockProviderServer(const Settings& serverSettings)
+        : settings(serverSettings), random(serverSettings.seed) {}
+
+    ~MockProviderServer()
+    {
+        stop();
+    }
+
+    // port 0 picks a free one. Returns false if the port can't be bound.
+    bool start(int port)
+    {
+        if (! listener.createListener(port, "127.0.0.1"))
+            return false;
+
+        acceptThread = std::make_unique<AcceptThread>(*this);
+        acceptThread->startThread();
+        return true;
+    }
+
+    void stop()
+    {
+        stopping.store(true);
+        listener.close();
+        if (acceptThread != nullptr)
+            acceptThread->stopThread(2000);
+        acceptThread.reset();
+
+        // Handlers check the flag between tokens, so they finish quickly
+        for (int i = 0; i < 500 && activeConnections.load() > 0; ++i)
+            juce::Thread::sleep(10);
+    }
+
+    int getPort() const { return listener.getBoundPort(); }
+
+    juce::String getBaseUrl() const { return "http://127.0.0.1:" + juce::String(getPort()); }
+
+    Stats getStats() const
+    {
+        Stats stats;
+        stats.requests = requests.load();
+        stats.streamed = streamed.load();
+        stats.errors = errors.load();
+        stats.rateLimited = rateLimited.load();
+        stats.unauthorised = unauthorised.load();
+        return stats;
+    }
+
+private:
+    enum class Format { OllamaNdjson, OpenAiSse, AnthropicSse };
+
+    struct Request
+    {
+        juce::String method;
+        juce::String path;
+        juce::String headers;  // Lower-cased
+        juce::String body;
+    };
+
+    class AcceptThread : public juce::Thread
+    {
+    public:
+        explicit AcceptThread(MockProviderServer& owner) : juce::Thread("Mock provider"), server(owner) {}
+
+        void run() override
+        {
+            while (! threadShouldExit() && ! server.stopping.load())
+            {
+                std::shared_ptr<juce::StreamingSocket> connection(server.listener.waitForNextConnection());
+                if (connection == nullptr)
+                    break;
+
+                ++server.activeConnections;
+                auto* owner = &server;
+                juce::Thread::launch([owner, connection]
+                {
+                    owner->handleConnection(*connection);
+                    connection->close();
+                    --owner->activeConnections;
+                });
+            }
+        }
+
+    private:
+        MockProviderServer& server;
+    };
+
+    // Sleeps in short steps so stop() isn't held up; false once stopping
+    bool pause(int ms)
+    {
+        ms = scaleDelay(ms);
+        for (int waited = 0; waited < ms && ! stopping.load(); waited += 5)
+            juce::Thread::sleep(std::min(5, ms - waited));
+        return ! stopping.load();
+    }
+
+    int scaleDelay(int ms)
+    {
+        if (settings.jitter <= 0.0f || ms <= 0)
+            return ms;
+        const juce::ScopedLock lock(randomLock);
+        return juce::roundToInt(static_cast<float>(ms) * (1.0f + settings.jitter * (2.0f * random.nextFloat() - 1.0f)));
+    }
+
+    bool chance(float probability)
+    {
+        if (probability <= 0.0f)
+            return false;
+        const juce::ScopedLock lock(randomLock);
+        return random.nextFloat() < probability;
+    }
+
+    // Sliding 60 s window over accepted requests
+    bool isRateLimited()
+    {
+        if (settings.rateLimitPerMinute <= 0)
+            return false;
+
+        const auto now = juce::Time::getMillisecondCounterHiRes();
+        const juce::ScopedLock lock(randomLock);
+        while (! recentRequestsMs.empty() && now - recentRequestsMs.front() > 60000.0)
+            recentRequestsMs.pop_front();
+        if (static_cast<int>(recentRequestsMs.size()) >= settings.rateLimitPerMinute)
+            return true;
+        recentRequestsMs.push_back(now);
+        return false;
+    }
+
+    static bool readRequest(juce::StreamingSocket& socket, Request& request)
+    {
+        juce::MemoryBlock head;
+        char c = 0;
+        while (! head.toString().endsWith("\r\n\r\n"))
+        {
+            if (head.getSize() > 65536 || socket.waitUntilReady(true, 5000) != 1 || socket.read(&c, 1, true) != 1)
+                return false;
+            head.append(&c, 1);
+        }
+
+        auto lines = juce::StringArray::fromLines(head.toString().trim());
+        if (lines.isEmpty())
+            return false;
+        auto requestLine = juce::StringArray::fromTokens(lines[0], " ", {});
+        if (requestLine.size() < 2)
+            return false;
+        request.method = requestLine[0];
+        request.path = requestLine[1].upToFirstOccurrenceOf("?", false, false);
+        lines.remove(0);
+        request.headers = lines.joinIntoString("\n").toLowerCase();
+
+        int contentLength = 0;
+        for (const auto& line : lines)
+            if (line.startsWithIgnoreCase("content-length:"))
+                contentLength = line.fromFirstOccurrenceOf(":", false, false).trim().getIntValue();
+
+        juce::MemoryBlock body;
+        body.setSize(static_cast<size_t>(juce::jlimit(0, 16 * 1024 * 1024, contentLength)));
+        if (body.getSize() > 0 && socket.read(body.getData(), static_cast<int>(body.getSize()), true) != static_cast<int>(body.getSize()))
+            return false;
+        request.body = body.toString();
+        return true;
+    }
+
+    static bool send(juce::StreamingSocket& socket, const juce::String& text)
+    {
+        const auto bytes = static_cast<int>(text.getNumBytesAsUTF8());
+        return socket.write(text.toRawUTF8(), bytes) == bytes;
+    }
+
+    static bool sendHeaders(juce::StreamingSocket& socket, int status, const juce::String& contentType,
+                            int contentLength = -1, const juce::String& extraHeaders = {})
+    {
+        static const std::map<int, const char*> reasons {
+            { 200, "OK" }, { 401, "Unauthorized" }, { 404, "Not Found" }, { 429, "Too Many Requests" }, { 500, "Internal Server Error" }
+        };
+        const auto reason = reasons.count(status) > 0 ? reasons.at(status) : "Error";
+
+        juce::String head;
+        head << "HTTP/1.1 " << status << " " << reason << "\r\n"
+             << "Content-Type: " << contentType << "\r\n"
+             << "Connection: close\r\n";
+        if (contentLength >= 0)
+            head << "Content-Length: " << contentLength << "\r\n";
+        head << extraHeaders << "\r\n";
+        return send(socket, head);
+    }
+
+    static bool sendJson(juce::StreamingSocket& socket, int status, const juce::String& json, const juce::String& extraHeaders = {})
+    {
+        return sendHeaders(socket, status, "application/json", static_cast<int>(json.getNumBytesAsUTF8()), extraHeaders)
+            && send(socket, json);
+    }
+
+    static juce::String makeErrorJson(const juce::String& message)
+    {
+        auto error = juce::DynamicObject::Ptr(new juce::DynamicObject());
+        error->setProperty("message", message);
+        auto root = juce::DynamicObject::Ptr(new juce::DynamicObject());
+        root->setProperty("error", juce::var(error.get()));
+        return juce::JSON::toString(juce::var(root.get()), true);
+    }
+
+    // One streamed event in the provider's format
+    static juce::String makeEvent(Format format, const juce::String& text, bool error)
+    {
+        auto root = juce::DynamicObject::Ptr(new juce::DynamicObject());
+        if (error)
+        {
+            auto errorObj = juce::DynamicObject::Ptr(new juce::DynamicObject());
+            errorObj->setProperty("message", text);
+            root->setProperty("error", juce::var(errorObj.get()));
+            if (format == Format::AnthropicSse)
+                root->setProperty("type", "error");
+        }
+        else if (format == Format::OllamaNdjson)
+        {
+            auto message = juce::DynamicObject::Ptr(new juce::DynamicObject());
+            message->setProperty("role", "assistant");
+            message->setProperty("content", text);
+            root->setProperty("message", juce::var(message.get()));
+            root->setProperty("done", false);
+        }
+        else if (format == Format::OpenAiSse)
+        {
+            auto delta = juce::DynamicObject::Ptr(new juce::DynamicObject());
+            delta->setProperty("content", text);
+            auto choice = juce::DynamicObject::Ptr(new juce::DynamicObject());
+            choice->setProperty("index", 0);
+            choice->setProperty("delta", juce::var(delta.get()));
+            juce::Array<juce::var> choices;
+            choices.add(juce::var(choice.get()));
+            root->setProperty("choices", choices);
+        }
+        else
+        {
+            auto delta = juce::DynamicObject::Ptr(new juce::DynamicObject());
+            delta->setProperty("type", "text_delta");
+            delta->setProperty("text", text);
+            root->setProperty("type", "content_block_delta");
+            root->setProperty("index", 0);
+            root->setProperty("delta", juce::var(delta.get()));
+        }
+
+        const auto json = juce::JSON::toString(juce::var(root.get()), true);
+        if (format == Format::OllamaNdjson)
+            return json + "\n";
+        if (format == Format::AnthropicSse)
+            return "event: " + juce::String(error ? "error" : "content_block_delta") + "\ndata: " + json + "\n\n";
+        return "data: " + json + "\n\n";
+    }
+
+    static juce::String makeEndEvent(Format format)
+    {
+        if (format == Format::OllamaNdjson)
+            return "{\"message\":{\"role\":\"assistant\",\"content\":\"\"},\"done\":true}\n";
+        if (format == Format::AnthropicSse)
+            return "event: message_stop\ndata: {\"type\":\"message_stop\"}\n\n";
+        return "data: [DONE]\n\n";
+    }
+
+    // The JSON suggestion prompts ask for, or a short chat answer
+    static juce::String makeReplyText(const Request& request, uint64_t requestNumber)
+    {
+        if (request.body.contains("gain_db"))
+        {
+            auto reply = juce::DynamicObject::Ptr(new juce::DynamicObject());
+            reply->setProperty("gain_db", -3.5);
+            reply->setProperty("target_db", -18);
+            reply->setProperty("rider_amount", 0.4);
+            reply->setProperty("notes", "Mock suggestion #" + juce::String(static_cast<juce::int64>(requestNumber))
+                                        + ": trim 3.5 dB to sit around -18 dBFS RMS with headroom for peaks.");
+            reply->setProperty("satellite_gains", juce::Array<juce::var>());
+            return juce::JSON::toString(juce::var(reply.get()), true);
+        }
+
+        return "Mock reply #" + juce::String(static_cast<juce::int64>(requestNumber))
+             + ": pull the vocal bus down about 2 dB, then bring the compressor threshold up until it only catches the loudest phrases.";
+    }
+
+    void handleConnection(juce::StreamingSocket& socket)
+    {
+        Request request;
+        if (! readRequest(socket, request))
+            return;
+
+        const auto requestNumber = ++requests;
+        const auto& path = request.path;
+
+        if (! pause(settings.connectDelayMs))
+            return;
+
+        if (path.endsWith("/api/tags"))
+        {
+            sendJson(socket, 200, "{\"models\":[{\"name\":\"llama3\"},{\"name\":\"mistral\"}]}");
+            return;
+        }
+
+        const bool cloud = ! path.startsWith("/api/");
+        if (cloud && ! request.headers.contains("authorization: bearer ") && ! request.headers.contains("x-api-key: "))
+        {
+            ++unauthorised;
+            sendJson(socket, 401, makeErrorJson("Missing API key (mock)"));
+            return;
+        }
+
+        if (path.endsWith("/models"))
+        {
+            sendJson(socket, 200, "{\"data\":[{\"id\":\"gpt-4o\"},{\"id\":\"gpt-4o-mini\"},{\"id\":\"openai/gpt-4o\"},"
+                                  "{\"id\":\"anthropic/claude-3.5-sonnet\"},{\"id\":\"meta-llama/llama-3.1-70b-instruct\"}]}");
+            return;
+        }
+
+        if (path.endsWith("/api/generate"))
+        {
+            sendJson(socket, 200, "{\"response\":\"\",\"done\":true}");
+            return;
+        }
+
+        Format format;
+        if (path.endsWith("/api/chat"))
+            format = Format::OllamaNdjson;
+        else if (path.endsWith("/chat/completions") || path.endsWith("/text/chatcompletion_v2"))
+            format = Format::OpenAiSse;
+        else if (path.endsWith("/v1/messages"))
+            format = Format::AnthropicSse;
+        else
+        {
+            sendJson(socket, 404, makeErrorJson("Unknown endpoint " + path));
+            return;
+        }
+
+        if (isRateLimited())
+        {
+            ++rateLimited;
+            sendJson(socket, 429, makeErrorJson("Rate limit exceeded (mock request " + juce::String(static_cast<juce::int64>(requestNumber)) + ")"),
+                     "Retry-After: 1\r\n");
+            return;
+        }
+
+        if (chance(settings.errorRate))
+        {
+            ++errors;
+            sendJson(socket, 500, makeErrorJson("Mock provider error on request " + juce::String(static_cast<juce::int64>(requestNumber))));
+            return;
+        }
+
+        const auto contentType = format == Format::OllamaNdjson ? "application/x-ndjson" : "text/event-stream";
+        if (! sendHeaders(socket, 200, contentType))
+            return;
+        if (format == Format::AnthropicSse && ! send(socket, "event: message_start\ndata: {\"type\":\"message_start\"}\n\n"))
+            return;
+        if (! pause(settings.firstTokenDelayMs))
+            return;
+
+        const auto text = makeReplyText(request, requestNumber);
+        const bool failMidway = chance(settings.streamErrorRate);
+        constexpr int charsPerToken = 4;
+        for (int offset = 0; offset < text.length(); offset += charsPerToken)
+        {
+            if (offset > 0 && ! pause(settings.tokenDelayMs))
+                return;
+
+            if (failMidway && offset >= text.length() / 2)
+            {
+                ++errors;
+                send(socket, makeEvent(format, "Mock stream interrupted on request " + juce::String(static_cast<juce::int64>(requestNumber)), true));
+                return;
+            }
+
+            // Client gone (request cancelled or superseded)
+            if (! send(socket, makeEvent(format, text.substring(offset, offset + charsPerToken), false)))
+                return;
+        }
+
+        if (send(socket, makeEndEvent(format)))
+            ++streamed;
+    }
+
+    const Settings settings;
+    juce::StreamingSocket listener;
+    std::unique_ptr<AcceptThread> acceptThread;
+    std::atomic<bool> stopping { false };
+    std::atomic<int> activeConnections { 0 };
+
+    juce::CriticalSection randomLock;  // random and recentRequestsMs
+    juce::Random random;
+    std::deque<double> recentRequestsMs;
+
+    std::atomic<uint64_t> requests { 0 };
+    std::atomic<uint64_t> streamed { 0 };
+    std::atomic<uint64_t> errors { 0 };
+    std::atomic<uint64_t> rateLimited { 0 };
+    std::atomic<uint64_t> unauthorised { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(MockProviderServer)
+};
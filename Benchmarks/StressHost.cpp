@@ -0,0 +1,567 @@
+// Headless multi-instance stress host: one master and up to MAX_SATELLITES
+// satellites in one process, driven the way a multi-core DAW drives them.
+//
+// An engine thread runs real-time paced cycles of 512 samples at 48 kHz. Each
+// cycle the worker pool processes every satellite in parallel, then the engine
+// sums their outputs into the master's input and processes the master. The
+// message thread meanwhile:
+//   - adds and removes satellites at random (start/stop churn),
+//   - periodically reloads the whole session: every instance's state is saved,
+//     the satellites are torn down and re-created from it, the master restored,
+//   - automates random parameters of random instances.
+//
+// Reported every interval and at the end: CPU (cores busy, from getrusage),
+// engine cycle cost and overruns, per-instance processBlock cost, slot churn
+// and resident memory from the master's getSessionHealth (growth is reported
+// once the run is past the master's warm-up), so hours-long soak runs show a
+// trend. The run fails on slot claim failures, satellites that never
+// connect, or slots still live after teardown.
+//
+// The shared-memory layout holds MAX_SATELLITES (32) slots, so that is the
+// most satellites this can run.
+//
+//   AR3SStressHost [--satellites=32] [--seconds=60] [--threads=4] [--churn-ms=250]
+//                  [--reload-seconds=30] [--automation-hz=50] [--report-seconds=10] [--seed=1]
+
+#include "../Source/PluginProcessor.h"
+#include "../Source/SatelliteProcessor.h"
+
+#include <sys/resource.h>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    constexpr int BLOCK_SIZE = 512;
+    constexpr double SAMPLE_RATE = 48000.0;
+
+    struct Options
+    {
+        int maxSatellites = MAX_SATELLITES;
+        double seconds = 60.0;
+        int threads = 4;
+        int churnMs = 250;
+        double reloadSeconds = 30.0;
+        double automationHz = 50.0;
+        double reportSeconds = 10.0;
+        int64_t seed = 1;
+    };
+
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg(argv[i]);
+            const auto equals = arg.find('=');
+            const auto name = arg.substr(0, equals);
+            const auto value = equals == std::string::npos ? std::string() : arg.substr(equals + 1);
+
+            if (name == "--satellites")
+                options.maxSatellites = std::atoi(value.c_str());
+            else if (name == "--seconds")
+                options.seconds = std::atof(value.c_str());
+            else if (name == "--threads")
+                options.threads = std::atoi(value.c_str());
+            else if (name == "--churn-ms")
+                options.churnMs = std::atoi(value.c_str());
+            else if (name == "--reload-seconds")
+                options.reloadSeconds = std::atof(value.c_str());
+            else if (name == "--automation-hz")
+                options.automationHz = std::atof(value.c_str());
+            else if (name == "--report-seconds")
+                options.reportSeconds = std::atof(value.c_str());
+            else if (name == "--seed")
+                options.seed = std::atoll(value.c_str());
+            else
+            {
+                std::fprintf(stderr, "Usage: %s [--satellites=32] [--seconds=60] [--threads=4] [--churn-ms=250]\n"
+                                     "       [--reload-seconds=30] [--automation-hz=50] [--report-seconds=10] [--seed=1]\n", argv[0]);
+                return false;
+            }
+        }
+
+        if (options.maxSatellites < 1 || options.maxSatellites > MAX_SATELLITES)
+        {
+            std::fprintf(stderr, "--satellites must be 1-%d (the shared-memory layout has %d slots)\n",
+                         MAX_SATELLITES, MAX_SATELLITES);
+            return false;
+        }
+        return options.seconds > 0.0 && options.threads >= 0 && options.reportSeconds > 0.0;
+    }
+
+    double getCpuSeconds()
+    {
+        rusage usage {};
+        ::getrusage(RUSAGE_SELF, &usage);
+        return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+             + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1.0e-6;
+    }
+
+    // One processor plus the buffers the engine runs it with
+    struct Instance
+    {
+        std::unique_ptr<juce::AudioProcessor> processor;
+        juce::AudioBuffer<float> buffer { 2, BLOCK_SIZE };
+        juce::MidiBuffer midi;
+        float level = 0.1f;
+        float phase = 0.0f;
+        float phaseStep = 0.05f;
+        double totalMicros = 0.0;  // Written by whichever thread processed it this cycle
+        double maxMicros = 0.0;
+        uint64_t blocks = 0;
+        uint64_t lifetimeBlocks = 0;
+
+        void prepare()
+        {
+            processor->setPlayConfigDetails(2, 2, SAMPLE_RATE, BLOCK_SIZE);
+            processor->prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+        }
+
+        void process()
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            processor->processBlock(buffer, midi);
+            const auto micros = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e6;
+            totalMicros += micros;
+            maxMicros = std::max(maxMicros, micros);
+            ++blocks;
+            ++lifetimeBlocks;
+        }
+
+        // A tone plus a little noise, so every analysis path has something to chew on
+        void fillInput(juce::Random& random)
+        {
+            for (int i = 0; i < BLOCK_SIZE; ++i)
+            {
+                const auto sample = level * (std::sin(phase) + 0.05f * (random.nextFloat() - 0.5f));
+                phase += phaseStep;
+                buffer.setSample(0, i, sample);
+                buffer.setSample(1, i, sample * 0.9f);
+            }
+            phase = std::fmod(phase, juce::MathConstants<float>::twoPi);
+        }
+    };
+
+    // Runs a batch of jobs across worker threads and the calling thread, like a
+    // host's audio thread pool processing independent tracks of one graph
+    class WorkerPool
+    {
+    public:
+        explicit WorkerPool(int numThreads)
+        {
+            for (int i = 0; i < numThreads; ++i)
+            {
+                workers.push_back(std::make_unique<Worker>(*this, i));
+                workers.back()->startThread(juce::Thread::Priority::highest);
+            }
+        }
+
+        ~WorkerPool()
+        {
+            for (auto& worker : workers)
+            {
+                worker->signalThreadShouldExit();
+                worker->notify();
+                worker->stopThread(2000);
+            }
+        }
+
+        void run(int numJobs, std::function<void(int)> job)
+        {
+            currentJob = std::move(job);
+            jobCount.store(numJobs);
+            nextJob.store(0);
+            pendingWorkers.store(static_cast<int>(workers.size()));
+            for (auto& worker : workers)
+                worker->notify();
+
+            drainJobs();
+            while (pendingWorkers.load() > 0)
+                jobsDone.wait(1);
+        }
+
+    private:
+        class Worker : public juce::Thread
+        {
+        public:
+            Worker(WorkerPool& ownerPool, int index)
+                : juce::Thread("Stress worker " + juce::String(index)), pool(ownerPool) {}
+
+            void run() override
+            {
+                while (! threadShouldExit())
+                {
+                    wait(-1);
+                    if (threadShouldExit())
+                        break;
+                    pool.drainJobs();
+                    if (pool.pendingWorkers.fetch_sub(1) == 1)
+                        pool.jobsDone.signal();
+                }
+            }
+
+        private:
+            WorkerPool& pool;
+        };
+
+        void drainJobs()
+        {
+            for (int job = nextJob.fetch_add(1); job < jobCount.load(); job = nextJob.fetch_add(1))
+                currentJob(job);
+        }
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::function<void(int)> currentJob;
+        std::atomic<int> jobCount { 0 };
+        std::atomic<int> nextJob { 0 };
+        std::atomic<int> pendingWorkers { 0 };
+        juce::WaitableEvent jobsDone;
+    };
+
+    class StressHost : private juce::Thread
+    {
+    public:
+        explicit StressHost(const Options& hostOptions)
+            : juce::Thread("Stress engine"), options(hostOptions), random(hostOptions.seed), pool(hostOptions.threads)
+        {
+            auto master = std::make_unique<SimpleGainAudioProcessor>();
+            master->setSpeculativeSuggestionsPerHour(0);  // No background AI traffic from a headless run
+            masterProcessor = master.get();
+            masterInstance.processor = std::move(master);
+            masterInstance.prepare();
+
+            for (int i = 0; i < options.maxSatellites; ++i)
+                addSatellite({});
+        }
+
+        ~StressHost() override
+        {
+            stopThread(5000);
+        }
+
+        void start() { startThread(juce::Thread::Priority::highest); }
+        void stop() { stopThread(5000); }
+
+        // Message thread: one round of churn, reloads and automation
+        void tick(int64_t nowMs)
+        {
+            if (options.churnMs > 0 && nowMs >= nextChurnMs)
+            {
+                nextChurnMs = nowMs + options.churnMs;
+                const auto count = getNumSatellites();
+                const bool add = count == 0 || (count < options.maxSatellites && random.nextBool());
+                if (add)
+                    addSatellite({});
+                else
+                    removeSatellite(random.nextInt(count));
+            }
+
+            if (options.reloadSeconds > 0.0 && nowMs >= nextReloadMs)
+            {
+                nextReloadMs = nowMs + static_cast<int64_t>(options.reloadSeconds * 1000.0);
+                if (reloadsDone++ > 0)  // Not at start-up
+                    reloadSession();
+            }
+
+            if (options.automationHz > 0.0)
+            {
+                const auto periodMs = 1000.0 / options.automationHz;
+                while (static_cast<double>(nowMs) >= nextAutomationMs)
+                {
+                    nextAutomationMs += periodMs;
+                    automateRandomParameter();
+                }
+            }
+        }
+
+        void report(double elapsedSeconds, bool final)
+        {
+            const auto cpuSeconds = getCpuSeconds();
+            const auto cores = (cpuSeconds - lastCpuSeconds) / std::max(1.0e-3, elapsedSeconds - lastReportSeconds);
+            lastCpuSeconds = cpuSeconds;
+            lastReportSeconds = elapsedSeconds;
+
+            double satelliteMicros = 0.0, satelliteMax = 0.0, masterMicros = 0.0, masterMax = 0.0;
+            uint64_t satelliteBlocks = 0, masterBlocks = 0;
+            int numSatellites = 0, unconnected = 0;
+            {
+                const juce::ScopedLock lock(instancesLock);
+                numSatellites = static_cast<int>(satellites.size());
+                for (auto& instance : satellites)
+                {
+                    satelliteMicros += instance->totalMicros;
+                    satelliteMax = std::max(satelliteMax, instance->maxMicros);
+                    satelliteBlocks += instance->blocks;
+                    instance->totalMicros = instance->maxMicros = 0.0;
+                    instance->blocks = 0;
+                    // Satellites claim their slot once they process; give new ones a few blocks
+                    if (instance->lifetimeBlocks >= 10
+                        && ! static_cast<SatelliteProcessor*>(instance->processor.get())->isConnected())
+                        ++unconnected;
+                }
+                satelliteMicros += retiredSatelliteMicros;
+                satelliteBlocks += retiredSatelliteBlocks;
+                retiredSatelliteMicros = 0.0;
+                retiredSatelliteBlocks = 0;
+                masterMicros = masterInstance.totalMicros;
+                masterMax = masterInstance.maxMicros;
+                masterBlocks = masterInstance.blocks;
+                masterInstance.totalMicros = masterInstance.maxMicros = 0.0;
+                masterInstance.blocks = 0;
+            }
+            lastUnconnected = unconnected;
+
+            const auto cycles = cyclesRun.exchange(0);
+            const auto cycleMicros = cycleMicrosTotal.exchange(0.0);
+            const auto cycleMax = cycleMicrosMax.exchange(0.0);
+            const auto health = masterProcessor->getSessionHealth();
+
+            char growth[32];
+            if (health.growthMbPerHour != 0.0f)
+                std::snprintf(growth, sizeof(growth), "%+.1f MB/h", health.growthMbPerHour);
+            else
+                std::snprintf(growth, sizeof(growth), "n/a");
+
+            std::printf("%s[%7.0f s] sats %2d (%d without a slot)  cpu %.2f cores  cycle avg %.0f max %.0f us (deadline %.0f)  "
+                        "overruns %llu  sat %.1f/%.0f us  master %.1f/%.0f us  "
+                        "claims %llu releases %llu takeovers %llu reaped %llu failures %llu  "
+                        "rss %.0f MB (start %.0f, peak %.0f, growth %s)  reloads %d\n",
+                        final ? "end " : "",
+                        elapsedSeconds, numSatellites, unconnected, cores,
+                        cycles > 0 ? cycleMicros / static_cast<double>(cycles) : 0.0, cycleMax,
+                        BLOCK_SIZE / SAMPLE_RATE * 1.0e6,
+                        static_cast<unsigned long long>(overruns.load()),
+                        satelliteBlocks > 0 ? satelliteMicros / static_cast<double>(satelliteBlocks) : 0.0, satelliteMax,
+                        masterBlocks > 0 ? masterMicros / static_cast<double>(masterBlocks) : 0.0, masterMax,
+                        static_cast<unsigned long long>(health.slotClaims),
+                        static_cast<unsigned long long>(health.slotReleases),
+                        static_cast<unsigned long long>(health.slotTakeovers),
+                        static_cast<unsigned long long>(health.slotsReaped),
+                        static_cast<unsigned long long>(health.slotClaimFailures),
+                        health.residentMb, health.residentStartMb, health.residentPeakMb, growth,
+                        std::max(0, reloadsDone - 1));
+            std::fflush(stdout);
+            lastClaimFailures = health.slotClaimFailures;
+        }
+
+        // Message thread, after stop(): tear every satellite down and check the
+        // master sees no slot left behind
+        bool finish()
+        {
+            bool ok = true;
+            if (lastClaimFailures > 0)
+            {
+                std::fprintf(stderr, "%llu slot claims failed\n", static_cast<unsigned long long>(lastClaimFailures));
+                ok = false;
+            }
+            if (lastUnconnected > 0)
+            {
+                std::fprintf(stderr, "%d satellites were processing without a slot\n", lastUnconnected);
+                ok = false;
+            }
+
+            while (getNumSatellites() > 0)
+                removeSatellite(0);
+
+            int liveSlots = 0;
+            for (int i = 0; i < MAX_SATELLITES; ++i)
+                if (masterProcessor->getSatelliteInfo(i).active)
+                    ++liveSlots;
+            if (liveSlots > 0)
+            {
+                std::fprintf(stderr, "%d slots still live after every satellite was removed\n", liveSlots);
+                ok = false;
+            }
+            return ok;
+        }
+
+    private:
+        void run() override
+        {
+            const auto periodMs = BLOCK_SIZE / SAMPLE_RATE * 1000.0;
+            auto nextCycleMs = juce::Time::getMillisecondCounterHiRes();
+            juce::Random signalRandom(options.seed + 1);
+
+            while (! threadShouldExit())
+            {
+                nextCycleMs += periodMs;
+                const auto start = juce::Time::getHighResolutionTicks();
+                {
+                    const juce::ScopedLock lock(instancesLock);
+                    for (auto& instance : satellites)
+                        instance->fillInput(signalRandom);
+
+                    pool.run(static_cast<int>(satellites.size()), [this] (int index) { satellites[(size_t) index]->process(); });
+
+                    // Master input: the satellites summed, as on a mix bus
+                    masterInstance.buffer.clear();
+                    for (auto& instance : satellites)
+                        for (int channel = 0; channel < 2; ++channel)
+                            masterInstance.buffer.addFrom(channel, 0, instance->buffer, channel, 0, BLOCK_SIZE, 0.25f);
+                    masterInstance.process();
+                }
+                const auto micros = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e6;
+
+                cyclesRun.fetch_add(1);
+                cycleMicrosTotal.store(cycleMicrosTotal.load() + micros);
+                cycleMicrosMax.store(std::max(cycleMicrosMax.load(), micros));
+                if (micros > periodMs * 1000.0)
+                    overruns.fetch_add(1);
+
+                const auto waitMs = nextCycleMs - juce::Time::getMillisecondCounterHiRes();
+                if (waitMs > 0.0)
+                    wait(static_cast<int>(waitMs));
+                else if (waitMs < -periodMs * 4.0)
+                    nextCycleMs = juce::Time::getMillisecondCounterHiRes();  // Fell far behind: don't try to catch up
+            }
+        }
+
+        int getNumSatellites() const
+        {
+            const juce::ScopedLock lock(instancesLock);
+            return static_cast<int>(satellites.size());
+        }
+
+        // Built and prepared off the engine's lock, as a host would
+        void addSatellite(const juce::MemoryBlock& state)
+        {
+            auto instance = std::make_unique<Instance>();
+            instance->processor = std::make_unique<SatelliteProcessor>();
+            if (state.getSize() > 0)
+                instance->processor->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+            instance->prepare();
+            instance->level = juce::Decibels::decibelsToGain(-30.0f + 24.0f * random.nextFloat());
+            instance->phaseStep = 0.01f + 0.2f * random.nextFloat();
+
+            const juce::ScopedLock lock(instancesLock);
+            satellites.push_back(std::move(instance));
+        }
+
+        // Destroyed off the engine's lock too, so teardown cost doesn't land in a cycle
+        void removeSatellite(int index)
+        {
+            std::unique_ptr<Instance> removed;
+            {
+                const juce::ScopedLock lock(instancesLock);
+                if (index < 0 || index >= static_cast<int>(satellites.size()))
+                    return;
+                removed = std::move(satellites[(size_t) index]);
+                satellites.erase(satellites.begin() + index);
+                retiredSatelliteMicros += removed->totalMicros;
+                retiredSatelliteBlocks += removed->blocks;
+            }
+            removed->processor->releaseResources();
+        }
+
+        // Save everything, close the satellites, re-open them from the saved
+        // states and restore the master, like re-opening a project
+        void reloadSession()
+        {
+            std::vector<juce::MemoryBlock> states;
+            {
+                const juce::ScopedLock lock(instancesLock);
+                for (auto& instance : satellites)
+                {
+                    states.emplace_back();
+                    instance->processor->getStateInformation(states.back());
+                }
+            }
+
+            juce::MemoryBlock masterState;
+            masterProcessor->getStateInformation(masterState);
+
+            while (getNumSatellites() > 0)
+                removeSatellite(getNumSatellites() - 1);
+            masterProcessor->setStateInformation(masterState.getData(), static_cast<int>(masterState.getSize()));
+            for (const auto& state : states)
+                addSatellite(state);
+        }
+
+        // Only this thread adds or removes instances, so the pointer stays valid
+        // after the lock; listeners then run without stalling the engine
+        void automateRandomParameter()
+        {
+            juce::AudioProcessor* processor = nullptr;
+            {
+                const juce::ScopedLock lock(instancesLock);
+                const auto count = static_cast<int>(satellites.size());
+                const int pick = random.nextInt(count + 1);
+                processor = pick == count ? masterInstance.processor.get() : satellites[(size_t) pick]->processor.get();
+            }
+
+            const auto& parameters = processor->getParameters();
+            if (parameters.isEmpty())
+                return;
+            parameters[random.nextInt(parameters.size())]->setValueNotifyingHost(random.nextFloat());
+        }
+
+        const Options options;
+        juce::Random random;
+        WorkerPool pool;
+
+        juce::CriticalSection instancesLock;  // The engine holds it for a whole cycle
+        Instance masterInstance;
+        SimpleGainAudioProcessor* masterProcessor = nullptr;
+        std::vector<std::unique_ptr<Instance>> satellites;
+        double retiredSatelliteMicros = 0.0;
+        uint64_t retiredSatelliteBlocks = 0;
+
+        std::atomic<uint64_t> cyclesRun { 0 };
+        std::atomic<double> cycleMicrosTotal { 0.0 };
+        std::atomic<double> cycleMicrosMax { 0.0 };
+        std::atomic<uint64_t> overruns { 0 };
+
+        int64_t nextChurnMs = 0;
+        int64_t nextReloadMs = 0;
+        double nextAutomationMs = 0.0;
+        int reloadsDone = 0;
+        double lastCpuSeconds = getCpuSeconds();
+        double lastReportSeconds = 0.0;
+        uint64_t lastClaimFailures = 0;
+        int lastUnconnected = 0;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (! parseOptions(argc, argv, options))
+        return 1;
+
+    // Scratch shared memory and data folder, so a running session and the
+    // user's settings, caches and logs are never touched
+    const auto scratch = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                             .getChildFile("ar3s_stress_" + juce::String(static_cast<int>(::getpid())));
+    scratch.createDirectory();
+    ::setenv("AR3S_DATA_DIR", scratch.getFullPathName().toRawUTF8(), 1);
+    ::setenv("AR3S_SHARED_MEMORY_FILE", scratch.getChildFile("shared_memory.bin").getFullPathName().toRawUTF8(), 1);
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    bool ok = true;
+    {
+        StressHost host(options);
+        std::printf("Stress host: up to %d satellites, %d worker threads, block %d @ %.0f Hz, %.0f s\n",
+                    options.maxSatellites, options.threads, BLOCK_SIZE, SAMPLE_RATE, options.seconds);
+        host.start();
+
+        const auto startMs = getMonotonicMillis();
+        auto nextReportMs = startMs + static_cast<int64_t>(options.reportSeconds * 1000.0);
+        for (auto nowMs = startMs; nowMs - startMs < static_cast<int64_t>(options.seconds * 1000.0); nowMs = getMonotonicMillis())
+        {
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(5);
+            host.tick(nowMs - startMs);
+            if (nowMs >= nextReportMs)
+            {
+                nextReportMs += static_cast<int64_t>(options.reportSeconds * 1000.0);
+                host.report(static_cast<double>(nowMs - startMs) / 1000.0, false);
+            }
+        }
+
+        host.stop();
+        host.report(static_cast<double>(getMonotonicMillis() - startMs) / 1000.0, true);
+        ok = host.finish();
+    }
+
+    scratch.deleteRecursively();
+    return ok ? 0 : 1;
+}
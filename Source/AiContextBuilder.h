@@ -0,0 +1,306 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+#include "SharedMemory.h"
+
+// Compact session context for AI prompts.
+//
+// The prose satellite summary plus the JSON dump cost thousands of tokens with a
+// full session, on every request. This builds one key=value line per record, with
+// the same keys in the same order every time, and keeps the whole context under a
+// token budget (estimated as ~4 UTF-8 bytes per token). Tracks with issues are
+// described first, then tracks that changed since the previous build; everything
+// else is folded into one statistical "rest" line.
+struct AiContextTrack
+{
+    int index = -1;
+    juce::String name;
+    juce::String source;
+    juce::String group;           // Empty = not in a group
+    float rmsDb = -120.0f;
+    float peakDb = -120.0f;
+    float crestDb = 0.0f;
+    float shortTermLufs = -120.0f;  // -120 when the satellite doesn't measure loudness
+    float truePeakDb = -120.0f;
+    float gainDb = 0.0f;
+    float phaseCorrelation = 1.0f;
+    bool trendValid = false;        // 30 s history
+    float trendAvgDb = -120.0f;
+    float trendMinDb = -120.0f;
+    float trendMaxDb = -120.0f;
+    float cpuPeakLoad = 0.0f;
+    uint32_t overruns = 0;
+    bool controlledByMaster = false;
+};
+
+struct AiContextMaster
+{
+    float rmsDb = -120.0f;
+    float peakDb = -120.0f;
+    float crestDb = 0.0f;
+    float phaseCorrelation = 1.0f;
+    float shortTermLufs = -120.0f;
+    float integratedLufs = -120.0f;
+    float gainDb = 0.0f;
+    float targetDb = -18.0f;
+    float ceilingDb = 0.0f;
+};
+
+struct AiContextMasking
+{
+    int trackA = -1;
+    int trackB = -1;
+    float severity = 0.0f;   // 0..1
+    float bandHz = 0.0f;     // 0 = no dominant band
+};
+
+struct AiContextAlignment
+{
+    int trackA = -1;
+    int trackB = -1;
+    int offsetSamples = 0;
+    float offsetMs = 0.0f;
+    bool polarityInverted = false;
+    float confidence = 0.0f;
+};
+
+class AiContextBuilder
+{
+public:
+    static constexpr int defaultTokenBudget = 600;
+    static constexpr int minTokenBudget = 150;   // Master, pairs and the rest line always fit
+    static constexpr int maxTokenBudget = 4000;
+
+    static int estimateTokens(const juce::String& text)
+    {
+        return static_cast<int>((text.getNumBytesAsUTF8() + 3) / 4);
+    }
+
+    void setTokenBudget(int tokens) { tokenBudget = juce::jlimit(minTokenBudget, maxTokenBudget, tokens); }
+    int getTokenBudget() const { return tokenBudget; }
+
+    // Forget the previous build, so the next one treats every track as changed
+    void reset() { previousSignatures.fill(0); }
+
+    juce::String build(const AiContextMaster& master, const std::vector<AiContextTrack>& tracks,
+                       const std::vector<AiContextMasking>& masking,
+                       const std::vector<AiContextAlignment>& alignments)
+    {
+        std::array<int, MAX_SATELLITES> issueScores {};
+        for (const auto& pair : masking)
+            if (pair.severity >= 0.5f)
+                for (int index : { pair.trackA, pair.trackB })
+                    if (isValidIndex(index))
+                        issueScores[(size_t) index] += 1;
+        for (const auto& alignment : alignments)
+            if (alignment.polarityInverted && alignment.confidence >= 0.5f)
+                for (int index : { alignment.trackA, alignment.trackB })
+                    if (isValidIndex(index))
+                        issueScores[(size_t) index] += 2;
+
+        struct Candidate
+        {
+            const AiContextTrack* track;
+            int score;
+            bool changed;
+        };
+        std::vector<Candidate> candidates;
+        candidates.reserve(tracks.size());
+
+        std::array<int64_t, MAX_SATELLITES> signatures {};
+        int numChanged = 0;
+        for (const auto& track : tracks)
+        {
+            if (! isValidIndex(track.index))
+                continue;
+            const auto slot = (size_t) track.index;
+            signatures[slot] = getSignature(track);
+            const bool changed = signatures[slot] != previousSignatures[slot];
+            numChanged += changed ? 1 : 0;
+            candidates.push_back({ &track, issueScores[slot] + getIssueScore(track), changed });
+        }
+        previousSignatures = signatures;
+
+        // Worst issues first, then changed tracks, loudest first within each
+        std::stable_sort(candidates.begin(), candidates.end(), [] (const Candidate& a, const Candidate& b)
+        {
+            if (a.score != b.score)
+                return a.score > b.score;
+            if (a.changed != b.changed)
+                return a.changed;
+            return a.track->rmsDb > b.track->rmsDb;
+        });
+
+        juce::String pairLines;
+        for (const auto& pair : masking)
+            pairLines << "mask a=" << (pair.trackA + 1) << " b=" << (pair.trackB + 1)
+                      << " sev=" << juce::roundToInt(pair.severity * 100.0f)
+                      << " hz=" << juce::roundToInt(pair.bandHz) << "\n";
+        for (const auto& alignment : alignments)
+            if (alignment.confidence >= 0.5f)
+                pairLines << "align a=" << (alignment.trackA + 1) << " b=" << (alignment.trackB + 1)
+                          << " samples=" << signedValue(static_cast<float>(alignment.offsetSamples), 0)
+                          << " ms=" << juce::String(alignment.offsetMs, 2)
+                          << " pol=" << (alignment.polarityInverted ? "inv" : "ok")
+                          << " conf=" << juce::roundToInt(alignment.confidence * 100.0f) << "\n";
+
+        juce::String masterLine;
+        masterLine << "master rms=" << level(master.rmsDb) << " pk=" << level(master.peakDb)
+                   << " cr=" << juce::String(master.crestDb, 1) << " ph=" << juce::String(master.phaseCorrelation, 2)
+                   << " lufs_s=" << level(master.shortTermLufs) << " lufs_i=" << level(master.integratedLufs)
+                   << " gain=" << signedValue(master.gainDb, 1) << " target=" << juce::String(master.targetDb, 1)
+                   << " ceiling=" << juce::String(master.ceilingDb, 1) << "\n";
+
+        // The header and rest line have a fixed shape; reserve a generous estimate for them
+        const int reservedTokens = 60 + estimateTokens(masterLine) + estimateTokens(pairLines);
+        int usedTokens = reservedTokens;
+
+        juce::String trackLines;
+        int numDetailed = 0;
+        RestStats rest;
+        for (const auto& candidate : candidates)
+        {
+            if (candidate.score > 0 || candidate.changed)
+            {
+                const auto line = formatTrack(*candidate.track, candidate.score, candidate.changed);
+                const int lineTokens = estimateTokens(line);
+                if (usedTokens + lineTokens <= tokenBudget)
+                {
+                    trackLines << line;
+                    usedTokens += lineTokens;
+                    ++numDetailed;
+                    continue;
+                }
+            }
+            rest.add(*candidate.track, candidate.score > 0, candidate.changed);
+        }
+
+        juce::String context;
+        context << "ctx v=1 tracks=" << static_cast<int>(candidates.size()) << " detailed=" << numDetailed
+                << " changed=" << numChanged << "\n";
+        context << masterLine << trackLines;
+        if (rest.count > 0)
+            context << rest.format();
+        context << pairLines;
+        return context;
+    }
+
+    // Flag names, in the order they appear on a track line
+    static juce::String getIssueFlags(const AiContextTrack& track)
+    {
+        juce::StringArray flags;
+        if (track.peakDb > -1.0f || track.truePeakDb > -1.0f)
+            flags.add("clip");
+        if (track.phaseCorrelation < 0.3f)
+            flags.add("phase");
+        if (track.overruns > 0)
+            flags.add("overrun");
+        if (track.cpuPeakLoad >= 0.5f)
+            flags.add("cpu");
+        return flags.joinIntoString(",");
+    }
+
+private:
+    struct RestStats
+    {
+        int count = 0;
+        int issues = 0;
+        int unchanged = 0;
+        double powerSum = 0.0;
+        float minRmsDb = 0.0f;
+        float maxRmsDb = -120.0f;
+        float maxPeakDb = -120.0f;
+
+        void add(const AiContextTrack& track, bool hasIssue, bool changed)
+        {
+            minRmsDb = count == 0 ? track.rmsDb : std::min(minRmsDb, track.rmsDb);
+            maxRmsDb = std::max(maxRmsDb, track.rmsDb);
+            maxPeakDb = std::max(maxPeakDb, track.peakDb);
+            powerSum += std::pow(10.0, track.rmsDb / 10.0);
+            issues += hasIssue ? 1 : 0;
+            unchanged += changed ? 0 : 1;
+            ++count;
+        }
+
+        juce::String format() const
+        {
+            const float avgDb = static_cast<float>(10.0 * std::log10(std::max(powerSum / count, 1.0e-12)));
+            juce::String line;
+            line << "rest n=" << count << " unchanged=" << unchanged << " issues=" << issues
+                 << " rms_avg=" << level(avgDb) << " rms_min=" << level(minRmsDb)
+                 << " rms_max=" << level(maxRmsDb) << " pk_max=" << level(maxPeakDb) << "\n";
+            return line;
+        }
+    };
+
+    static bool isValidIndex(int index) { return index >= 0 && index < MAX_SATELLITES; }
+
+    static int getIssueScore(const AiContextTrack& track)
+    {
+        int score = 0;
+        if (track.peakDb > -1.0f || track.truePeakDb > -1.0f)
+            score += 3;
+        if (track.phaseCorrelation < 0.3f)
+            score += 3;
+        if (track.overruns > 0)
+            score += 2;
+        if (track.cpuPeakLoad >= 0.5f)
+            score += 2;
+        return score;
+    }
+
+    // What a reader of the previous context would notice: levels to 1 dB, gain to 0.5 dB
+    static int64_t getSignature(const AiContextTrack& track)
+    {
+        juce::String key;
+        key << track.name << "|" << track.source << "|" << track.group << "|"
+            << juce::roundToInt(track.rmsDb) << "|" << juce::roundToInt(track.peakDb) << "|"
+            << juce::roundToInt(track.gainDb * 2.0f) << "|" << getIssueFlags(track)
+            << (track.controlledByMaster ? "|m" : "");
+        const auto hash = key.hashCode64();
+        return hash != 0 ? hash : 1;  // 0 = not sent last time
+    }
+
+    // Level in dB, or "-" when nothing was measured
+    static juce::String level(float db)
+    {
+        return db > -100.0f ? juce::String(db, 1) : juce::String("-");
+    }
+
+    static juce::String signedValue(float value, int decimals)
+    {
+        return (value >= 0.0f ? "+" : "") + juce::String(value, decimals);
+    }
+
+    static juce::String formatTrack(const AiContextTrack& track, int score, bool changed)
+    {
+        juce::String line;
+        line << "trk id=" << (track.index + 1)
+             << " name=\"" << track.name.replaceCharacter('"', '\'') << "\""
+             << " src=" << (track.source.isNotEmpty() ? track.source.replaceCharacter(' ', '_') : juce::String("-"))
+             << " grp=" << (track.group.isNotEmpty() ? track.group.replaceCharacter(' ', '_') : juce::String("-"))
+             << " rms=" << level(track.rmsDb) << " pk=" << level(track.peakDb)
+             << " cr=" << juce::String(track.crestDb, 1)
+             << " lufs=" << level(track.shortTermLufs) << " tp=" << level(track.truePeakDb)
+             << " gain=" << signedValue(track.gainDb, 1)
+             << " ph=" << juce::String(track.phaseCorrelation, 2);
+        if (track.trendValid)
+            line << " avg30=" << level(track.trendAvgDb) << " rng30=" << level(track.trendMinDb)
+                 << ".." << level(track.trendMaxDb);
+        else
+            line << " avg30=- rng30=-";
+
+        const auto flags = getIssueFlags(track);
+        line << " flags=" << (flags.isNotEmpty() ? flags : (score > 0 ? juce::String("pair") : juce::String("-")))
+             << " master=" << (track.controlledByMaster ? 1 : 0)
+             << " chg=" << (changed ? 1 : 0) << "\n";
+        return line;
+    }
+
+    int tokenBudget = defaultTokenBudget;
+    std::array<int64_t, MAX_SATELLITES> previousSignatures {};
+};
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <vector>
+
+struct AiChatMessage
+{
+    enum class Role { User, Assistant };
+
+    Role role = Role::User;
+    juce::String text;
+};
+
+// Chat history, so each turn is sent as a continuation of the conversation
+// rather than as one self-contained prompt.
+//
+// The system prompt is fixed and earlier turns are resent byte for byte, so a
+// provider that caches prompt prefixes (Ollama's KV cache while the model stays
+// loaded, OpenAI's automatic prefix cache, Anthropic's cache_control blocks) only
+// has to process the newest turn. Answered turns are kept in a sliding window of
+// about maxHistoryTokens; the oldest turns are dropped first.
+//
+// Turns are begun on the message thread and answered or abandoned by the AI
+// workers, in any order.
+class AiConversation
+{
+public:
+    static constexpr int defaultHistoryTokens = 4000;
+
+    void setSystemPrompt(const juce::String& prompt)
+    {
+        const juce::ScopedLock lock(turnLock);
+        systemPrompt = prompt;
+    }
+
+    juce::String getSystemPrompt() const
+    {
+        const juce::ScopedLock lock(turnLock);
+        return systemPrompt;
+    }
+
+    void setMaxHistoryTokens(int tokens)
+    {
+        const juce::ScopedLock lock(turnLock);
+        maxHistoryTokens = juce::jmax(500, tokens);
+        trimHistory(0);
+    }
+
+    // Drops the oldest answered turns until roughly incomingTokens more fit, and
+    // returns an id for the new turn
+    uint64_t beginTurn(const juce::String& userText)
+    {
+        const juce::ScopedLock lock(turnLock);
+        trimHistory(estimateTokens(userText));
+        turns.push_back({ ++nextTurnId, userText, {}, false });
+        return nextTurnId;
+    }
+
+    // Drops turns so that a turn of incomingTokens fits, before its text is known
+    void makeRoom(int incomingTokens)
+    {
+        const juce::ScopedLock lock(turnLock);
+        trimHistory(incomingTokens);
+    }
+
+    void completeTurn(uint64_t turnId, const juce::String& assistantText)
+    {
+        const juce::ScopedLock lock(turnLock);
+        for (auto& turn : turns)
+        {
+            if (turn.id == turnId)
+            {
+                turn.assistant = assistantText;
+                turn.answered = true;
+                break;
+            }
+        }
+        trimHistory(0);
+    }
+
+    // Forgets a turn that got no answer (failed, cancelled, timed out). A no-op
+    // for a turn that was answered.
+    void abandonTurn(uint64_t turnId)
+    {
+        const juce::ScopedLock lock(turnLock);
+        const auto it = std::find_if(turns.begin(), turns.end(),
+                                     [turnId](const Turn& turn) { return turn.id == turnId; });
+        if (it != turns.end() && ! it->answered)
+        {
+            turns.erase(it);
+            historyLost = true;
+        }
+    }
+
+    // The answered turns before this one, then this turn's user text. Turns
+    // begun after it (or still unanswered) are left out.
+    std::vector<AiChatMessage> getMessagesForTurn(uint64_t turnId) const
+    {
+        const juce::ScopedLock lock(turnLock);
+        std::vector<AiChatMessage> messages;
+        for (const auto& turn : turns)
+        {
+            if (turn.id == turnId)
+            {
+                messages.push_back({ AiChatMessage::Role::User, turn.user });
+                break;
+            }
+            if (turn.answered)
+            {
+                messages.push_back({ AiChatMessage::Role::User, turn.user });
+                messages.push_back({ AiChatMessage::Role::Assistant, turn.assistant });
+            }
+        }
+        return messages;
+    }
+
+    void clear()
+    {
+        const juce::ScopedLock lock(turnLock);
+        turns.clear();
+        historyLost = true;
+    }
+
+    // True (once) after turns were dropped or abandoned: context that was only
+    // sent with them needs sending again
+    bool takeHistoryLost()
+    {
+        const juce::ScopedLock lock(turnLock);
+        const bool lost = historyLost;
+        historyLost = false;
+        return lost;
+    }
+
+    static int estimateTokens(const juce::String& text)
+    {
+        return static_cast<int>((text.getNumBytesAsUTF8() + 3) / 4);
+    }
+
+private:
+    struct Turn
+    {
+        uint64_t id = 0;
+        juce::String user;
+        juce::String assistant;
+        bool answered = false;
+    };
+
+    void trimHistory(int incomingTokens)
+    {
+        int total = incomingTokens;
+        for (const auto& turn : turns)
+            total += estimateTokens(turn.user) + estimateTokens(turn.assistant);
+
+        // Pending turns are in flight and stay; the oldest answered ones go first
+        for (auto it = turns.begin(); it != turns.end() && total > maxHistoryTokens;)
+        {
+            if (! it->answered)
+            {
+                ++it;
+                continue;
+            }
+            total -= estimateTokens(it->user) + estimateTokens(it->assistant);
+            it = turns.erase(it);
+            historyLost = true;
+        }
+    }
+
+    juce::CriticalSection turnLock;
+    juce::String systemPrompt;
+    std::vector<Turn> turns;       // Oldest first
+    uint64_t nextTurnId = 0;
+    int maxHistoryTokens = defaultHistoryTokens;
+    bool historyLost = false;
+};
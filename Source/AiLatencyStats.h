@@ -0,0 +1,92 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <array>
+
+// Where the time goes in AI requests, per stage, over the last few dozen
+// requests, so work on the AI path can be measured on a real session:
+//   Connect     request sent -> response headers (includes the model load for Ollama)
+//   FirstToken  request sent -> first text of the reply
+//   Total       request sent -> whole reply read
+//   Parse       reading the structured suggestion out of the reply and applying it
+//   Apply       suggestion or first chat text ready -> editor showing it
+//
+// Written by the AI workers and the editor's timer, read by the editor.
+class AiLatencyStats
+{
+public:
+    enum Stage { Connect = 0, FirstToken, Total, Parse, Apply, NUM_STAGES };
+
+    static constexpr int HISTORY = 64;
+
+    struct Summary
+    {
+        int samples = 0;
+        float p50Ms = 0.0f;
+        float p90Ms = 0.0f;
+        float maxMs = 0.0f;
+    };
+
+    static const char* getStageName(Stage stage)
+    {
+        static const char* const names[] = { "connect", "first token", "total", "parse", "apply" };
+        return names[stage];
+    }
+
+    void add(Stage stage, double ms)
+    {
+        const juce::ScopedLock lock(statsLock);
+        auto& history = stages[(size_t) stage];
+        history.ms[(size_t) (history.count % HISTORY)] = static_cast<float>(std::max(0.0, ms));
+        ++history.count;
+    }
+
+    Summary get(Stage stage) const
+    {
+        std::array<float, HISTORY> sorted;
+        int samples = 0;
+        {
+            const juce::ScopedLock lock(statsLock);
+            const auto& history = stages[(size_t) stage];
+            samples = static_cast<int>(std::min<uint64_t>(history.count, HISTORY));
+            std::copy(history.ms.begin(), history.ms.begin() + samples, sorted.begin());
+        }
+
+        Summary summary;
+        summary.samples = samples;
+        if (samples == 0)
+            return summary;
+
+        std::sort(sorted.begin(), sorted.begin() + samples);
+        summary.p50Ms = sorted[(size_t) ((samples - 1) / 2)];
+        summary.p90Ms = sorted[(size_t) ((samples - 1) * 9 / 10)];
+        summary.maxMs = sorted[(size_t) (samples - 1)];
+        return summary;
+    }
+
+    // One line for menus and logs: "first token 420/900 ms, total 1800/3100 ms, ..." (p50/p90)
+    juce::String describe() const
+    {
+        juce::StringArray parts;
+        for (int stage = 0; stage < NUM_STAGES; ++stage)
+        {
+            const auto summary = get(static_cast<Stage>(stage));
+            if (summary.samples > 0)
+                parts.add(juce::String(getStageName(static_cast<Stage>(stage))) + " "
+                          + juce::String(juce::roundToInt(summary.p50Ms)) + "/"
+                          + juce::String(juce::roundToInt(summary.p90Ms)) + " ms");
+        }
+        return parts.joinIntoString(", ");
+    }
+
+private:
+    struct History
+    {
+        std::array<float, HISTORY> ms {};
+        uint64_t count = 0;
+    };
+
+    juce::CriticalSection statsLock;
+    std::array<History, NUM_STAGES> stages;
+};
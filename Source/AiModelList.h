@@ -0,0 +1,192 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <string>
+#include "DataDirectory.h"
+#include "Logger.h"
+
+// Pulls one string field out of each entry of a provider's model catalogue
+// ({"data":[{"id":"...",...},...]} or {"models":[{"name":"...",...}]}) as the
+// bytes arrive, without building a juce::var tree of the whole document. The
+// OpenRouter catalogue is several hundred KB of descriptions and pricing; only
+// the ids are kept, and only while they are being read.
+//
+// Entries are the objects two levels below the root (root object, array,
+// entry), so same-named fields of nested objects are ignored.
+class ModelIdScanner
+{
+public:
+    explicit ModelIdScanner(const char* fieldToExtract) : field(fieldToExtract) {}
+
+    // Any chunking works: state carries over between calls
+    template <typename Callback>
+    void feed(const char* data, int size, Callback&& onValue)
+    {
+        for (int i = 0; i < size; ++i)
+        {
+            const char c = data[i];
+
+            if (inString)
+            {
+                if (escaped)
+                {
+                    escaped = false;
+                    if (capturing)
+                        text += (c == 'n' ? '\n' : c == 't' ? '\t' : c);  // \uXXXX stays as written; ids are ASCII
+                }
+                else if (c == '\\')
+                {
+                    escaped = true;
+                }
+                else if (c == '"')
+                {
+                    inString = false;
+                    finishString(onValue);
+                }
+                else if (capturing && text.size() < maxStringBytes)
+                {
+                    text += c;
+                }
+                continue;
+            }
+
+            switch (c)
+            {
+                case '"':
+                    inString = true;
+                    text.clear();
+                    // Only an entry's own keys, and the value of its field, are kept
+                    capturing = depth == entryDepth && isInObject() && (expectingKey || currentKey == field);
+                    break;
+                case '{':
+                case '[':
+                    push(c);
+                    break;
+                case '}':
+                case ']':
+                    pop();
+                    break;
+                case ':':
+                    expectingKey = false;
+                    break;
+                case ',':
+                    expectingKey = isInObject();
+                    if (depth == entryDepth)
+                        currentKey.clear();
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+private:
+    static constexpr int entryDepth = 3;
+    static constexpr int maxDepth = 32;          // Deeper nesting is tracked by count only
+    static constexpr size_t maxStringBytes = 256;
+
+    bool isInObject() const
+    {
+        return depth > 0 && depth <= maxDepth && containers[depth - 1] == '{';
+    }
+
+    void push(char container)
+    {
+        if (depth < maxDepth)
+            containers[depth] = container;
+        ++depth;
+        expectingKey = container == '{';
+        if (depth == entryDepth)
+            currentKey.clear();
+    }
+
+    void pop()
+    {
+        if (depth > 0)
+            --depth;
+        expectingKey = false;
+    }
+
+    template <typename Callback>
+    void finishString(Callback& onValue)
+    {
+        if (! capturing)
+            return;
+        capturing = false;
+
+        if (expectingKey)
+        {
+            currentKey = text;
+            return;
+        }
+
+        if (! text.empty())
+            onValue(juce::String::fromUTF8(text.data(), static_cast<int>(text.size())));
+    }
+
+    const std::string field;
+    char containers[maxDepth] {};
+    int depth = 0;
+    bool inString = false;
+    bool escaped = false;
+    bool capturing = false;
+    bool expectingKey = false;
+    std::string text;
+    std::string currentKey;  // Of the entry being read
+};
+
+// Last fetched model list per provider, in ARES/models/<name>.xml, so the
+// models box fills instantly and the catalogue is only fetched again once it
+// is older than its TTL - then with If-None-Match, so an unchanged catalogue
+// costs a 304 and no body.
+namespace ModelListCache
+{
+    struct Entry
+    {
+        bool valid = false;
+        juce::StringArray models;
+        juce::String etag;
+        int64_t fetchedMs = 0;   // Wall clock
+    };
+
+    inline juce::File getFile(const juce::String& name)
+    {
+        return getAresDataDirectory()
+            .getChildFile("models")
+            .getChildFile(name + ".xml");
+    }
+
+    // sourceKey identifies the endpoint and account the list was fetched with;
+    // a list from another one isn't returned
+    inline Entry load(const juce::String& name, uint64_t sourceKey)
+    {
+        Entry entry;
+        auto xml = juce::XmlDocument::parse(getFile(name));
+        if (xml == nullptr || ! xml->hasTagName("ModelList")
+            || xml->getStringAttribute("source") != juce::String::toHexString(static_cast<juce::int64>(sourceKey)))
+            return entry;
+
+        for (auto* model : xml->getChildWithTagNameIterator("Model"))
+            entry.models.add(model->getStringAttribute("id"));
+
+        entry.etag = xml->getStringAttribute("etag");
+        entry.fetchedMs = xml->getStringAttribute("fetched").getLargeIntValue();
+        entry.valid = ! entry.models.isEmpty();
+        return entry;
+    }
+
+    inline void store(const juce::String& name, uint64_t sourceKey, const juce::StringArray& models, const juce::String& etag)
+    {
+        juce::XmlElement xml("ModelList");
+        xml.setAttribute("source", juce::String::toHexString(static_cast<juce::int64>(sourceKey)));
+        xml.setAttribute("etag", etag);
+        xml.setAttribute("fetched", juce::String(juce::Time::currentTimeMillis()));
+        for (const auto& model : models)
+            xml.createNewChildElement("Model")->setAttribute("id", model);
+
+        const auto file = getFile(name);
+        file.getParentDirectory().createDirectory();
+        if (! xml.writeTo(file))
+            AR3S_LOG_WARNING("AiClient", "Failed to write model list cache {}", file.getFullPathName());
+    }
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "DataDirectory.h"
+#include "Logger.h"
+
+// On-disk cache of structured AI suggestions, so asking again about practically
+// the same material costs no network round trip.
+//
+// Entries are keyed by a 64-bit hash of the request context (provider, model,
+// genre/source/situation, gear and metering quantized to ~1 dB - the caller
+// builds that string). The store is one fixed-size file, ARES/ai_cache.bin,
+// memory-mapped by every master instance on the machine. When it is full, the
+// least recently used entry is replaced. Each entry has its own sequence
+// (odd while written) so that readers skip torn entries and two writers never
+// fill the same entry at once. An entry left odd by a writer that died is
+// reclaimed once it has been stuck for STUCK_WRITE_MS.
+struct AiResponseCacheData
+{
+    static constexpr uint32_t MAGIC = 0x41524331;  // "ARC1"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr int NUM_ENTRIES = 128;
+    static constexpr int MAX_TEXT_BYTES = 4000;   // Suggestions are short JSON; longer replies aren't cached
+
+    struct Entry
+    {
+        std::atomic<uint32_t> sequence { 0 };
+        std::atomic<uint64_t> key { 0 };          // 0 = empty
+        std::atomic<int64_t> createdMs { 0 };
+        std::atomic<int64_t> lastUsedMs { 0 };
+        std::atomic<uint32_t> length { 0 };
+        char text[MAX_TEXT_BYTES] {};
+    };
+
+    std::atomic<uint32_t> magic { MAGIC };
+    std::atomic<uint32_t> version { VERSION };
+    Entry entries[NUM_ENTRIES];
+};
+
+class AiResponseCache
+{
+public:
+    static constexpr int64_t MAX_AGE_MS = 7LL * 24 * 60 * 60 * 1000;  // Model updates make old answers stale
+    static constexpr int64_t STUCK_WRITE_MS = 10000;  // A write takes microseconds
+
+    ~AiResponseCache() { close(); }
+
+    // 64-bit FNV-1a of the UTF-8 context: stable across builds and platforms
+    static uint64_t makeKey(const juce::String& context)
+    {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (auto* p = context.toRawUTF8(); *p != 0; ++p)
+        {
+            hash ^= static_cast<unsigned char>(*p);
+            hash *= 0x100000001b3ull;
+        }
+        return hash != 0 ? hash : 1;  // 0 marks an empty entry
+    }
+
+    static juce::File getDefaultFile()
+    {
+        return getAresDataDirectory().getChildFile("ai_cache.bin");
+    }
+
+    bool open(const juce::File& file = getDefaultFile())
+    {
+        close();
+        file.getParentDirectory().createDirectory();
+
+        fd = ::open(file.getFullPathName().toRawUTF8(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0)
+        {
+            AR3S_LOG_WARNING("AiCache", "Failed to open cache file, errno={}", errno);
+            return false;
+        }
+
+        // A new file (or one from an older layout) is zero-filled to the right size
+        bool needsInit = false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size != static_cast<off_t>(sizeof(AiResponseCacheData)))
+        {
+            if (ftruncate(fd, 0) != 0 || ftruncate(fd, sizeof(AiResponseCacheData)) != 0)
+            {
+                AR3S_LOG_WARNING("AiCache", "Failed to size cache file, errno={}", errno);
+                close();
+                return false;
+            }
+            needsInit = true;
+        }
+
+        void* mapped = mmap(nullptr, sizeof(AiResponseCacheData), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED)
+        {
+            AR3S_LOG_WARNING("AiCache", "mmap failed, errno={}", errno);
+            close();
+            return false;
+        }
+        data = static_cast<AiResponseCacheData*>(mapped);
+
+        if (needsInit || data->magic.load() != AiResponseCacheData::MAGIC
+                      || data->version.load() != AiResponseCacheData::VERSION)
+            new (data) AiResponseCacheData();
+
+        return true;
+    }
+
+    void close()
+    {
+        if (data != nullptr)
+        {
+            munmap(data, sizeof(AiResponseCacheData));
+            data = nullptr;
+        }
+        if (fd >= 0)
+        {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    bool isOpen() const { return data != nullptr; }
+
+    bool lookup(uint64_t key, juce::String& dest)
+    {
+        if (data == nullptr || key == 0)
+            return false;
+
+        const auto now = juce::Time::currentTimeMillis();
+        for (auto& entry : data->entries)
+        {
+            if (entry.key.load(std::memory_order_relaxed) != key)
+                continue;
+
+            const auto before = entry.sequence.load(std::memory_order_acquire);
+            if ((before & 1u) != 0)
+                continue;
+
+            const auto length = std::min<uint32_t>(entry.length.load(std::memory_order_relaxed),
+                                                   AiResponseCacheData::MAX_TEXT_BYTES);
+            const auto createdMs = entry.createdMs.load(std::memory_order_relaxed);
+            char text[AiResponseCacheData::MAX_TEXT_BYTES];
+            std::memcpy(text, entry.text, length);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (entry.sequence.load(std::memory_order_relaxed) != before
+                || entry.key.load(std::memory_order_relaxed) != key
+                || length == 0 || now - createdMs > MAX_AGE_MS)
+                continue;
+
+            entry.lastUsedMs.store(now, std::memory_order_relaxed);
+            dest = juce::String::fromUTF8(text, static_cast<int>(length));
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void store(uint64_t key, const juce::String& text)
+    {
+        const auto length = text.getNumBytesAsUTF8();
+        if (data == nullptr || key == 0 || length == 0 || length > static_cast<size_t>(AiResponseCacheData::MAX_TEXT_BYTES))
+            return;
+
+        // Same key, else an empty entry, else the least recently used one. Entries
+        // another instance is writing are passed over, so they can't stall the cache.
+        const auto now = juce::Time::currentTimeMillis();
+        AiResponseCacheData::Entry* victim = nullptr;
+        for (auto& entry : data->entries)
+        {
+            const auto entryKey = entry.key.load(std::memory_order_relaxed);
+            const bool busy = isBeingWritten(entry, now);
+            if (entryKey == key)
+            {
+                if (busy)
+                    return;  // Someone is storing this answer already
+                victim = &entry;
+                break;
+            }
+            if (busy)
+                continue;
+            if (victim == nullptr
+                || (victim->key.load(std::memory_order_relaxed) != 0
+                    && (entryKey == 0 || entry.lastUsedMs.load(std::memory_order_relaxed)
+                                             < victim->lastUsedMs.load(std::memory_order_relaxed))))
+                victim = &entry;
+        }
+        if (victim == nullptr)
+            return;
+
+        // Claim the entry (even -> odd, or a stuck odd -> the next odd); if another
+        // instance got there first, skip - the answer isn't lost for long. The stamp
+        // before the claim keeps our write from looking stuck to other writers.
+        auto sequence = victim->sequence.load(std::memory_order_acquire);
+        const bool stuck = (sequence & 1u) != 0;
+        if (stuck && isBeingWritten(*victim, now))
+            return;
+        victim->lastUsedMs.store(now, std::memory_order_relaxed);
+        const auto claimed = sequence + (stuck ? 2u : 1u);
+        if (! victim->sequence.compare_exchange_strong(sequence, claimed, std::memory_order_acq_rel))
+            return;
+        std::atomic_thread_fence(std::memory_order_release);
+
+        victim->key.store(key, std::memory_order_relaxed);
+        victim->createdMs.store(now, std::memory_order_relaxed);
+        victim->length.store(static_cast<uint32_t>(length), std::memory_order_relaxed);
+        std::memcpy(victim->text, text.toRawUTF8(), length);
+        victim->sequence.store(claimed + 1, std::memory_order_release);
+        if (stuck)
+            AR3S_LOG_INFO("AiCache", "Reclaimed an entry left half-written");
+    }
+
+    uint64_t getHitCount() const { return hits.load(std::memory_order_relaxed); }
+    uint64_t getMissCount() const { return misses.load(std::memory_order_relaxed); }
+
+private:
+    // Odd and stamped recently: a live writer. Odd for longer: its writer died mid-write.
+    static bool isBeingWritten(const AiResponseCacheData::Entry& entry, int64_t now)
+    {
+        return (entry.sequence.load(std::memory_order_acquire) & 1u) != 0
+            && now - entry.lastUsedMs.load(std::memory_order_relaxed) < STUCK_WRITE_MS;
+    }
+
+    int fd = -1;
+    AiResponseCacheData* data = nullptr;
+    std::atomic<uint64_t> hits { 0 };
+    std::atomic<uint64_t> misses { 0 };
+};
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cstring>
+
+// Streamed AI replies, passed from the AI thread to the chat view as they arrive.
+//
+// Providers stream their replies (Ollama as newline-delimited JSON, the cloud APIs
+// as server-sent events). Each decoded piece of text goes into a bounded lock-free
+// queue that the editor drains on its timer, so the chat shows the first words after
+// the first-token latency instead of after the whole generation.
+struct AiStreamChunk
+{
+    enum class Kind : uint8_t
+    {
+        Begin,  // A reply started (replaces the "Thinking..." placeholder)
+        Text,
+        End     // Reply finished, or was cut short
+    };
+
+    static constexpr int TEXT_BYTES = 240;
+
+    Kind kind = Kind::Text;
+    uint32_t streamId = 0;
+    int length = 0;
+    char text[TEXT_BYTES] {};
+
+    juce::String getText() const { return juce::String::fromUTF8(text, length); }
+};
+
+// Bounded multi-producer, single-consumer ring (Vyukov style, like the logger's).
+// Producers never wait: if nothing drains the queue (editor closed) chunks are
+// dropped and counted.
+class AiStreamQueue
+{
+public:
+    static constexpr int CAPACITY = 512;  // Chunks (power of two)
+
+    AiStreamQueue()
+    {
+        for (int i = 0; i < CAPACITY; ++i)
+            slots[i].sequence.store(static_cast<uint64_t>(i), std::memory_order_relaxed);
+    }
+
+    bool push(AiStreamChunk::Kind kind, uint32_t streamId, const char* data = nullptr, int length = 0)
+    {
+        uint64_t position = writePosition.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        for (;;)
+        {
+            slot = &slots[position % CAPACITY];
+            const auto sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence == position)
+            {
+                if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (sequence < position)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                position = writePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->chunk.kind = kind;
+        slot->chunk.streamId = streamId;
+        slot->chunk.length = juce::jlimit(0, AiStreamChunk::TEXT_BYTES, length);
+        if (data != nullptr && slot->chunk.length > 0)
+            std::memcpy(slot->chunk.text, data, static_cast<size_t>(slot->chunk.length));
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Splits the text into chunks without cutting a UTF-8 sequence in half.
+    // Returns false if any piece was dropped.
+    bool pushText(uint32_t streamId, const juce::String& text)
+    {
+        const char* data = text.toRawUTF8();
+        int remaining = static_cast<int>(text.getNumBytesAsUTF8());
+        bool allQueued = true;
+        while (remaining > 0)
+        {
+            int length = std::min(remaining, AiStreamChunk::TEXT_BYTES);
+            if (length < remaining)
+                while (length > 1 && (static_cast<unsigned char>(data[length]) & 0xC0) == 0x80)
+                    --length;
+
+            allQueued = push(AiStreamChunk::Kind::Text, streamId, data, length) && allQueued;
+            data += length;
+            remaining -= length;
+        }
+        return allQueued;
+    }
+
+    // Consumer (message thread) only
+    bool pop(AiStreamChunk& dest)
+    {
+        auto& slot = slots[readPosition % CAPACITY];
+        if (slot.sequence.load(std::memory_order_acquire) != readPosition + 1)
+            return false;
+
+        dest.kind = slot.chunk.kind;
+        dest.streamId = slot.chunk.streamId;
+        dest.length = slot.chunk.length;
+        std::memcpy(dest.text, slot.chunk.text, static_cast<size_t>(dest.length));
+        slot.sequence.store(readPosition + CAPACITY, std::memory_order_release);
+        ++readPosition;
+        return true;
+    }
+
+    // Consumer only: drops whatever was queued while nobody was listening
+    void clear()
+    {
+        AiStreamChunk chunk;
+        while (pop(chunk)) {}
+    }
+
+    uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence { 0 };
+        AiStreamChunk chunk;
+    };
+
+    Slot slots[CAPACITY];
+    std::atomic<uint64_t> writePosition { 0 };
+    std::atomic<uint64_t> dropped { 0 };
+    uint64_t readPosition = 0;  // Consumer only
+};
+
+// Decodes one line of a streamed reply. Returns the text the line adds (often
+// empty), sets done when the provider marks the end of the reply and error when
+// it reports one mid-stream.
+namespace AiStreamParser
+{
+    enum class Format
+    {
+        OllamaNdjson,   // {"message":{"content":"..."},"done":false} per line (/api/chat; /api/generate has "response")
+        OpenAiSse,      // data: {"choices":[{"delta":{"content":"..."}}]} ... data: [DONE]  (OpenAI, OpenRouter, MiniMax)
+        AnthropicSse    // data: {"type":"content_block_delta","delta":{"text":"..."}} ... message_stop
+    };
+
+    inline juce::String getErrorMessage(const juce::var& errorVar)
+    {
+        if (errorVar.isString())
+            return errorVar.toString();
+        if (auto* errorObj = errorVar.getDynamicObject())
+            return errorObj->getProperty("message").toString();
+        return {};
+    }
+
+    inline juce::String parseLine(Format format, const juce::String& line, bool& done, juce::String& error)
+    {
+        juce::String payload = line.trim();
+        if (payload.isEmpty())
+            return {};
+
+        if (format != Format::OllamaNdjson)
+        {
+            // SSE: only data lines carry content; "event:", "id:" and ": comment" lines are skipped
+            if (! payload.startsWith("data:"))
+                return {};
+            payload = payload.substring(5).trimStart();
+            if (payload == "[DONE]")
+            {
+                done = true;
+                return {};
+            }
+        }
+
+        const auto parsed = juce::JSON::parse(payload);
+        auto* obj = parsed.getDynamicObject();
+        if (obj == nullptr)
+            return {};
+
+        if (obj->hasProperty("error"))
+        {
+            error = getErrorMessage(obj->getProperty("error"));
+            if (error.isEmpty())
+                error = "Provider reported an error";
+            return {};
+        }
+
+        if (format == Format::OllamaNdjson)
+        {
+            if (static_cast<bool>(obj->getProperty("done")))
+                done = true;
+            if (auto* message = obj->getProperty("message").getDynamicObject())
+                return message->getProperty("content").toString();
+            return obj->getProperty("response").toString();
+        }
+
+        if (format == Format::AnthropicSse)
+        {
+            const auto type = obj->getProperty("type").toString();
+            if (type == "message_stop")
+                done = true;
+            if (type != "content_block_delta")
+                return {};
+            if (auto* delta = obj->getProperty("delta").getDynamicObject())
+                return delta->getProperty("text").toString();
+            return {};
+        }
+
+        const auto choices = obj->getProperty("choices");
+        if (! choices.isArray() || choices.getArray()->isEmpty())
+            return {};
+        if (auto* choice = choices.getArray()->getFirst().getDynamicObject())
+            if (auto* delta = choice->getProperty("delta").getDynamicObject())
+                return delta->getProperty("content").toString();
+        return {};
+    }
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cstdlib>
+
+// Folder for everything AR3S keeps on disk (settings, layout, caches, logs, traces).
+// AR3S_DATA_DIR moves it, so the benchmark tools never touch the user's files.
+inline juce::File getAresDataDirectory()
+{
+    const char* envDir = std::getenv("AR3S_DATA_DIR");
+    if (envDir != nullptr && *envDir != 0)
+        return juce::File(juce::String(envDir));
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("ARES");
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cmath>
+#include <vector>
+
+// Joint gain staging for all satellites.
+//
+// Each track i has a pre-gain level L_i, a desired gain d_i (its own target
+// minus L_i) and a weight w_i (how much it matters that the track lands on its
+// target). The solver minimises sum w_i (g_i - d_i)^2 subject to the summed bus
+// hitting a loudness target and staying under a peak limit. With the bus
+// constraint active the Lagrange condition gives g_i = d_i + mu / w_i, and bus
+// level is monotonic in mu, so mu is found by bisection: O(iterations x tracks),
+// i.e. microseconds for a few hundred tracks.
+struct GainSolverTrack
+{
+    float levelDb = -120.0f;  // Pre-gain level (RMS, or short-term LUFS when the satellite measures it)
+    float crestDb = 12.0f;    // Peak - RMS
+    float desiredGainDb = 0.0f;
+    float weight = 1.0f;
+};
+
+struct GainSolverResult
+{
+    bool valid = false;
+    bool peakLimited = false;       // Bus peak limit, not the loudness target, set the level
+    float busLevelDb = -120.0f;     // Predicted summed RMS after the solved gains
+    float busPeakDb = -120.0f;      // Predicted summed peak
+    int iterations = 0;
+};
+
+class GainStagingSolver
+{
+public:
+    static constexpr float minGainDb = -24.0f;  // Same range as the satellite gain parameter
+    static constexpr float maxGainDb = 12.0f;
+
+    // busTargetDb < -100 means no loudness target: tracks keep their desired gains
+    // unless the peak limit forces the whole bus down.
+    static GainSolverResult solve(const std::vector<GainSolverTrack>& tracks, float busTargetDb,
+                                  float busPeakLimitDb, std::vector<float>& gainsDb)
+    {
+        GainSolverResult result;
+        gainsDb.assign(tracks.size(), 0.0f);
+        if (tracks.empty())
+            return result;
+
+        float maxWeight = 0.0f;
+        for (const auto& track : tracks)
+            maxWeight = std::max(maxWeight, track.weight);
+
+        // The peak limit caps the bus level; the bus crest barely moves with the
+        // gains, so two refinement rounds are enough for it to settle
+        float mu = 0.0f;
+        for (int round = 0; round < 3; ++round)
+        {
+            const float crest = busCrestDb(tracks, mu);
+            const float peakCapDb = busPeakLimitDb - crest;
+            const bool hasTarget = busTargetDb > -100.0f;
+
+            float levelTarget = hasTarget ? busTargetDb : busLevelDb(tracks, 0.0f);
+            result.peakLimited = levelTarget > peakCapDb;
+            if (result.peakLimited)
+                levelTarget = peakCapDb;
+
+            if (! hasTarget && ! result.peakLimited)
+            {
+                mu = 0.0f;
+                break;
+            }
+
+            // Bisection on mu; +/-(gain range x max weight) saturates every track
+            float lo = -(maxGainDb - minGainDb) * maxWeight;
+            float hi = (maxGainDb - minGainDb) * maxWeight;
+            for (int i = 0; i < 40 && hi - lo > 1.0e-4f; ++i, ++result.iterations)
+            {
+                mu = 0.5f * (lo + hi);
+                if (busLevelDb(tracks, mu) < levelTarget)
+                    lo = mu;
+                else
+                    hi = mu;
+            }
+            mu = 0.5f * (lo + hi);
+
+            if (! result.peakLimited || std::abs(busCrestDb(tracks, mu) - crest) < 0.05f)
+                break;
+        }
+
+        for (size_t i = 0; i < tracks.size(); ++i)
+            gainsDb[i] = gainFor(tracks[i], mu);
+
+        result.valid = true;
+        result.busLevelDb = busLevelDb(tracks, mu);
+        result.busPeakDb = result.busLevelDb + busCrestDb(tracks, mu);
+        return result;
+    }
+
+private:
+    static float gainFor(const GainSolverTrack& track, float mu)
+    {
+        return juce::jlimit(minGainDb, maxGainDb, track.desiredGainDb + mu / std::max(track.weight, 1.0e-3f));
+    }
+
+    // Uncorrelated tracks sum in power
+    static float busLevelDb(const std::vector<GainSolverTrack>& tracks, float mu)
+    {
+        double power = 0.0;
+        for (const auto& track : tracks)
+            power += std::pow(10.0, (track.levelDb + gainFor(track, mu)) / 10.0);
+        return power > 0.0 ? static_cast<float>(10.0 * std::log10(power)) : -120.0f;
+    }
+
+    // Crest of the bus, estimated as the power-weighted mean of the tracks' crest
+    // (in the power domain, so one very spiky loud track dominates)
+    static float busCrestDb(const std::vector<GainSolverTrack>& tracks, float mu)
+    {
+        double power = 0.0, peakPower = 0.0;
+        for (const auto& track : tracks)
+        {
+            const double p = std::pow(10.0, (track.levelDb + gainFor(track, mu)) / 10.0);
+            power += p;
+            peakPower += p * std::pow(10.0, track.crestDb / 10.0);
+        }
+        return power > 0.0 ? static_cast<float>(10.0 * std::log10(peakPower / power)) : 0.0f;
+    }
+};
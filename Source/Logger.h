@@ -0,0 +1,309 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include <unistd.h>
+#include "DataDirectory.h"
+
+// Structured logging that is safe on the audio thread, and stays on in release builds.
+//
+// A call copies a fixed-size binary record (format literal, up to four numeric
+// or short text arguments) into a bounded multi-producer ring: no allocation,
+// no locks, no syscalls. When the ring is full the record is dropped and
+// counted, never waited for. A background thread formats the records and
+// appends them to ARES/logs/<role>.log, rotating at 1 MB and keeping three old
+// files. Format strings use {} placeholders and must be string literals, as
+// must tags.
+//
+//   AR3S_LOG_INFO("SharedMemory", "Connected to slot {} as '{}'", slotIndex, channelName);
+enum class LogLevel : uint8_t
+{
+    Debug,
+    Info,
+    Warning,
+    Error
+};
+
+class RealtimeLogger
+{
+public:
+    static constexpr int CAPACITY = 1024;      // Records (power of two)
+    static constexpr int MAX_ARGS = 4;
+    static constexpr int TEXT_BYTES = 64;      // Shared by all text arguments of a record
+    static constexpr int64_t MAX_FILE_BYTES = 1024 * 1024;
+    static constexpr int KEPT_FILES = 3;
+
+    static RealtimeLogger& getInstance()
+    {
+        static RealtimeLogger instance;
+        return instance;
+    }
+
+    // Keeps the writer thread running while at least one processor holds a Session
+    class Session
+    {
+    public:
+        explicit Session(const char* role) { getInstance().addSession(role); }
+        ~Session() { getInstance().removeSession(); }
+
+        JUCE_DECLARE_NON_COPYABLE(Session)
+    };
+
+    template <typename... Args>
+    void log(LogLevel level, const char* tag, const char* format, const Args&... args)
+    {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "RealtimeLogger records hold at most four arguments");
+
+        // Claim a slot (bounded MPMC ring, Vyukov style); give up if it's full
+        uint64_t position = writePosition.load(std::memory_order_relaxed);
+        Record* record = nullptr;
+        for (;;)
+        {
+            record = &records[position % CAPACITY];
+            const auto sequence = record->sequence.load(std::memory_order_acquire);
+            if (sequence == position)
+            {
+                if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (sequence < position)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+            {
+                position = writePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        record->timeMs = juce::Time::currentTimeMillis();
+        record->level = level;
+        record->tag = tag;
+        record->format = format;
+        record->numArgs = 0;
+        record->textUsed = 0;
+        (record->add(args), ...);
+        record->sequence.store(position + 1, std::memory_order_release);
+    }
+
+    uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    static juce::File getLogDirectory()
+    {
+        return getAresDataDirectory().getChildFile("logs");
+    }
+
+private:
+    struct Arg
+    {
+        enum class Type : uint8_t { Int, Float, Text };
+        Type type = Type::Int;
+        uint8_t textOffset = 0;
+        uint8_t textLength = 0;
+        int64_t intValue = 0;
+        double floatValue = 0.0;
+    };
+
+    struct Record
+    {
+        std::atomic<uint64_t> sequence { 0 };
+        int64_t timeMs = 0;
+        LogLevel level = LogLevel::Info;
+        const char* tag = nullptr;
+        const char* format = nullptr;
+        int numArgs = 0;
+        int textUsed = 0;
+        Arg args[MAX_ARGS];
+        char text[TEXT_BYTES] {};
+
+        void addText(const char* value, size_t length)
+        {
+            auto& arg = args[numArgs++];
+            arg.type = Arg::Type::Text;
+            length = std::min(length, static_cast<size_t>(TEXT_BYTES - textUsed));
+            arg.textOffset = static_cast<uint8_t>(textUsed);
+            arg.textLength = static_cast<uint8_t>(length);
+            std::memcpy(text + textUsed, value, length);
+            textUsed += static_cast<int>(length);
+        }
+
+        template <typename T>
+        void add(const T& value)
+        {
+            if constexpr (std::is_same_v<T, juce::String>)
+            {
+                addText(value.toRawUTF8(), value.getNumBytesAsUTF8());
+            }
+            else if constexpr (std::is_convertible_v<T, const char*>)
+            {
+                const char* s = value;
+                addText(s != nullptr ? s : "(null)", s != nullptr ? std::strlen(s) : 6);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                auto& arg = args[numArgs++];
+                arg.type = Arg::Type::Float;
+                arg.floatValue = static_cast<double>(value);
+            }
+            else
+            {
+                static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Unsupported log argument type");
+                auto& arg = args[numArgs++];
+                arg.type = Arg::Type::Int;
+                arg.intValue = static_cast<int64_t>(value);
+            }
+        }
+    };
+
+    class Writer : public juce::Thread
+    {
+    public:
+        Writer(RealtimeLogger& loggerToDrain, const char* processRole)
+            : juce::Thread("AR3S Log Writer"), logger(loggerToDrain), role(processRole) {}
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                wait(100);
+                logger.drain(*this);
+            }
+            logger.drain(*this);  // Flush what is left on shutdown
+        }
+
+        void write(const juce::String& line)
+        {
+            const auto file = getLogDirectory().getChildFile(role + ".log");
+            if (file.getSize() > MAX_FILE_BYTES)
+                rotate(file);
+
+            file.getParentDirectory().createDirectory();
+            file.appendText(line + "\n", false, false, "\n");
+        }
+
+    private:
+        // role.log -> role.1.log -> ... -> role.KEPT_FILES.log (deleted). Processes
+        // sharing a role append to the same file; the pid on each line tells them apart.
+        void rotate(const juce::File& file)
+        {
+            const auto dir = file.getParentDirectory();
+            dir.getChildFile(role + "." + juce::String(KEPT_FILES) + ".log").deleteFile();
+            for (int n = KEPT_FILES - 1; n >= 1; --n)
+                dir.getChildFile(role + "." + juce::String(n) + ".log")
+                    .moveFileTo(dir.getChildFile(role + "." + juce::String(n + 1) + ".log"));
+            file.moveFileTo(dir.getChildFile(role + ".1.log"));
+        }
+
+        RealtimeLogger& logger;
+        juce::String role;
+    };
+
+    RealtimeLogger()
+    {
+        for (int i = 0; i < CAPACITY; ++i)
+            records[i].sequence.store(static_cast<uint64_t>(i), std::memory_order_relaxed);
+    }
+
+    void addSession(const char* role)
+    {
+        const juce::ScopedLock lock(sessionLock);
+        if (sessionCount++ == 0)
+        {
+            writer = std::make_unique<Writer>(*this, role);
+            writer->startThread(juce::Thread::Priority::background);
+        }
+    }
+
+    void removeSession()
+    {
+        const juce::ScopedLock lock(sessionLock);
+        if (--sessionCount == 0 && writer != nullptr)
+        {
+            writer->signalThreadShouldExit();
+            writer->notify();
+            writer->waitForThreadToExit(2000);
+            writer.reset();
+        }
+    }
+
+    // Writer thread only (the single consumer)
+    void drain(Writer& output)
+    {
+        static const char* const levelNames[] = { "DEBUG", "INFO ", "WARN ", "ERROR" };
+        const auto pid = juce::String(static_cast<int>(::getpid()));
+        juce::String batch;
+
+        for (;;)
+        {
+            auto& record = records[readPosition % CAPACITY];
+            if (record.sequence.load(std::memory_order_acquire) != readPosition + 1)
+                break;
+
+            if (batch.isNotEmpty())
+                batch << "\n";
+            batch << juce::Time(record.timeMs).formatted("%Y-%m-%d %H:%M:%S.")
+                  << juce::String(record.timeMs % 1000).paddedLeft('0', 3)
+                  << " [" << pid << "] " << levelNames[static_cast<int>(record.level)] << " "
+                  << record.tag << ": " << format(record);
+
+            record.sequence.store(readPosition + CAPACITY, std::memory_order_release);
+            ++readPosition;
+        }
+
+        const auto droppedNow = dropped.load(std::memory_order_relaxed);
+        if (droppedNow != reportedDropped)
+        {
+            if (batch.isNotEmpty())
+                batch << "\n";
+            batch << "[" << pid << "] WARN  Logger: " << juce::String(droppedNow - reportedDropped)
+                  << " records dropped (ring full)";
+            reportedDropped = droppedNow;
+        }
+
+        if (batch.isNotEmpty())
+            output.write(batch);
+    }
+
+    static juce::String format(const Record& record)
+    {
+        juce::String result;
+        int argIndex = 0;
+        const char* runStart = record.format;
+        for (const char* p = record.format; p != nullptr && *p != 0; ++p)
+        {
+            if (p[0] != '{' || p[1] != '}' || argIndex >= record.numArgs)
+                continue;
+
+            result << juce::String(runStart, static_cast<size_t>(p - runStart));
+            const auto& arg = record.args[argIndex++];
+            switch (arg.type)
+            {
+                case Arg::Type::Int:   result << juce::String(arg.intValue); break;
+                case Arg::Type::Float: result << juce::String(arg.floatValue, 2); break;
+                case Arg::Type::Text:  result << juce::String::fromUTF8(record.text + arg.textOffset, arg.textLength); break;
+            }
+            runStart = ++p + 1;
+        }
+        if (record.format != nullptr)
+            result << runStart;
+        return result;
+    }
+
+    Record records[CAPACITY];
+    std::atomic<uint64_t> writePosition { 0 };
+    std::atomic<uint64_t> dropped { 0 };
+    uint64_t readPosition = 0;      // Writer thread only
+    uint64_t reportedDropped = 0;   // Writer thread only
+
+    juce::CriticalSection sessionLock;
+    int sessionCount = 0;
+    std::unique_ptr<Writer> writer;
+};
+
+#define AR3S_LOG_DEBUG(tag, ...) RealtimeLogger::getInstance().log(LogLevel::Debug, tag, __VA_ARGS__)
+#define AR3S_LOG_INFO(tag, ...) RealtimeLogger::getInstance().log(LogLevel::Info, tag, __VA_ARGS__)
+#define AR3S_LOG_WARNING(tag, ...) RealtimeLogger::getInstance().log(LogLevel::Warning, tag, __VA_ARGS__)
+#define AR3S_LOG_ERROR(tag, ...) RealtimeLogger::getInstance().log(LogLevel::Error, tag, __VA_ARGS__)
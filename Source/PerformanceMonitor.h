@@ -0,0 +1,252 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include "Logger.h"
+
+// Work a block did, recorded with overrun incidents so a slow block can be
+// attributed to what ran in it
+enum ProcessingStage : uint32_t
+{
+    StageFftFrame     = 1u << 0,  // A spectrum / band analysis frame completed
+    StageCeiling      = 1u << 1,  // Peak limiter engaged
+    StageIpcPush      = 1u << 2,  // Metering or control written to shared memory
+    StageCommands     = 1u << 3,  // Master commands drained
+    StageAudioStream  = 1u << 4,  // Audio streamed to the master
+    StageLoudness     = 1u << 5   // LUFS / true peak block completed
+};
+
+inline juce::String describeProcessingStages(uint32_t stages)
+{
+    static const char* const names[] = { "FFT", "Ceiling", "IPC", "Commands", "Stream", "Loudness" };
+    juce::String text;
+    for (int bit = 0; bit < 6; ++bit)
+        if ((stages & (1u << bit)) != 0)
+            text << (text.isEmpty() ? "" : "+") << names[bit];
+    return text.isEmpty() ? juce::String("gain only") : text;
+}
+
+// A block that overran its deadline, or came close
+struct OverrunIncident
+{
+    int64_t timeMs = 0;           // Wall clock, to line up with the DAW's dropout report
+    int numSamples = 0;
+    float elapsedMicros = 0.0f;
+    float deadlineMicros = 0.0f;
+    uint32_t stages = 0;
+    bool overrun = false;         // false = near miss
+};
+
+// Small ring of recent incidents. Single producer (audio thread); readers use
+// the per-entry sequence (odd while written) to skip entries caught mid-write.
+class OverrunIncidentLog
+{
+public:
+    static constexpr int CAPACITY = 32;
+
+    void push(const OverrunIncident& incident)
+    {
+        const auto w = writeIndex.load(std::memory_order_relaxed);
+        auto& entry = entries[w % CAPACITY];
+        const auto sequence = entry.sequence.load(std::memory_order_relaxed);
+        entry.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        entry.timeMs.store(incident.timeMs, std::memory_order_relaxed);
+        entry.numSamples.store(incident.numSamples, std::memory_order_relaxed);
+        entry.elapsedMicros.store(incident.elapsedMicros, std::memory_order_relaxed);
+        entry.deadlineMicros.store(incident.deadlineMicros, std::memory_order_relaxed);
+        entry.stages.store(incident.stages, std::memory_order_relaxed);
+        entry.overrun.store(incident.overrun, std::memory_order_relaxed);
+        entry.sequence.store(sequence + 2, std::memory_order_release);
+        writeIndex.store(w + 1, std::memory_order_release);
+
+        (incident.overrun ? overrunCount : nearMissCount).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Newest first
+    void getRecent(std::vector<OverrunIncident>& dest, int maxIncidents = CAPACITY) const
+    {
+        dest.clear();
+        const auto w = writeIndex.load(std::memory_order_acquire);
+        const auto available = std::min<uint64_t>(w, static_cast<uint64_t>(std::min(maxIncidents, CAPACITY)));
+        for (uint64_t n = 1; n <= available; ++n)
+        {
+            const auto& entry = entries[(w - n) % CAPACITY];
+            const auto before = entry.sequence.load(std::memory_order_acquire);
+            if ((before & 1u) != 0)
+                continue;
+
+            OverrunIncident incident;
+            incident.timeMs = entry.timeMs.load(std::memory_order_relaxed);
+            incident.numSamples = entry.numSamples.load(std::memory_order_relaxed);
+            incident.elapsedMicros = entry.elapsedMicros.load(std::memory_order_relaxed);
+            incident.deadlineMicros = entry.deadlineMicros.load(std::memory_order_relaxed);
+            incident.stages = entry.stages.load(std::memory_order_relaxed);
+            incident.overrun = entry.overrun.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (entry.sequence.load(std::memory_order_relaxed) == before)
+                dest.push_back(incident);
+        }
+    }
+
+    uint32_t getOverrunCount() const { return overrunCount.load(std::memory_order_relaxed); }
+    uint32_t getNearMissCount() const { return nearMissCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry
+    {
+        std::atomic<uint32_t> sequence { 0 };
+        std::atomic<int64_t> timeMs { 0 };
+        std::atomic<int> numSamples { 0 };
+        std::atomic<float> elapsedMicros { 0.0f };
+        std::atomic<float> deadlineMicros { 0.0f };
+        std::atomic<uint32_t> stages { 0 };
+        std::atomic<bool> overrun { false };
+    };
+
+    Entry entries[CAPACITY];
+    std::atomic<uint64_t> writeIndex { 0 };
+    std::atomic<uint32_t> overrunCount { 0 };
+    std::atomic<uint32_t> nearMissCount { 0 };
+};
+
+// Measures what processBlock costs against its real-time deadline (the block's
+// duration, numSamples / sampleRate). The audio thread brackets each block with
+// begin()/end(); once per window (~1 s of audio) the average and worst block are
+// published to atomics that any thread can read. steady_clock reads are a vDSO
+// call on Linux/macOS, so the overhead is a few tens of ns per block.
+//
+// Blocks using at least nearMissLoad of their deadline are recorded as
+// incidents, together with the stages marked during the block.
+class ProcessingLoadMeter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    static constexpr double nearMissLoad = 0.5;  // One plugin using half the buffer is already a risk
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+        windowSamples = static_cast<int64_t>(sampleRate);
+        windowMicros = 0.0;
+        windowDeadlineMicros = 0.0;
+        windowMaxMicros = 0.0;
+        windowPeakLoad = 0.0;
+        windowBlocks = 0;
+        windowFill = 0;
+    }
+
+    Clock::time_point begin()
+    {
+        blockStages = 0;
+        return Clock::now();
+    }
+    
+    // Audio thread only: note that this block did some optional piece of work
+    void markStage(ProcessingStage stage) { blockStages |= stage; }
+
+    // Returns true when a window completed and the published values changed
+    bool end(Clock::time_point start, int numSamples)
+    {
+        const double elapsedMicros = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        const double deadlineMicros = numSamples * 1.0e6 / sampleRate;
+        lastBlockMicros.store(static_cast<float>(elapsedMicros), std::memory_order_relaxed);
+        lastBlockLoad.store(deadlineMicros > 0.0 ? static_cast<float>(elapsedMicros / deadlineMicros) : 0.0f,
+                            std::memory_order_relaxed);
+
+        windowMicros += elapsedMicros;
+        windowDeadlineMicros += deadlineMicros;
+        windowMaxMicros = std::max(windowMaxMicros, elapsedMicros);
+        if (deadlineMicros > 0.0)
+            windowPeakLoad = std::max(windowPeakLoad, elapsedMicros / deadlineMicros);
+        ++windowBlocks;
+        windowFill += numSamples;
+        
+        if (deadlineMicros > 0.0 && elapsedMicros >= nearMissLoad * deadlineMicros)
+            recordIncident(elapsedMicros, deadlineMicros, numSamples);
+
+        if (windowFill < windowSamples)
+            return false;
+
+        averageMicros.store(static_cast<float>(windowMicros / std::max(1, windowBlocks)), std::memory_order_relaxed);
+        maxMicros.store(static_cast<float>(windowMaxMicros), std::memory_order_relaxed);
+        averageLoad.store(windowDeadlineMicros > 0.0 ? static_cast<float>(windowMicros / windowDeadlineMicros) : 0.0f,
+                          std::memory_order_relaxed);
+        peakLoad.store(static_cast<float>(windowPeakLoad), std::memory_order_relaxed);
+
+        windowMicros = 0.0;
+        windowDeadlineMicros = 0.0;
+        windowMaxMicros = 0.0;
+        windowPeakLoad = 0.0;
+        windowBlocks = 0;
+        windowFill = 0;
+        return true;
+    }
+
+    // Times the enclosing scope, so early returns from processBlock are still counted
+    struct ScopedBlock
+    {
+        ScopedBlock(ProcessingLoadMeter& meterToUse, int blockSamples)
+            : meter(meterToUse), numSamples(blockSamples), start(meterToUse.begin()) {}
+        ~ScopedBlock() { meter.end(start, numSamples); }
+
+        ProcessingLoadMeter& meter;
+        const int numSamples;
+        const Clock::time_point start;
+    };
+
+    float getAverageMicros() const { return averageMicros.load(std::memory_order_relaxed); }
+    float getMaxMicros() const { return maxMicros.load(std::memory_order_relaxed); }
+    float getAverageLoad() const { return averageLoad.load(std::memory_order_relaxed); }  // Fraction of the deadline
+    float getPeakLoad() const { return peakLoad.load(std::memory_order_relaxed); }        // Worst block in the window
+    float getLastBlockMicros() const { return lastBlockMicros.load(std::memory_order_relaxed); }
+    float getLastBlockLoad() const { return lastBlockLoad.load(std::memory_order_relaxed); }
+    const OverrunIncidentLog& getIncidents() const { return incidents; }
+
+private:
+    void recordIncident(double elapsedMicros, double deadlineMicros, int numSamples)
+    {
+        OverrunIncident incident;
+        incident.timeMs = juce::Time::currentTimeMillis();
+        incident.numSamples = numSamples;
+        incident.elapsedMicros = static_cast<float>(elapsedMicros);
+        incident.deadlineMicros = static_cast<float>(deadlineMicros);
+        incident.stages = blockStages;
+        incident.overrun = elapsedMicros >= deadlineMicros;
+        incidents.push(incident);
+        
+        // Into the log file too, at most once a second so a struggling session can't flood it
+        if (incident.timeMs - lastIncidentLogMs >= 1000)
+        {
+            lastIncidentLogMs = incident.timeMs;
+            AR3S_LOG_WARNING("Performance", incident.overrun ? "Overrun: {} us of {} us deadline, {} samples, stage bits {}"
+                                                             : "Near-miss: {} us of {} us deadline, {} samples, stage bits {}",
+                             incident.elapsedMicros, incident.deadlineMicros, numSamples, incident.stages);
+        }
+    }
+    
+    double sampleRate = 44100.0;
+    int64_t windowSamples = 44100;
+
+    // Audio thread only
+    double windowMicros = 0.0;
+    double windowDeadlineMicros = 0.0;
+    double windowMaxMicros = 0.0;
+    double windowPeakLoad = 0.0;
+    int windowBlocks = 0;
+    int64_t windowFill = 0;
+    uint32_t blockStages = 0;
+    int64_t lastIncidentLogMs = 0;
+    OverrunIncidentLog incidents;
+
+    // Published once per window
+    std::atomic<float> averageMicros { 0.0f };
+    std::atomic<float> maxMicros { 0.0f };
+    std::atomic<float> averageLoad { 0.0f };
+    std::atomic<float> peakLoad { 0.0f };
+    std::atomic<float> lastBlockMicros { 0.0f };
+    std::atomic<float> lastBlockLoad { 0.0f };
+};
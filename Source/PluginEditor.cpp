@@ -62,13 +62,7 @@ void SimpleGainAudioProcessorEditor::resized()
                 // Ensure resize handle position
                 resizeCorner->setBounds(getWidth() - 18, getHeight() - 18, 18, 18);
 
-                // Diagnostics to capture what the UI looks like in the wild
-                DBG("[Layout] super-compact mode: window=" << getWidth() << "x" << getHeight());
-                DBG("gainSlider=" << gainSlider.getBounds().toString()
-                    << " targetDb=" << targetDbSlider.getBounds().toString()
-                    << " ceiling=" << ceilingSlider.getBounds().toString());
-                DBG("vuMeter=" << vuMeter.getBounds().toString() << " grMeter=" << grMeter.getBounds().toString());
-                DBG("satPanel=" << satellitePanel.getBounds().toString());
+                AR3S_LOG_DEBUG("Layout", "Super-compact layout at {}x{}", getWidth(), getHeight());
 
                 return;
             }
@@ -101,14 +95,7 @@ void SimpleGainAudioProcessorEditor::resized()
             // Ensure resize corner sits correctly
             resizeCorner->setBounds(getWidth() - 18, getHeight() - 18, 18, 18);
 
-            // Diagnostic logging to help debug narrow layouts
-            DBG("[Layout] small layout: window=" << getWidth() << "x" << getHeight());
-            DBG("gainSlider=" << gainSlider.getBounds().toString()
-                << " targetDb=" << targetDbSlider.getBounds().toString()
-                << " ceiling=" << ceilingSlider.getBounds().toString());
-            DBG("ioMeter=" << ioMeter.getBounds().toString() << " freqBalance=" << freqBalance.getBounds().toString());
-            DBG("vuMeter=" << vuMeter.getBounds().toString() << " advanced=" << advancedMeters.getBounds().toString());
-            DBG("satPanel=" << satellitePanel.getBounds().toString());
+            AR3S_LOG_DEBUG("Layout", "Small layout at {}x{}", getWidth(), getHeight());
 
             return;
         }
@@ -256,6 +243,7 @@ void SimpleGainAudioProcessorEditor::resized()
             modelLabel.setBounds(stack.removeFromTop(18)); modelBox.setBounds(stack.removeFromTop(36));
             aiProviderLabel.setBounds(stack.removeFromTop(18)); aiProviderBox.setBounds(stack.removeFromTop(36));
             apiKeyLabel.setBounds(stack.removeFromTop(18)); apiKeyEditor.setBounds(stack.removeFromTop(36));
+            raceLocalToggle.setBounds(stack.removeFromTop(28));
 
             micLabel.setBounds(stack.removeFromTop(18)); micBox.setBounds(stack.removeFromTop(28));
             preampLabel.setBounds(stack.removeFromTop(18)); preampBox.setBounds(stack.removeFromTop(28));
@@ -282,6 +270,8 @@ void SimpleGainAudioProcessorEditor::resized()
         left.removeFromTop(15);
         apiKeyLabel.setBounds(left.removeFromTop(20));
         apiKeyEditor.setBounds(left.removeFromTop(30));
+        left.removeFromTop(6);
+        raceLocalToggle.setBounds(left.removeFromTop(24));
         
         // Equipment section below API key (for AI context)
         left.removeFromTop(20);
@@ -1006,6 +996,7 @@ SimpleGainAudioProcessorEditor::SimpleGainAudioProcessorEditor(SimpleGainAudioPr
         bool needsKey = aiProviderBox.getSelectedId() > 1;
         apiKeyEditor.setVisible(needsKey);
         apiKeyLabel.setVisible(needsKey);
+        raceLocalToggle.setVisible(needsKey);
         
         // Refresh models for the new provider
         processor.refreshModelList();
@@ -1026,7 +1017,10 @@ SimpleGainAudioProcessorEditor::SimpleGainAudioProcessorEditor(SimpleGainAudioPr
     
     modelBox.onChange = [this] {
         if (modelBox.getSelectedId() > 0)
+        {
             processor.setSelectedModel(modelBox.getText());
+            processor.warmUpAiProvider();
+        }
     };
 
     apiKeyLabel.setText("API Key", juce::dontSendNotification);
@@ -1043,6 +1037,9 @@ SimpleGainAudioProcessorEditor::SimpleGainAudioProcessorEditor(SimpleGainAudioPr
     apiKeyEditor.setVisible(needsKey);
     apiKeyLabel.setVisible(needsKey);
     
+    raceLocalToggle.setToggleState(processor.isAiRaceMode(), juce::dontSendNotification);
+    raceLocalToggle.onClick = [this] { processor.setAiRaceMode(raceLocalToggle.getToggleState()); };
+
     apiKeyEditor.onTextChange = [this] {
         processor.setApiKey(apiKeyEditor.getText());
         // Refresh models when API key changes
@@ -1050,7 +1047,7 @@ SimpleGainAudioProcessorEditor::SimpleGainAudioProcessorEditor(SimpleGainAudioPr
     };
 
     refreshModelsButton.setButtonText("Refresh Models");
-    refreshModelsButton.onClick = [this] { processor.refreshModelList(); };
+    refreshModelsButton.onClick = [this] { processor.refreshModelList(true); };
 
     themeLabel.setText("Theme", juce::dontSendNotification);
     themeBox.addItemList(getThemeNames(), 1);
@@ -1126,6 +1123,8 @@ SimpleGainAudioProcessorEditor::SimpleGainAudioProcessorEditor(SimpleGainAudioPr
     chatHistory.setMultiLine(true);
     chatHistory.setScrollbarsShown(true);
     chatHistory.setText("Welcome to ARES Assistant!\n\nI'm your AI mixing engineer. Ask me about:\n\n- Plugin recommendations for your tracks\n- EQ, compression, reverb settings\n- Signal chain and processing order\n- Mixing techniques for any instrument\n- Mastering chain suggestions\n- Genre-specific production tips\n- Your current levels and gear\n\nType your question below...\n\n");
+    processor.discardChatStream();  // Replies streamed while no editor was open
+    processor.startNewChatConversation();  // The chat view starts empty, so does the model's history
     chatInput.setMultiLine(false);
     chatInput.setTextToShowWhenEmpty("Type your question here...", juce::Colours::grey);
     chatInput.onReturnKey = [this] { sendChatMessage(); };
@@ -1188,6 +1187,7 @@ SimpleGainAudioProcessorEditor::SimpleGainAudioProcessorEditor(SimpleGainAudioPr
     addChildComponent(aiProviderBox); addChildComponent(aiProviderLabel);
     addChildComponent(modelBox); addChildComponent(modelLabel);
     addChildComponent(apiKeyEditor); addChildComponent(apiKeyLabel);
+    addChildComponent(raceLocalToggle);
     addChildComponent(refreshModelsButton); addChildComponent(themeBox);
     addChildComponent(themeLabel); addChildComponent(knobStyleBox);
     addChildComponent(knobStyleLabel); addChildComponent(accentColorLabel);
@@ -1640,6 +1640,7 @@ SimpleGainAudioProcessorEditor::SimpleGainAudioProcessorEditor(SimpleGainAudioPr
     
     showMainView();
     processor.requestOllamaModelList();
+    processor.warmUpAiProvider();
 
     // Attach child mouse forwarder to enable moving/resizing of interactive elements
     childForwarder = std::make_unique<ChildMouseForwarder>(*this);
@@ -1796,6 +1797,7 @@ void SimpleGainAudioProcessorEditor::showMainView()
     aiProviderBox.setVisible(false); aiProviderLabel.setVisible(false);
     modelBox.setVisible(false); modelLabel.setVisible(false);
     apiKeyEditor.setVisible(false); apiKeyLabel.setVisible(false);
+    raceLocalToggle.setVisible(false);
     refreshModelsButton.setVisible(false); themeBox.setVisible(false);
     themeLabel.setVisible(false); knobStyleBox.setVisible(false);
     knobStyleLabel.setVisible(false); accentColorLabel.setVisible(false);
@@ -1860,6 +1862,7 @@ void SimpleGainAudioProcessorEditor::showSettingsView()
     bool needsKey = aiProviderBox.getSelectedId() > 1;
     apiKeyEditor.setVisible(needsKey);
     apiKeyLabel.setVisible(needsKey);
+    raceLocalToggle.setVisible(needsKey);
 
     chatLabel.setVisible(false); chatHistory.setVisible(false);
     chatInput.setVisible(false); sendChatBtn.setVisible(false);
@@ -1891,6 +1894,7 @@ void SimpleGainAudioProcessorEditor::showChatView()
     aiProviderBox.setVisible(false); aiProviderLabel.setVisible(false);
     modelBox.setVisible(false); modelLabel.setVisible(false);
     apiKeyEditor.setVisible(false); apiKeyLabel.setVisible(false);
+    raceLocalToggle.setVisible(false);
     refreshModelsButton.setVisible(false); themeBox.setVisible(false);
     themeLabel.setVisible(false); knobStyleBox.setVisible(false);
     knobStyleLabel.setVisible(false); accentColorLabel.setVisible(false);
@@ -2164,6 +2168,11 @@ void SimpleGainAudioProcessorEditor::drawSatellitePanel(juce::Graphics& g, juce:
     int satCount = processor.getActiveSatelliteCount();
     g.drawText("SATELLITES (" + juce::String(satCount) + ")", titleArea.reduced(10, 0), juce::Justification::left);
     
+    // Session-wide diagnostics live behind the title bar (see showSessionDiagnosticsMenu)
+    g.setFont(juce::FontOptions(10.0f));
+    g.setColour(theme.textDim);
+    g.drawText("Diagnostics", titleArea.reduced(10, 0), juce::Justification::right);
+    
     // Reserve space for controls if satellite is selected
     if (selectedSatellite >= 0)
         bounds.removeFromBottom(70);
@@ -2182,14 +2191,53 @@ void SimpleGainAudioProcessorEditor::drawSatellitePanel(juce::Graphics& g, juce:
                                             "Synth", "Str", "Other" };
     
     bounds = bounds.reduced(6, 4);
-    const float rowHeight = 28.0f;  // Increased row height
     
-    for (int i = 0; i < MAX_SATELLITES && bounds.getHeight() >= rowHeight; ++i)
+    // Masking heat map on the right when there is room next to the rows
+    const float heatMapSize = juce::jmin(bounds.getHeight(), bounds.getWidth() - 320.0f, 200.0f);
+    if (satCount >= 2 && heatMapSize >= 60.0f)
+        drawMaskingHeatMap(g, bounds.removeFromRight(heatMapSize).removeFromTop(heatMapSize));
+    
+    for (const auto& panelRow : layoutSatellitePanelRows())
     {
+        if (panelRow.top + panelRow.height > bounds.getHeight())
+            break;
+        
+        auto row = juce::Rectangle<float>(bounds.getX(), bounds.getY() + panelRow.top, bounds.getWidth(), panelRow.height);
+        
+        // Collapsible group header
+        if (panelRow.satIndex < 0)
+        {
+            const auto group = processor.getGroupInfo(panelRow.groupId);
+            g.setColour(theme.bgDark.withAlpha(0.7f));
+            g.fillRoundedRectangle(row, 3.0f);
+            
+            juce::Path arrow;
+            const auto arrowArea = row.removeFromLeft(18).withSizeKeepingCentre(8, 8);
+            if (collapsedGroups[(size_t) panelRow.groupId])
+                arrow.addTriangle(arrowArea.getX(), arrowArea.getY(), arrowArea.getRight(), arrowArea.getCentreY(), arrowArea.getX(), arrowArea.getBottom());
+            else
+                arrow.addTriangle(arrowArea.getX(), arrowArea.getY(), arrowArea.getRight(), arrowArea.getY(), arrowArea.getCentreX(), arrowArea.getBottom());
+            g.setColour(theme.accent);
+            g.fillPath(arrow);
+            
+            g.setFont(juce::FontOptions(11.0f).withStyle("Bold"));
+            juce::String title = panelRow.groupId == 0 ? juce::String("UNGROUPED") : juce::String(getSatelliteGroupName(panelRow.groupId)).toUpperCase();
+            g.drawText(title + " (" + juce::String(panelRow.memberCount) + ")", row.removeFromLeft(120), juce::Justification::left);
+            
+            if (panelRow.groupId > 0 && std::abs(group.gainOffsetDb) > 0.05f)
+            {
+                g.setFont(juce::FontOptions(10.0f));
+                g.setColour(theme.textDim);
+                g.drawText("grp " + juce::String(group.gainOffsetDb >= 0 ? "+" : "") + juce::String(group.gainOffsetDb, 1) + " dB",
+                           row.reduced(6, 0), juce::Justification::right);
+            }
+            continue;
+        }
+        
+        const int i = panelRow.satIndex;
         auto info = processor.getSatelliteInfo(i);
         if (!info.active) continue;
         
-        auto row = bounds.removeFromTop(rowHeight);
         bool isSelected = (i == selectedSatellite);
         
         // Row background - highlight selected
@@ -2239,19 +2287,158 @@ void SimpleGainAudioProcessorEditor::drawSatellitePanel(juce::Graphics& g, juce:
         g.setColour(levelColor);
         g.fillRoundedRectangle(levelBar.withWidth(levelBar.getWidth() * levelNorm), 3.0f);
         
+        // Loudness sparkline (last 10 seconds of the satellite's history ring)
+        if (row.getWidth() > 100.0f)
+        {
+            auto sparkArea = row.removeFromLeft(juce::jmin(90.0f, row.getWidth() - 50.0f)).reduced(4, 5);
+            const int numPoints = processor.getSatelliteHistory(i, satelliteHistoryScratch, 10 * MeterHistoryRing::RATE_HZ);
+            if (numPoints > 1)
+            {
+                juce::Path spark;
+                const float xStep = sparkArea.getWidth() / static_cast<float>(10 * MeterHistoryRing::RATE_HZ - 1);
+                float x = sparkArea.getRight() - xStep * static_cast<float>(numPoints - 1);
+                for (int p = 0; p < numPoints; ++p, x += xStep)
+                {
+                    const float norm = juce::jlimit(0.0f, 1.0f, (satelliteHistoryScratch[(size_t) p].rmsDb + 60.0f) / 60.0f);
+                    const float y = sparkArea.getBottom() - norm * sparkArea.getHeight();
+                    if (p == 0) spark.startNewSubPath(x, y);
+                    else spark.lineTo(x, y);
+                }
+                g.setColour(theme.accentAlt.withAlpha(isSelected ? 0.9f : 0.6f));
+                g.strokePath(spark, juce::PathStrokeType(1.2f));
+            }
+        }
+        
+        // CPU column: average share of the block deadline, coloured by the worst block
+        if (row.getWidth() > 80.0f)
+        {
+            auto cpuArea = row.removeFromRight(40.0f);
+            g.setFont(juce::FontOptions(10.0f));
+            g.setColour(info.cpuPeakLoad >= 0.5f ? theme.meterRed
+                        : (info.cpuPeakLoad >= 0.2f ? theme.meterYellow : theme.textDim));
+            g.drawText(juce::String(info.cpuAverageLoad * 100.0f, info.cpuAverageLoad < 0.1f ? 1 : 0) + "%",
+                       cpuArea, juce::Justification::centredRight);
+        }
+        
         // Gain display - larger font
         g.setFont(juce::FontOptions(11.0f).withStyle("Bold"));
         float gainDb = 20.0f * std::log10(std::max(0.0001f, info.currentGain));
         g.setColour(gainDb > 0 ? theme.meterYellow : theme.textBright);
         juce::String gainStr = (gainDb >= 0 ? "+" : "") + juce::String(gainDb, 1);
         g.drawText(gainStr, row, juce::Justification::centred);
-        
-        bounds.removeFromTop(3);  // Increased spacing
     }
     
     // No inline controls - use right-click context menu instead
 }
 
+std::vector<SimpleGainAudioProcessorEditor::SatellitePanelRow> SimpleGainAudioProcessorEditor::layoutSatellitePanelRows() const
+{
+    const float satelliteRowHeight = 28.0f;
+    const float headerRowHeight = 20.0f;
+    const float spacing = 3.0f;
+    
+    // Active satellites bucketed by group
+    std::array<std::vector<int>, MAX_SATELLITE_GROUPS + 1> members;
+    bool anyGrouped = false;
+    for (int i = 0; i < MAX_SATELLITES; ++i)
+    {
+        auto info = processor.getSatelliteInfo(i);
+        if (!info.active) continue;
+        members[(size_t) info.groupId].push_back(i);
+        anyGrouped = anyGrouped || info.groupId > 0;
+    }
+    
+    std::vector<SatellitePanelRow> rows;
+    float top = 0.0f;
+    auto addRow = [&rows, &top, spacing](int satIndex, int groupId, int memberCount, float height)
+    {
+        rows.push_back({ satIndex, groupId, memberCount, top, height });
+        top += height + spacing;
+    };
+    
+    // Without any groups the panel stays a flat list in slot order
+    if (!anyGrouped)
+    {
+        for (int index : members[0])
+            addRow(index, 0, 0, satelliteRowHeight);
+        return rows;
+    }
+    
+    // Named groups first, ungrouped tracks last
+    for (int n = 1; n <= MAX_SATELLITE_GROUPS + 1; ++n)
+    {
+        const int groupId = n % (MAX_SATELLITE_GROUPS + 1);
+        const auto& group = members[(size_t) groupId];
+        if (group.empty()) continue;
+        
+        addRow(-1, groupId, static_cast<int>(group.size()), headerRowHeight);
+        if (collapsedGroups[(size_t) groupId]) continue;
+        
+        for (int index : group)
+            addRow(index, groupId, 0, satelliteRowHeight);
+    }
+    
+    return rows;
+}
+
+void SimpleGainAudioProcessorEditor::drawMaskingHeatMap(juce::Graphics& g, juce::Rectangle<float> bounds)
+{
+    auto masking = processor.getMaskingSnapshot();
+    
+    std::vector<int> tracks;
+    for (int i = 0; i < MAX_SATELLITES; ++i)
+        if (masking.active[(size_t) i])
+            tracks.push_back(i);
+    
+    g.setFont(juce::FontOptions(10.0f).withStyle("Bold"));
+    g.setColour(theme.textDim);
+    g.drawText("MASKING", bounds.removeFromTop(14), juce::Justification::centred);
+    
+    if (tracks.size() < 2)
+    {
+        g.setFont(juce::FontOptions(10.0f));
+        g.drawText("Analysing...", bounds, juce::Justification::centred);
+        return;
+    }
+    
+    bounds = bounds.reduced(4, 2);
+    const float side = juce::jmin(bounds.getWidth(), bounds.getHeight());
+    auto grid = bounds.withSizeKeepingCentre(side, side);
+    const float cell = side / static_cast<float>(tracks.size());
+    
+    for (size_t row = 0; row < tracks.size(); ++row)
+    {
+        for (size_t col = 0; col < tracks.size(); ++col)
+        {
+            auto cellArea = juce::Rectangle<float>(grid.getX() + cell * col, grid.getY() + cell * row, cell, cell);
+            if (row == col)
+            {
+                g.setColour(theme.bgDark);
+            }
+            else
+            {
+                // Green (clean) -> yellow -> red (heavy masking)
+                const float severity = masking.getSeverity(tracks[row], tracks[col]);
+                g.setColour(severity < 0.5f ? theme.meterGreen.interpolatedWith(theme.meterYellow, severity * 2.0f)
+                                            : theme.meterYellow.interpolatedWith(theme.meterRed, (severity - 0.5f) * 2.0f));
+                g.setOpacity(0.25f + 0.75f * severity);
+            }
+            g.fillRect(cellArea.reduced(cell > 6.0f ? 0.5f : 0.0f));
+        }
+    }
+    
+    // Outline the selected track's row and column
+    for (size_t n = 0; n < tracks.size(); ++n)
+    {
+        if (tracks[n] != selectedSatellite)
+            continue;
+        
+        g.setColour(theme.accent);
+        g.drawRect(juce::Rectangle<float>(grid.getX(), grid.getY() + cell * n, side, cell), 1.0f);
+        g.drawRect(juce::Rectangle<float>(grid.getX() + cell * n, grid.getY(), cell, side), 1.0f);
+    }
+}
+
 void SimpleGainAudioProcessorEditor::drawCrestMeter(juce::Graphics& g, juce::Rectangle<float> bounds)
 {
     // Background panel
@@ -2866,6 +3053,37 @@ void SimpleGainAudioProcessorEditor::drawQuickIssues(juce::Graphics& g, juce::Re
     else
         issues.push_back({"Mono OK", theme.meterGreen});
     
+    // Multi-mic timing/polarity between phase-checked satellites
+    for (const auto& alignment : processor.getPhaseAlignments())
+    {
+        if (alignment.confidence < 0.5f)
+            continue;
+        
+        auto nameA = processor.getSatelliteInfo(alignment.trackA).channelName;
+        auto nameB = processor.getSatelliteInfo(alignment.trackB).channelName;
+        if (nameA.isEmpty()) nameA = "Sat " + juce::String(alignment.trackA + 1);
+        if (nameB.isEmpty()) nameB = "Sat " + juce::String(alignment.trackB + 1);
+        
+        if (alignment.polarityInverted)
+            issues.push_back({nameA + "/" + nameB + " polarity!", theme.meterRed});
+        else if (std::abs(alignment.offsetMs) >= 0.5f)
+            issues.push_back({nameA + "/" + nameB + " " + juce::String(alignment.offsetMs, 1) + " ms", theme.meterYellow});
+    }
+    
+    // Streamed tracks summed: the bus can clip even when every track looks fine.
+    // Only phase-checked tracks stream, so say how much of the bus was summed.
+    const auto bus = processor.getBusPrediction();
+    if (bus.valid && bus.numTracks >= 2)
+    {
+        const auto coverage = bus.numTracks < bus.numLiveTracks
+                                  ? " (" + juce::String(bus.numTracks) + "/" + juce::String(bus.numLiveTracks) + " tracks)"
+                                  : juce::String();
+        if (bus.peakDb > -1.0f)
+            issues.push_back({"Bus will clip!" + coverage, theme.meterRed});
+        else if (bus.peakDb > -3.0f)
+            issues.push_back({"Bus peaks hot" + coverage, theme.meterYellow});
+    }
+    
     // Check stereo width
     if (stereoWidth > 150)
         issues.push_back({"Very wide", theme.meterYellow});
@@ -2952,42 +3170,54 @@ void SimpleGainAudioProcessorEditor::mouseDown(const juce::MouseEvent& e)
     // Check if click is in satellite panel area (only when not in standalone mode)
     if (currentTab == 0 && !standaloneMode && satellitePanelBounds.contains(localPos))
     {
-        // Calculate which satellite row was clicked
-        auto panelArea = satellitePanelBounds;
-        panelArea.removeFromTop(22);  // Title
-        panelArea = panelArea.reduced(4, 2);
+        // Title bar: session diagnostics, which belong to no single track
+        if (localPos.y < satellitePanelBounds.getY() + 28)
+        {
+            showSessionDiagnosticsMenu(e.getScreenPosition());
+            return;
+        }
         
-        const float rowHeight = 28.0f;  // Match actual row height
-        int clickedRow = static_cast<int>((localPos.y - panelArea.getY()) / rowHeight);
+        // Same geometry as drawSatellitePanel: 28 px title, then rows inset by (6, 4)
+        auto panelArea = satellitePanelBounds;
+        panelArea.removeFromTop(28);
+        panelArea = panelArea.reduced(6, 4);
+        const float rowY = localPos.y - panelArea.getY();
         
-        // Find the actual satellite at this row
-        int visibleRow = 0;
-        for (int i = 0; i < MAX_SATELLITES; ++i)
+        for (const auto& panelRow : layoutSatellitePanelRows())
         {
-            auto info = processor.getSatelliteInfo(i);
-            if (!info.active) continue;
+            if (rowY < panelRow.top || rowY >= panelRow.top + panelRow.height)
+                continue;
             
-            if (visibleRow == clickedRow)
+            const bool popupClick = e.mods.isRightButtonDown() || e.mods.isPopupMenu() || e.mods.isCtrlDown();
+            
+            // Group header: right-click for group controls, left-click collapses/expands
+            if (panelRow.satIndex < 0)
             {
-                // Right-click - show context menu (check multiple conditions for reliability)
-                if (e.mods.isRightButtonDown() || e.mods.isPopupMenu() || e.mods.isCtrlDown())
-                {
-                    showSatelliteContextMenu(i, e.getScreenPosition());
-                    return;
-                }
+                if (popupClick && panelRow.groupId > 0)
+                    showGroupContextMenu(panelRow.groupId, e.getScreenPosition());
                 else
-                {
-                    // Left-click - select/deselect satellite
-                    selectedSatellite = (selectedSatellite == i) ? -1 : i;
-                    repaint();
-                    return;
-                }
+                    collapsedGroups[(size_t) panelRow.groupId] = !collapsedGroups[(size_t) panelRow.groupId];
+                repaint();
+                return;
             }
-            visibleRow++;
+            
+            const int i = panelRow.satIndex;
+            
+            // Right-click - show context menu (check multiple conditions for reliability)
+            if (popupClick)
+            {
+                showSatelliteContextMenu(i, e.getScreenPosition());
+                return;
+            }
+            
+            // Left-click - select/deselect satellite
+            selectedSatellite = (selectedSatellite == i) ? -1 : i;
+            repaint();
+            return;
         }
         
         // Clicked in panel but not on a satellite row - deselect
-        if (clickedRow >= 0)
+        if (rowY >= 0.0f)
         {
             selectedSatellite = -1;
             repaint();
@@ -3010,14 +3240,14 @@ void SimpleGainAudioProcessorEditor::mouseDrag(const juce::MouseEvent& e)
                 resizeStartBounds = candidateStartBounds;
                 dragStartPos = candidateStartPos;
                 isResizing = true;
-                DBG("Promoted candidate to RESIZE: " << resizedComponent->getName());
+                AR3S_LOG_DEBUG("Layout", "Promoted candidate to resize: {}", resizedComponent->getName());
             }
             else
             {
                 draggedComponent = candidateComponent;
                 dragStartPos = candidateStartPos;
                 componentStartBounds = candidateStartBounds;
-                DBG("Promoted candidate to DRAG: " << draggedComponent->getName());
+                AR3S_LOG_DEBUG("Layout", "Promoted candidate to drag: {}", draggedComponent->getName());
             }
 
             // Clear candidate state now that it's promoted
@@ -3127,7 +3357,7 @@ void SimpleGainAudioProcessorEditor::mouseUp(const juce::MouseEvent& e)
         saveLayoutToFile();
         layoutLoaded = true;
         layoutDirty = false;
-        DBG("Layout auto-saved after move/resize");
+        AR3S_LOG_DEBUG("Layout", "Layout auto-saved after move/resize");
     }
 }
 
@@ -3196,6 +3426,36 @@ void SimpleGainAudioProcessorEditor::showSatelliteContextMenu(int satIndex, juce
         processor.requestAiSuggestion(genreBox.getText(), sourceName, situationBox.getText());
     });
     
+    // Inter-track phase check (streams this track's audio to the master while on)
+    const bool phaseCheck = processor.isSatellitePhaseCheckEnabled(satIndex);
+    menu.addItem("Phase Check", true, phaseCheck, [this, satIndex, phaseCheck] {
+        processor.setSatellitePhaseCheck(satIndex, !phaseCheck);
+    });
+    
+    menu.addSeparator();
+    
+    // Joint gain staging across every satellite (per-source balance, bus headroom)
+    const float balanceTargetDb = static_cast<float>(targetDbSlider.getValue());
+    menu.addItem("Auto-Balance All Tracks", [this, balanceTargetDb] {
+        processor.autoGainAllSatellites(balanceTargetDb);
+    });
+    const bool continuousBalance = processor.isContinuousGainSolving();
+    menu.addItem("Continuous Auto-Balance", true, continuousBalance, [this, balanceTargetDb, continuousBalance] {
+        processor.setContinuousGainSolving(!continuousBalance, balanceTargetDb);
+    });
+    auto solverReport = processor.getGainSolverReport();
+    if (solverReport.valid)
+    {
+        menu.addItem("Bus: " + juce::String(solverReport.busLevelDb, 1) + " dB RMS, peak "
+                     + juce::String(solverReport.busPeakDb, 1) + " dB" + (solverReport.peakLimited ? " (peak limited)" : ""),
+                     false, false, nullptr);
+    }
+    
+    // This track's deadline incidents (the master's are under Diagnostics in the title bar)
+    if (info.overrunCount > 0 || info.nearMissCount > 0)
+        menu.addItem("Track overruns: " + juce::String(info.overrunCount) + " (" + juce::String(info.nearMissCount) + " near misses)",
+                     false, false, nullptr);
+    
     menu.addSeparator();
     
     // Release master control
@@ -3209,6 +3469,93 @@ void SimpleGainAudioProcessorEditor::showSatelliteContextMenu(int satIndex, juce
     menu.showMenuAsync(juce::PopupMenu::Options().withTargetScreenArea({screenPos.x, screenPos.y, 1, 1}));
 }
 
+void SimpleGainAudioProcessorEditor::showSessionDiagnosticsMenu(juce::Point<int> screenPos)
+{
+    juce::PopupMenu menu;
+    menu.addSectionHeader("Session Diagnostics");
+    menu.addSeparator();
+    
+    auto ipcStats = processor.getIpcStats();
+    if (ipcStats.latencySamples > 0)
+    {
+        menu.addItem("Link: p50 " + juce::String(ipcStats.latencyP50Ms, 2) + " ms, p99 "
+                     + juce::String(ipcStats.latencyP99Ms, 2) + " ms, sweep "
+                     + juce::String(ipcStats.sweepMicros, 0) + " us"
+                     + (ipcStats.commandsDropped > 0 ? ", " + juce::String(ipcStats.commandsDropped) + " dropped" : juce::String()),
+                     false, false, nullptr);
+    }
+    auto health = processor.getSessionHealth();
+    menu.addItem("Slots: " + juce::String(health.slotClaims) + " claims, " + juce::String(health.slotTakeovers)
+                 + " takeovers, " + juce::String(health.slotsReaped) + " reaped"
+                 + (health.residentMb > 0.0f ? ", RAM " + juce::String(health.residentMb, 0) + " MB" : juce::String())
+                 + (health.growthMbPerHour > 1.0f ? " (+" + juce::String(health.growthMbPerHour, 1) + " MB/h)" : juce::String()),
+                 false, false, nullptr);
+    const auto aiTiming = processor.getAiLatencyStats().describe();
+    if (aiTiming.isNotEmpty())
+        menu.addItem("AI (p50/p90): " + aiTiming, false, false, nullptr);
+    
+    // The master's latest deadline incident, with its stages
+    std::vector<OverrunIncident> incidents;
+    processor.getLoadMeter().getIncidents().getRecent(incidents, 1);
+    if (!incidents.empty())
+    {
+        const auto& last = incidents.front();
+        menu.addItem("Master " + juce::String(last.overrun ? "overrun" : "near miss") + " "
+                     + juce::Time(last.timeMs).formatted("%H:%M:%S") + ": "
+                     + juce::String(last.elapsedMicros / 1000.0f, 2) + "/" + juce::String(last.deadlineMicros / 1000.0f, 2)
+                     + " ms @" + juce::String(last.numSamples) + ", " + describeProcessingStages(last.stages),
+                     false, false, nullptr);
+    }
+   #if AR3S_ENABLE_TRACING
+    menu.addSeparator();
+    menu.addItem("Export Trace (all tracks)", [this] { processor.exportTraces(); });
+   #endif
+    
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetScreenArea({screenPos.x, screenPos.y, 1, 1}));
+}
+
+void SimpleGainAudioProcessorEditor::showGroupContextMenu(int groupId, juce::Point<int> screenPos)
+{
+    const auto group = processor.getGroupInfo(groupId);
+    
+    juce::PopupMenu menu;
+    menu.addSectionHeader(juce::String(getSatelliteGroupName(groupId)) + " Group");
+    menu.addSeparator();
+    
+    juce::PopupMenu gainMenu;
+    gainMenu.addItem("Current: " + juce::String(group.gainOffsetDb, 1) + " dB", false, false, nullptr);
+    gainMenu.addSeparator();
+    for (float offset : { 6.0f, 3.0f, 0.0f, -3.0f, -6.0f, -12.0f })
+        gainMenu.addItem((offset > 0 ? "+" : "") + juce::String(offset, 0) + " dB",
+                         [this, groupId, offset] { processor.setGroupGain(groupId, offset); });
+    menu.addSubMenu("Group Gain", gainMenu);
+    
+    juce::PopupMenu targetMenu;
+    targetMenu.addItem("Current: " + juce::String(group.targetOffsetDb, 1) + " dB", false, false, nullptr);
+    targetMenu.addSeparator();
+    for (float offset : { 6.0f, 3.0f, 0.0f, -3.0f, -6.0f })
+        targetMenu.addItem((offset > 0 ? "+" : "") + juce::String(offset, 0) + " dB",
+                           [this, groupId, offset] { processor.setGroupTarget(groupId, offset); });
+    menu.addSubMenu("Group Target Offset", targetMenu);
+    
+    juce::PopupMenu ceilingMenu;
+    ceilingMenu.addItem("Current: " + juce::String(group.ceilingOffsetDb, 1) + " dB", false, false, nullptr);
+    ceilingMenu.addSeparator();
+    for (float offset : { 0.0f, -1.0f, -3.0f, -6.0f })
+        ceilingMenu.addItem(juce::String(offset, 0) + " dB",
+                            [this, groupId, offset] { processor.setGroupCeiling(groupId, offset); });
+    menu.addSubMenu("Group Ceiling Offset", ceilingMenu);
+    
+    menu.addSeparator();
+    menu.addItem("Reset Group", [this, groupId] {
+        processor.setGroupGain(groupId, 0.0f);
+        processor.setGroupTarget(groupId, 0.0f);
+        processor.setGroupCeiling(groupId, 0.0f);
+    });
+    
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetScreenArea({screenPos.x, screenPos.y, 1, 1}));
+}
+
 void SimpleGainAudioProcessorEditor::setSatelliteGain(int satIndex, float gainDb)
 {
     SimpleGainAudioProcessor::SatelliteControl ctrl;
@@ -3262,6 +3609,7 @@ void SimpleGainAudioProcessorEditor::setSatelliteRider(int satIndex, float amoun
 
 void SimpleGainAudioProcessorEditor::paint(juce::Graphics& g)
 {
+    AR3S_TRACE_SCOPE("editor paint");
     // Background
     juce::ColourGradient bg(theme.bgDark, 0, 0, theme.bgDark.darker(0.25f), 0, static_cast<float>(getHeight()), false);
     g.setGradientFill(bg);
@@ -3424,6 +3772,31 @@ void SimpleGainAudioProcessorEditor::timerCallback()
     aiNotes.setText(notes, false);
     aiStatusLabel.setText("Status: " + processor.getAiStatus(), juce::dontSendNotification);
 
+    // Streamed chat replies: append the text as it arrives, whatever tab is showing
+    AiStreamChunk chunk;
+    while (processor.popChatStreamChunk(chunk))
+    {
+        if (chunk.kind == AiStreamChunk::Kind::Begin)
+        {
+            auto currentText = chatHistory.getText();
+            if (currentText.contains("ARES: Thinking...\n"))
+            {
+                chatHistory.setText(currentText.replace("ARES: Thinking...\n", "ARES: "));
+            }
+            else
+            {
+                chatHistory.moveCaretToEnd();
+                chatHistory.insertTextAtCaret("\nARES: ");
+            }
+        }
+        else
+        {
+            chatHistory.moveCaretToEnd();
+            chatHistory.insertTextAtCaret(chunk.kind == AiStreamChunk::Kind::End ? juce::String("\n") : chunk.getText());
+        }
+    }
+    processor.noteAiResultShown();
+
     // Update chat with AI response (using separate chat response tracking)
     if (currentTab == 2)
     {
@@ -3546,7 +3919,7 @@ void SimpleGainAudioProcessorEditor::saveLayoutToFile()
     
     if (root->writeTo(layoutFile))
     {
-        DBG("Layout saved to: " + layoutFile.getFullPathName());
+        AR3S_LOG_DEBUG("Layout", "Layout saved to {}", layoutFile.getFileName());
     }
 }
 
@@ -3601,7 +3974,7 @@ void SimpleGainAudioProcessorEditor::loadLayoutFromFile()
         }
     }
     
-    DBG("Layout loaded from: " + layoutFile.getFullPathName());
+    AR3S_LOG_DEBUG("Layout", "Layout loaded from {}", layoutFile.getFileName());
     // restore auto-fit/edit mode if present
     autoFitMode = root->getBoolAttribute("autoFit", autoFitMode);
     editMode = root->getBoolAttribute("editMode", editMode);
@@ -3771,7 +4144,6 @@ void SimpleGainAudioProcessorEditor::handleSatellitePanelMouse(const juce::Mouse
 // New helper that performs the same logic as startComponentDrag but accepts coordinates and modifier keys
 void SimpleGainAudioProcessorEditor::startComponentDragAt(juce::Component* component, juce::Point<int> pos, juce::ModifierKeys mods)
 {
-    DBG("startComponentDragAt called for component");
     if (!component) return;
 
     // If component supports locking, respect it (no drag/resize when locked)
@@ -3779,7 +4151,7 @@ void SimpleGainAudioProcessorEditor::startComponentDragAt(juce::Component* compo
     {
         if (m->isLocked())
         {
-            DBG("Component is locked, ignoring drag/resize request");
+            AR3S_LOG_DEBUG("Layout", "Component is locked, ignoring drag/resize request");
             return;
         }
     }
@@ -3787,7 +4159,7 @@ void SimpleGainAudioProcessorEditor::startComponentDragAt(juce::Component* compo
     // If Auto-fit mode is active and not in edit mode, disallow manual drag/resize to prevent layout conflicts
     if (autoFitMode && !editMode)
     {
-        DBG("Auto-fit active and edit mode off — ignoring manual drag/resize request");
+        AR3S_LOG_DEBUG("Layout", "Auto-fit active and edit mode off, ignoring manual drag/resize request");
         return;
     }
 
@@ -3796,7 +4168,7 @@ void SimpleGainAudioProcessorEditor::startComponentDragAt(juce::Component* compo
 
     if (realMods.isCommandDown() || realMods.isCtrlDown())
     {
-        DBG("Starting drag operation (modifier)");
+        AR3S_LOG_DEBUG("Layout", "Starting drag operation (modifier)");
         draggedComponent = component;
         dragStartPos = pos;
         componentStartBounds = component->getBounds();
@@ -3813,7 +4185,7 @@ void SimpleGainAudioProcessorEditor::startComponentDragAt(juce::Component* compo
         juce::Rectangle<int> resizeHandle(bounds.getRight() - 16, bounds.getBottom() - 16, 16, 16);
         if (resizeHandle.contains(pos))
         {
-            DBG("Starting resize operation (modifier)");
+            AR3S_LOG_DEBUG("Layout", "Starting resize operation (modifier)");
             resizedComponent = component;
             resizeStartBounds = bounds;
             dragStartPos = pos; // Set drag start pos for resize delta calculation
@@ -3832,7 +4204,7 @@ void SimpleGainAudioProcessorEditor::startComponentDragAt(juce::Component* compo
     auto bounds = component->getBounds();
     juce::Rectangle<int> resizeHandle(bounds.getRight() - 16, bounds.getBottom() - 16, 16, 16);
     candidateIsResize = resizeHandle.contains(pos);
-    DBG("Candidate registered: " << component->getName() << " at " << candidateStartPos.getX() << "," << candidateStartPos.getY() << (candidateIsResize?" (resize)":" (drag)"));
+    AR3S_LOG_DEBUG("Layout", "Candidate registered: {} at {},{} ({})", component->getName(), candidateStartPos.getX(), candidateStartPos.getY(), candidateIsResize ? "resize" : "drag");
     return;
 }
 
@@ -3846,8 +4218,7 @@ void SimpleGainAudioProcessorEditor::startComponentDrag(juce::Component* compone
 
 juce::File SimpleGainAudioProcessorEditor::getLayoutFile() const
 {
-    auto userAppData = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory);
-    auto aresDir = userAppData.getChildFile("ARES");
+    auto aresDir = getAresDataDirectory();
     aresDir.createDirectory();
     return aresDir.getChildFile("ar3s_layout.xml");
 }
@@ -29,6 +29,19 @@ private:
     void drawMeter(juce::Graphics& g, juce::Rectangle<float> bounds);
     void drawPhaseMeter(juce::Graphics& g, juce::Rectangle<float> bounds);
     void drawSatellitePanel(juce::Graphics& g, juce::Rectangle<float> bounds);
+    void drawMaskingHeatMap(juce::Graphics& g, juce::Rectangle<float> bounds);
+    
+    // Rows of the satellite panel: group headers (satIndex -1) and satellites
+    struct SatellitePanelRow
+    {
+        int satIndex = -1;
+        int groupId = 0;
+        int memberCount = 0;   // Headers only
+        float top = 0.0f;      // Relative to the first row
+        float height = 0.0f;
+    };
+    std::vector<SatellitePanelRow> layoutSatellitePanelRows() const;
+    void showGroupContextMenu(int groupId, juce::Point<int> screenPos);
     void showMainView();
     void showSettingsView();
     void showChatView();
@@ -392,6 +405,7 @@ private:
     juce::Label aiProviderLabel, modelLabel, apiKeyLabel, themeLabel, knobStyleLabel;
     juce::Label accentColorLabel, bgColorLabel;
     juce::TextEditor apiKeyEditor;
+    juce::ToggleButton raceLocalToggle { "Race local model" };  // Cloud providers only
     juce::TextButton refreshModelsButton, saveSettingsBtn, saveLayoutBtn, loadLayoutBtn;
     juce::Slider accentHueSlider, bgBrightnessSlider;
     int lastModelsVersion = -1;
@@ -466,8 +480,11 @@ private:
     
     // Satellite control components
     int selectedSatellite = -1;  // -1 = none selected
+    std::array<bool, MAX_SATELLITE_GROUPS + 1> collapsedGroups {};  // Satellite panel group headers
+    std::vector<MeterHistoryPoint> satelliteHistoryScratch;  // Reused by the sparklines in drawSatellitePanel
     void handleSatelliteClick(int index);
     void showSatelliteContextMenu(int satIndex, juce::Point<int> screenPos);
+    void showSessionDiagnosticsMenu(juce::Point<int> screenPos);  // Link, slots, AI timing, master incidents
     void setSatelliteGain(int satIndex, float gainDb);
     void setSatelliteTarget(int satIndex, float targetDb);
     void setSatelliteCeiling(int satIndex, float ceilingDb);
@@ -2,6 +2,11 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include <cmath>
+#include <cstdio>
+
+#if JUCE_MAC
+ #include <mach/mach.h>
+#endif
 
 // Returns a JSON string with all satellite/track data for AI context
 juce::String SimpleGainAudioProcessor::getSatellitesJsonContext() const
@@ -17,10 +22,21 @@ juce::String SimpleGainAudioProcessor::getSatellitesJsonContext() const
             sat->setProperty("index", i);
             sat->setProperty("name", info.channelName.isEmpty() ? juce::String("Track ") + juce::String(i+1) : info.channelName);
             sat->setProperty("sourceType", info.sourceType);
+            if (info.groupId > 0)
+                sat->setProperty("group", juce::String(getSatelliteGroupName(info.groupId)));
             sat->setProperty("rmsDb", info.rmsDb);
             sat->setProperty("peakDb", info.peakDb);
             sat->setProperty("crestDb", info.crestDb);
+            if (info.shortTermLufs > -70.0f)
+            {
+                sat->setProperty("momentaryLufs", info.momentaryLufs);
+                sat->setProperty("shortTermLufs", info.shortTermLufs);
+                sat->setProperty("integratedLufs", info.integratedLufs);
+                sat->setProperty("truePeakDb", info.truePeakDb);
+            }
             sat->setProperty("phaseCorrelation", info.phaseCorrelation);
+            sat->setProperty("cpuLoadPercent", info.cpuAverageLoad * 100.0f);
+            sat->setProperty("overruns", static_cast<int>(info.overrunCount));
             sat->setProperty("currentGain", info.currentGain);
             sat->setProperty("gainDb", info.gainDb);
             sat->setProperty("targetDb", info.targetDb);
@@ -28,10 +44,45 @@ juce::String SimpleGainAudioProcessor::getSatellitesJsonContext() const
             sat->setProperty("autoEnabled", info.autoEnabled);
             sat->setProperty("riderAmount", info.riderAmount);
             sat->setProperty("controlledByMaster", info.controlledByMaster);
+            auto trend = getSatelliteHistoryStats(i, 30);
+            if (trend.valid)
+            {
+                sat->setProperty("rms30sAvgDb", trend.avgRmsDb);
+                sat->setProperty("rms30sMinDb", trend.minRmsDb);
+                sat->setProperty("rms30sMaxDb", trend.maxRmsDb);
+                sat->setProperty("peak30sMaxDb", trend.maxPeakDb);
+            }
             satellitesArray.add(juce::var(sat.get()));
         }
     }
     root->setProperty("satellites", juce::var(satellitesArray));
+    
+    juce::Array<juce::var> maskingArray;
+    for (const auto& pair : getTopMaskingPairs(10))
+    {
+        juce::DynamicObject::Ptr entry = new juce::DynamicObject();
+        entry->setProperty("trackA", pair.trackA);
+        entry->setProperty("trackB", pair.trackB);
+        entry->setProperty("severity", pair.severity);
+        if (pair.dominantBand >= 0)
+            entry->setProperty("dominantBandHz", getAnalysisBandCentreHz(pair.dominantBand));
+        maskingArray.add(juce::var(entry.get()));
+    }
+    root->setProperty("masking", juce::var(maskingArray));
+    
+    juce::Array<juce::var> phaseArray;
+    for (const auto& alignment : getPhaseAlignments())
+    {
+        juce::DynamicObject::Ptr entry = new juce::DynamicObject();
+        entry->setProperty("trackA", alignment.trackA);
+        entry->setProperty("trackB", alignment.trackB);
+        entry->setProperty("offsetSamples", alignment.offsetSamples);
+        entry->setProperty("offsetMs", alignment.offsetMs);
+        entry->setProperty("polarityInverted", alignment.polarityInverted);
+        entry->setProperty("confidence", alignment.confidence);
+        phaseArray.add(juce::var(entry.get()));
+    }
+    root->setProperty("phaseAlignment", juce::var(phaseArray));
     return juce::JSON::toString(juce::var(root.get()));
 }
 
@@ -47,302 +98,942 @@ namespace
         return 20.0f * std::log10(std::max(value, 1.0e-9f));
     }
     
+    // Satellite source types, named for AI context
+    juce::String getSatelliteSourceName(int sourceType)
+    {
+        const char* sourceNames[] = { "Vocals", "Background Vocals", "Kick", "Snare", "Hi-Hat",
+                                      "Drums", "Bass", "Electric Guitar", "Acoustic Guitar",
+                                      "Keys/Piano", "Synth", "Strings", "Other" };
+        return sourceType >= 0 && sourceType < 13 ? juce::String(sourceNames[sourceType]) : juce::String();
+    }
+    
+    // Where a provider's model list comes from (Ollama, OpenAI, OpenRouter; the
+    // others have fixed lists)
+    struct ModelCatalogue
+    {
+        juce::String providerName;
+        juce::String cacheName;    // ARES/models/<cacheName>.xml
+        juce::String url;
+        juce::String headers;
+        const char* field = "id";  // Per catalogue entry
+        int64_t ttlMs = 0;         // Cached list is used without asking while younger than this
+        uint64_t sourceKey = 0;    // Endpoint + key: another account may see other models
+    };
+
+    // Cloud API base URL. OPENAI_BASE_URL, ANTHROPIC_BASE_URL, OPENROUTER_BASE_URL and
+    // MINIMAX_BASE_URL point a provider at a proxy or a local stand-in server (as
+    // OLLAMA_API_URL does for Ollama), e.g. to time the AI path offline.
+    juce::String getCloudBaseUrl(SimpleGainAudioProcessor::AiProvider provider)
+    {
+        const char* envName = "OPENAI_BASE_URL";
+        juce::String defaultUrl = "https://api.openai.com/v1";
+        if (provider == SimpleGainAudioProcessor::AiProvider::Anthropic)
+        {
+            envName = "ANTHROPIC_BASE_URL";
+            defaultUrl = "https://api.anthropic.com";
+        }
+        else if (provider == SimpleGainAudioProcessor::AiProvider::OpenRouter)
+        {
+            envName = "OPENROUTER_BASE_URL";
+            defaultUrl = "https://openrouter.ai/api/v1";
+        }
+        else if (provider == SimpleGainAudioProcessor::AiProvider::MiniMax)
+        {
+            envName = "MINIMAX_BASE_URL";
+            defaultUrl = "https://api.minimax.chat/v1";
+        }
+
+        const char* envUrl = std::getenv(envName);
+        if (envUrl == nullptr || envUrl[0] == '\0')
+            return defaultUrl;
+        return juce::String(envUrl).trimCharactersAtEnd("/");
+    }
+
+    ModelCatalogue getModelCatalogue(SimpleGainAudioProcessor::AiProvider provider, const juce::String& apiKey)
+    {
+        ModelCatalogue catalogue;
+        if (provider == SimpleGainAudioProcessor::AiProvider::Ollama)
+        {
+            // Local (or OLLAMA_API_URL) tags change whenever a model is pulled, and asking is cheap
+            const char* envUrl = std::getenv("OLLAMA_API_URL");
+            const char* envKey = std::getenv("OLLAMA_API_KEY");
+            catalogue.providerName = "Ollama";
+            catalogue.cacheName = "ollama";
+            catalogue.url = (envUrl ? juce::String(envUrl) : juce::String("http://127.0.0.1:11434")) + "/api/tags";
+            if (envKey != nullptr && envKey[0] != '\0')
+                catalogue.headers = "Authorization: Bearer " + juce::String(envKey);
+            catalogue.field = "name";
+        }
+        else if (provider == SimpleGainAudioProcessor::AiProvider::OpenAI)
+        {
+            catalogue.providerName = "OpenAI";
+            catalogue.cacheName = "openai";
+            catalogue.url = getCloudBaseUrl(provider) + "/models";
+            catalogue.headers = "Authorization: Bearer " + apiKey;
+            catalogue.ttlMs = 24LL * 60 * 60 * 1000;
+        }
+        else if (provider == SimpleGainAudioProcessor::AiProvider::OpenRouter)
+        {
+            catalogue.providerName = "OpenRouter";
+            catalogue.cacheName = "openrouter";
+            catalogue.url = getCloudBaseUrl(provider) + "/models";
+            catalogue.headers = "Authorization: Bearer " + apiKey;
+            catalogue.ttlMs = 24LL * 60 * 60 * 1000;
+        }
+        catalogue.sourceKey = static_cast<uint64_t>((catalogue.url + "|" + catalogue.headers).hashCode64());
+        return catalogue;
+    }
+
+    juce::StringArray getFallbackModels(SimpleGainAudioProcessor::AiProvider provider)
+    {
+        if (provider == SimpleGainAudioProcessor::AiProvider::OpenAI)
+            return { "gpt-4o", "gpt-4o-mini", "gpt-4-turbo", "gpt-3.5-turbo" };
+        if (provider == SimpleGainAudioProcessor::AiProvider::OpenRouter)
+            return { "openai/gpt-4o", "anthropic/claude-sonnet-4-20250514", "anthropic/claude-3.5-sonnet",
+                     "google/gemini-pro-1.5", "meta-llama/llama-3.1-70b-instruct" };
+        return { "llama3" };
+    }
+
+    // The JSON object suggestion prompts ask for (what applyAiResponseText accepts as structured)
+    bool isStructuredSuggestion(const juce::String& text)
+    {
+        const auto parsed = juce::JSON::parse(text);
+        auto* obj = parsed.getDynamicObject();
+        if (obj == nullptr)
+            return false;
+        const auto gainVar = obj->getProperty("gain_db");
+        const auto targetVar = obj->getProperty("target_db");
+        return gainVar.isDouble() || gainVar.isInt() || targetVar.isDouble() || targetVar.isInt();
+    }
+
+    // Catalogue entries worth offering in the models box
+    bool acceptModelId(SimpleGainAudioProcessor::AiProvider provider, const juce::String& id)
+    {
+        if (provider == SimpleGainAudioProcessor::AiProvider::OpenAI)
+            return id.startsWith("gpt-");
+        if (provider == SimpleGainAudioProcessor::AiProvider::OpenRouter)
+            return id.contains("gpt-4") || id.contains("claude") || id.contains("gemini")
+                || id.contains("llama") || id.contains("mixtral") || id.contains("mistral");
+        return true;
+    }
+
+    // Sent once at the start of every chat request; the per-turn context rides in the user turns
+    juce::String getChatSystemPrompt()
+    {
+        return "You are ARES, an expert audio engineer, mixer, producer, and mastering engineer. "
+               "You are a comprehensive mixing assistant that helps with ALL aspects of music production:\n"
+               "- Gain staging and level optimization\n"
+               "- Plugin recommendations (EQ, compression, reverb, delay, saturation, etc.)\n"
+               "- Specific plugin settings and parameters\n"
+               "- Signal chain order and routing\n"
+               "- Mixing techniques for each instrument/element\n"
+               "- Frequency balance and EQ curves\n"
+               "- Compression ratios, attack, release for different sources\n"
+               "- Reverb and delay settings\n"
+               "- Stereo imaging and panning\n"
+               "- Mastering chain suggestions\n"
+               "- Reference track analysis\n"
+               "- Genre-specific production techniques\n\n"
+               "Each user message starts with an [INTERNAL CONTEXT] block describing the session at that moment. "
+               "Track lines marked chg=0 or left out are unchanged since an earlier message. "
+               "Answer directly and concisely. Only mention the user's levels/settings if directly relevant to their question. "
+               "Don't recite back all the context data - just use it to give informed answers.";
+    }
+    
     juce::File getSettingsFile()
     {
-        return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
-            .getChildFile("ARES")
-            .getChildFile("settings.xml");
+        return getAresDataDirectory().getChildFile("settings.xml");
+    }
+    
+    // Resident set size of this process, or 0 where it isn't available
+    int64_t getResidentMemoryBytes()
+    {
+       #if JUCE_MAC
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+            return static_cast<int64_t>(info.resident_size);
+        return 0;
+       #elif JUCE_LINUX
+        long totalPages = 0, residentPages = 0;
+        if (auto* statm = std::fopen("/proc/self/statm", "r"))
+        {
+            if (std::fscanf(statm, "%ld %ld", &totalPages, &residentPages) != 2)
+                residentPages = 0;
+            std::fclose(statm);
+        }
+        return static_cast<int64_t>(residentPages) * static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+       #else
+        return 0;
+       #endif
     }
 }
 
+// Runs AI requests on a small worker pool. Requests wait in a bounded queue and
+// are taken in priority order (chat, then suggestions, then model lists), one at
+// a time per kind so chat replies stream in order. Duplicate requests coalesce,
+// a newer suggestion supersedes the one in flight, and every request has a
+// deadline. Cancelling aborts the request's connection, so a slow provider never
+// holds a worker (or the UI) past its deadline. The AiClient thread itself is the
+// deadline watchdog.
 class SimpleGainAudioProcessor::AiClient : public juce::Thread
 {
 public:
+    static constexpr int NUM_WORKERS = 3;  // A suggestion race takes two
+    static constexpr int MAX_QUEUED = 16;
+    static constexpr const char* ollamaKeepAlive = "30m";  // How long Ollama keeps the model loaded after a request
+
     explicit AiClient(SimpleGainAudioProcessor& owner)
         : juce::Thread("AiClient"), processor(owner)
     {
-        startThread();
+        for (int i = 0; i < NUM_WORKERS; ++i)
+            workers.add(new Worker(*this))->startThread();
+        startThread(juce::Thread::Priority::low);
     }
 
     ~AiClient() override
     {
         signalThreadShouldExit();
-        requestEvent.signal();
+        for (auto* worker : workers)
+            worker->signalThreadShouldExit();
+
+        cancelAll();  // Aborts open connections so the workers exit promptly
+
+        for (auto* worker : workers)
+        {
+            worker->notify();
+            worker->waitForThreadToExit(2000);
+        }
+        notify();
         waitForThreadToExit(2000);
     }
 
-    void request(const juce::String& promptToUse, bool isChatMode = false)
+    // Returns an id for cancel(), or 0 if the queue is full.
+    // A non-zero cacheKey stores a structured suggestion reply in the response cache.
+    uint64_t requestSuggestion(const juce::String& promptToUse, uint64_t cacheKey = 0)
+    {
+        if (const auto adoptedId = adoptSpeculative(cacheKey))
+            return adoptedId;
+        return enqueue(Job::Kind::Suggestion, promptToUse, cacheKey);
+    }
+
+    // A suggestion nobody asked for yet, at the lowest priority. The reply only
+    // goes into the response cache, unless the same suggestion is requested
+    // while it runs; then it is shown like any other.
+    uint64_t requestSpeculativeSuggestion(const juce::String& promptToUse, uint64_t cacheKey)
+    {
+        return enqueue(Job::Kind::Speculative, promptToUse, cacheKey);
+    }
+
+    void cancelSpeculative()
+    {
+        cancelWhere([](const Job& job) { return job.kind == Job::Kind::Speculative && ! job.adopted; },
+                    Job::CancelReason::Superseded);
+    }
+
+    // Race mode: the same suggestion goes to the local Ollama model and to the cloud
+    // provider, and the first structured reply wins. The racer that is usually
+    // faster starts at once; the other is hedged, starting only once the first is
+    // slower than its average. A racer that keeps failing sits out for a while.
+    uint64_t requestSuggestionRace(const juce::String& promptToUse, uint64_t cacheKey,
+                                   SimpleGainAudioProcessor::AiProvider cloudProvider,
+                                   const juce::String& cloudModel, const juce::String& localModel)
+    {
+        if (const auto adoptedId = adoptSpeculative(cacheKey))
+            return adoptedId;
+
+        const auto localProvider = SimpleGainAudioProcessor::AiProvider::Ollama;
+        const auto now = juce::Time::getMillisecondCounterHiRes();
+        const bool localUsable = isProviderUsable(localProvider, now);
+        const bool cloudUsable = isProviderUsable(cloudProvider, now);
+        if (! localUsable || ! cloudUsable)
+        {
+            // Only one contender left: a plain request, pinned to it
+            const bool useLocal = localUsable && ! cloudUsable;
+            return enqueue(Job::Kind::Suggestion, promptToUse, cacheKey, 0,
+                           [&](Job& job) { pinProvider(job, useLocal ? localProvider : cloudProvider,
+                                                       useLocal ? localModel : cloudModel); });
+        }
+
+        const auto race = std::make_shared<Job::Race>();
+        const bool localFirst = getAverageLatencyMs(localProvider) <= getAverageLatencyMs(cloudProvider);
+        const auto hedgeDelayMs = getHedgeDelayMs(localFirst ? localProvider : cloudProvider);
+
+        bool started = false;
+        const auto firstId = enqueue(Job::Kind::Suggestion, promptToUse, cacheKey, 0, [&](Job& job)
+        {
+            started = true;
+            job.race = race;
+            pinProvider(job, localFirst ? localProvider : cloudProvider, localFirst ? localModel : cloudModel);
+        });
+        if (! started)
+            return firstId;  // Already being asked (or the queue is full)
+
+        const auto secondId = enqueue(Job::Kind::Suggestion, promptToUse, cacheKey, 0, [&](Job& job)
+        {
+            job.race = race;
+            job.notBeforeMs = now + hedgeDelayMs;
+            pinProvider(job, localFirst ? cloudProvider : localProvider, localFirst ? cloudModel : localModel);
+        }, false);
+        if (secondId == 0)
+            race->pending = 1;  // Queue full: the first runs alone
+        return firstId;
+    }
+
+    // Sends a turn begun in processor.chatConversation, with the turns before it
+    uint64_t requestChat(uint64_t turnId)
     {
-        const juce::ScopedLock lock(requestLock);
-        pendingPrompt = promptToUse;
-        pendingIsChatMode = isChatMode;
-        hasRequest = true;
-        requestEvent.signal();
+        return enqueue(Job::Kind::Chat, {}, 0, turnId);
     }
 
-    void requestModelList()
+    uint64_t requestModelList()
     {
-        const juce::ScopedLock lock(requestLock);
-        wantsModelList = true;
-        requestEvent.signal();
+        return enqueue(Job::Kind::ModelList, {}, 0);
     }
 
+    // Loads the selected model ahead of the first real request (see warmUpProvider)
+    uint64_t requestWarmUp()
+    {
+        return enqueue(Job::Kind::WarmUp, {}, 0);
+    }
+
+    void cancel(uint64_t requestId)
+    {
+        cancelWhere([requestId](const Job& job) { return job.id == requestId; });
+    }
+
+    void cancelAll()
+    {
+        cancelWhere([](const Job&) { return true; });
+    }
+
+    // Deadline watchdog
     void run() override
     {
+        AR3S_TRACE_THREAD_NAME("ai scheduler");
         while (! threadShouldExit())
         {
-            requestEvent.wait(2000);
-            if (threadShouldExit())
-                break;
+            wait(250);
 
-            juce::String prompt;
-            bool fetchModels = false;
-            bool isChatMode = false;
+            std::vector<std::shared_ptr<Job>> expired;
+            bool hedgeDue = false;
             {
-                const juce::ScopedLock lock(requestLock);
-                if (wantsModelList)
+                const juce::ScopedLock lock(queueLock);
+                const auto now = juce::Time::getMillisecondCounterHiRes();
+                for (auto& job : running)
+                    if (now > job->deadlineMs && ! job->isCancelled())
+                        job->cancel(Job::CancelReason::TimedOut);
+
+                for (auto it = queued.begin(); it != queued.end();)
                 {
-                    fetchModels = true;
-                    wantsModelList = false;
+                    if (now > (*it)->deadlineMs)
+                    {
+                        (*it)->cancel(Job::CancelReason::TimedOut);
+                        expired.push_back(*it);
+                        it = queued.erase(it);
+                    }
+                    else
+                    {
+                        // A hedged racer whose delay ran out
+                        if ((*it)->notBeforeMs > 0.0 && (*it)->notBeforeMs <= now)
+                        {
+                            (*it)->notBeforeMs = 0.0;
+                            hedgeDue = true;
+                        }
+                        ++it;
+                    }
                 }
-                if (! hasRequest && ! fetchModels)
-                    continue;
-                prompt = pendingPrompt;
-                isChatMode = pendingIsChatMode;
-                hasRequest = false;
             }
 
-            auto provider = processor.getAiProvider();
-            auto apiKey = processor.getApiKey();
-            auto model = processor.getSelectedModel();
+            if (hedgeDue)
+                wakeWorkers();
 
-            if (fetchModels)
-            {
-                fetchModelsForProvider(provider, apiKey);
-                if (prompt.isEmpty())
-                    continue;
-            }
+            for (auto& job : expired)
+                dropQueued(*job);
+        }
+    }
 
-            if (! prompt.isEmpty())
+private:
+    // One queued or running request. cancel() may be called from any thread and
+    // aborts the job's connection if one is open.
+    struct Job
+    {
+        enum class Kind { Chat = 0, Suggestion, ModelList, WarmUp, Speculative };  // Also the priority order
+        enum class CancelReason { None, Cancelled, Superseded, TimedOut };
+
+        uint64_t id = 0;
+        Kind kind = Kind::Chat;
+        juce::String prompt;
+        uint64_t cacheKey = 0;                    // AiResponseCache key, 0 = don't cache
+        uint64_t turnId = 0;                      // AiConversation turn (chat)
+        double deadlineMs = 0.0;                  // Millisecond counter
+        double notBeforeMs = 0.0;                 // Hedged racer: not started before this
+        double startedMs = 0.0;
+        double connectedMs = 0.0;                 // Response headers in
+        double firstTextMs = 0.0;
+        double replyMs = 0.0;                     // Time to a structured suggestion, 0 = none
+        std::atomic<bool> streamStarted { false };  // Chat text reached the editor
+        std::atomic<bool> adopted { false };        // Speculative, then asked for: reply is shown
+
+        // Provider and model, fixed at enqueue for racers, else read when the job starts
+        bool providerPinned = false;
+        SimpleGainAudioProcessor::AiProvider provider = SimpleGainAudioProcessor::AiProvider::Ollama;
+        juce::String model;
+
+        // Shared by the two jobs of a suggestion race
+        struct Race
+        {
+            std::atomic<bool> decided { false };
+            std::atomic<int> pending { 2 };
+            juce::CriticalSection fallbackLock;
+            juce::String fallbackText;  // An unstructured reply, shown if neither racer wins
+        };
+        std::shared_ptr<Race> race;
+        bool wonRace = false;
+
+        bool isCancelled() const { return cancelReason.load() != CancelReason::None; }
+        CancelReason getCancelReason() const { return cancelReason.load(); }
+
+        void cancel(CancelReason reason)
+        {
+            const juce::ScopedLock lock(streamLock);
+            auto expected = CancelReason::None;
+            cancelReason.compare_exchange_strong(expected, reason);
+            if (stream != nullptr)
+                stream->cancel();
+        }
+
+        // Connects on the calling worker. The job owns the stream (until closeStream)
+        // so that cancel() can abort it mid-connect or mid-read.
+        juce::WebInputStream* openStream(const juce::URL& url, bool usePost, const juce::String& headers,
+                                         int connectionTimeoutMs, int& statusCode)
+        {
+            juce::WebInputStream* connection = nullptr;
             {
-                sendRequestToProvider(provider, apiKey, model, prompt, isChatMode);
+                const juce::ScopedLock lock(streamLock);
+                if (isCancelled())
+                    return nullptr;
+                stream = std::make_unique<juce::WebInputStream>(url, usePost);
+                stream->withExtraHeaders(headers).withConnectionTimeout(connectionTimeoutMs);
+                connection = stream.get();
             }
+
+            const bool connected = connection->connect(nullptr);
+            statusCode = connection->getStatusCode();
+            connectedMs = juce::Time::getMillisecondCounterHiRes();
+            return connected && ! connection->isError() && ! isCancelled() ? connection : nullptr;
         }
-    }
 
-private:
-    void fetchModelsForProvider(SimpleGainAudioProcessor::AiProvider provider, const juce::String& apiKey)
+        void closeStream()
+        {
+            const juce::ScopedLock lock(streamLock);
+            stream.reset();
+        }
+
+    private:
+        std::atomic<CancelReason> cancelReason { CancelReason::None };
+        juce::CriticalSection streamLock;
+        std::unique_ptr<juce::WebInputStream> stream;
+    };
+
+    class Worker : public juce::Thread
     {
-        processor.setAiStatusMessage("Fetching models...");
+    public:
+        explicit Worker(AiClient& owner) : juce::Thread("AiClient worker"), client(owner) {}
 
-        if (provider == SimpleGainAudioProcessor::AiProvider::Ollama)
+        void run() override
         {
-            // Support local Ollama (default) and Ollama cloud via OLLAMA_API_URL
-            const char* envUrl = std::getenv("OLLAMA_API_URL");
-            juce::String baseUrl = envUrl ? juce::String(envUrl) : "http://127.0.0.1:11434";
-            juce::URL tagsUrl(baseUrl + "/api/tags");
+            AR3S_TRACE_THREAD_NAME("ai worker");
+            while (! threadShouldExit())
+            {
+                auto job = client.takeNextJob();
+                if (job == nullptr)
+                {
+                    wait(500);
+                    continue;
+                }
+                client.runJob(*job);
+                client.finishJob(job);
+            }
+        }
 
-            int statusCode = 0;
-            juce::String headers;
-            const char* envKey = std::getenv("OLLAMA_API_KEY");
-            if (envKey != nullptr && envKey[0] != '\0')
-                headers = "Authorization: Bearer " + juce::String(envKey);
+    private:
+        AiClient& client;
+    };
 
-            auto options = juce::URL::InputStreamOptions(juce::URL::ParameterHandling::inAddress)
-                .withExtraHeaders(headers)
-                .withConnectionTimeoutMs(10000)
-                .withStatusCode(&statusCode);
+    static double getDeadlineMs(Job::Kind kind)
+    {
+        switch (kind)
+        {
+            case Job::Kind::Chat:       return 120000.0;  // Local models can take a while to load
+            case Job::Kind::Suggestion: return 90000.0;
+            case Job::Kind::ModelList:  return 20000.0;
+            case Job::Kind::WarmUp:     return 120000.0;  // A cold model load on a slow disk
+            case Job::Kind::Speculative: return 90000.0;
+        }
+        return 60000.0;
+    }
 
-            std::unique_ptr<juce::InputStream> stream(tagsUrl.createInputStream(options));
+    // setup fills in anything beyond the basics before the job is queued. With
+    // coalesce false the job is always added (the second racer of a pair).
+    uint64_t enqueue(Job::Kind kind, const juce::String& prompt, uint64_t cacheKey, uint64_t turnId = 0,
+                     const std::function<void (Job&)>& setup = {}, bool coalesce = true)
+    {
+        const auto now = juce::Time::getMillisecondCounterHiRes();
+        std::shared_ptr<Job> evicted;
+        uint64_t requestId = 0;
+        {
+            const juce::ScopedLock lock(queueLock);
 
-            if (stream == nullptr)
+            // Coalesce with a request of the same kind that hasn't started yet.
+            // Chat turns never coalesce: each one is part of the conversation.
+            const bool singleton = kind == Job::Kind::ModelList || kind == Job::Kind::WarmUp;
+            for (auto& job : queued)
             {
-                processor.setAiStatusMessage(envUrl ? "Ollama (cloud) not reachable" : "Ollama not reachable");
-                processor.setAiNotesMessage(envUrl ? "Check OLLAMA_API_URL and OLLAMA_API_KEY" : "Start Ollama with `ollama serve` and retry.");
-                processor.setAvailableModels({ "llama3" });
-                return;
+                if (! coalesce || job->kind != kind || kind == Job::Kind::Chat)
+                    continue;
+                if (singleton || job->prompt == prompt || (kind == Job::Kind::Speculative && job->cacheKey == cacheKey))
+                    return job->id;
             }
 
-            auto responseText = stream->readEntireStreamAsString();
-            if (statusCode != 200)
+            for (auto& job : running)
             {
-                processor.setAiStatusMessage("Ollama error (HTTP " + juce::String(statusCode) + ")");
-                processor.setAvailableModels({ "llama3" });
-                return;
+                if (job->kind != kind || job->isCancelled())
+                    continue;
+                if (singleton || (kind == Job::Kind::Speculative && job->cacheKey == cacheKey))
+                    return job->id;
             }
 
-            auto parsed = juce::JSON::parse(responseText);
-            juce::StringArray models;
+            // Older suggestions (and both racers of an older race) answer for stale context, and
+            // so does any background suggestion that wasn't asked for
+            if ((kind == Job::Kind::Suggestion || kind == Job::Kind::Speculative) && coalesce)
+            {
+                const auto isStale = [kind](const Job& job)
+                {
+                    if (kind == Job::Kind::Suggestion)
+                        return job.kind == Job::Kind::Suggestion || job.kind == Job::Kind::Speculative;
+                    return job.kind == Job::Kind::Speculative && ! job.adopted;
+                };
+
+                for (auto& job : running)
+                    if (isStale(*job))
+                        job->cancel(Job::CancelReason::Superseded);
+
+                queued.erase(std::remove_if(queued.begin(), queued.end(), [&isStale](const std::shared_ptr<Job>& job)
+                {
+                    if (! isStale(*job))
+                        return false;
+                    job->cancel(Job::CancelReason::Superseded);
+                    return true;
+                }), queued.end());
+            }
 
-            if (parsed.isObject())
+            if (static_cast<int>(queued.size()) >= MAX_QUEUED)
             {
-                auto* obj = parsed.getDynamicObject();
-                auto modelsVar = obj->getProperty("models");
-                if (modelsVar.isArray())
+                // Make room by dropping the newest request of the lowest priority below this one
+                auto victim = queued.end();
+                for (auto it = queued.begin(); it != queued.end(); ++it)
+                    if ((*it)->kind > kind && (victim == queued.end() || (*it)->kind >= (*victim)->kind))
+                        victim = it;
+
+                if (victim != queued.end())
                 {
-                    for (const auto& item : *modelsVar.getArray())
-                    {
-                        if (item.isObject())
-                        {
-                            auto nameVar = item.getDynamicObject()->getProperty("name");
-                            if (nameVar.isString())
-                                models.addIfNotAlreadyThere(nameVar.toString());
-                        }
-                    }
+                    evicted = *victim;
+                    evicted->cancel(Job::CancelReason::Cancelled);
+                    queued.erase(victim);
                 }
             }
 
-            if (models.isEmpty())
-                models.add("llama3");
+            if (static_cast<int>(queued.size()) < MAX_QUEUED)
+            {
+                auto job = std::make_shared<Job>();
+                job->id = ++nextJobId;
+                job->kind = kind;
+                job->prompt = prompt;
+                job->cacheKey = cacheKey;
+                job->turnId = turnId;
+                job->deadlineMs = now + getDeadlineMs(kind);
+                if (setup)
+                    setup(*job);
+                queued.push_back(job);
+                requestId = job->id;
+            }
+        }
 
-            processor.setAvailableModels(models);
-            processor.setAiStatusMessage("Models updated (" + juce::String(models.size()) + " available) [" + (envUrl ? "Ollama Cloud" : "Local Ollama") + "]");
+        if (evicted != nullptr)
+            reportCancelled(*evicted);
+
+        if (requestId == 0)
+        {
+            AR3S_LOG_WARNING("AiClient", "Request queue full ({} waiting), request dropped", MAX_QUEUED);
+            if (kind == Job::Kind::Speculative)
+                return 0;
+            processor.setAiStatusMessage("Too many AI requests waiting");
+            if (kind == Job::Kind::Chat)
+                processor.setChatResponseMessage("Too many requests are waiting - please try again in a moment.");
+            return 0;
         }
-        else if (provider == SimpleGainAudioProcessor::AiProvider::OpenAI)
+
+        wakeWorkers();
+        return requestId;
+    }
+
+    // A suggestion the background request is already asking: show its reply
+    // instead of sending another. Returns its id, or 0 if there is none.
+    uint64_t adoptSpeculative(uint64_t cacheKey)
+    {
+        if (cacheKey == 0)
+            return 0;
+
+        uint64_t adoptedId = 0;
         {
-            if (apiKey.isEmpty())
+            const juce::ScopedLock lock(queueLock);
+            for (auto& job : queued)
             {
-                processor.setAiStatusMessage("API key required");
-                processor.setAvailableModels({ "gpt-4o", "gpt-4o-mini", "gpt-4-turbo", "gpt-3.5-turbo" });
-                return;
+                if (job->kind == Job::Kind::Speculative && job->cacheKey == cacheKey)
+                {
+                    job->adopted = true;
+                    job->kind = Job::Kind::Suggestion;  // Not started yet: it can take a suggestion's place
+                    adoptedId = job->id;
+                    break;
+                }
             }
 
-            juce::URL url("https://api.openai.com/v1/models");
-            int statusCode = 0;
-            auto options = juce::URL::InputStreamOptions(juce::URL::ParameterHandling::inAddress)
-                .withExtraHeaders("Authorization: Bearer " + apiKey)
-                .withConnectionTimeoutMs(15000)
-                .withStatusCode(&statusCode);
-
-            auto stream = url.createInputStream(options);
-            if (stream == nullptr || statusCode != 200)
+            for (auto& job : running)
             {
-                processor.setAiStatusMessage(statusCode == 401 ? "Invalid API key" : "OpenAI connection failed");
-                processor.setAvailableModels({ "gpt-4o", "gpt-4o-mini", "gpt-4-turbo", "gpt-3.5-turbo" });
-                return;
+                if (adoptedId == 0 && job->kind == Job::Kind::Speculative && job->cacheKey == cacheKey
+                    && ! job->isCancelled())
+                {
+                    job->adopted = true;
+                    adoptedId = job->id;
+                }
             }
+        }
 
-            auto responseText = stream->readEntireStreamAsString();
-            auto parsed = juce::JSON::parse(responseText);
-            juce::StringArray models;
+        if (adoptedId == 0)
+            return 0;
+
+        AR3S_LOG_DEBUG("AiClient", "Suggestion {} was already being asked in the background", adoptedId);
+        processor.setAiStatusMessage("Finishing background suggestion...");
+        wakeWorkers();
+        return adoptedId;
+    }
 
-            if (parsed.isObject())
+    template <typename Predicate>
+    void cancelWhere(Predicate matches, Job::CancelReason reason = Job::CancelReason::Cancelled)
+    {
+        std::vector<std::shared_ptr<Job>> removed;
+        {
+            const juce::ScopedLock lock(queueLock);
+            for (auto& job : running)
+                if (matches(*job))
+                    job->cancel(reason);
+
+            for (auto it = queued.begin(); it != queued.end();)
             {
-                auto* obj = parsed.getDynamicObject();
-                auto dataVar = obj->getProperty("data");
-                if (dataVar.isArray())
+                if (matches(**it))
                 {
-                    for (const auto& item : *dataVar.getArray())
-                    {
-                        if (item.isObject())
-                        {
-                            auto idVar = item.getDynamicObject()->getProperty("id");
-                            if (idVar.isString())
-                            {
-                                auto id = idVar.toString();
-                                if (id.startsWith("gpt-"))
-                                    models.addIfNotAlreadyThere(id);
-                            }
-                        }
-                    }
+                    (*it)->cancel(reason);
+                    removed.push_back(*it);
+                    it = queued.erase(it);
+                }
+                else
+                {
+                    ++it;
                 }
             }
+        }
 
-            if (models.isEmpty())
-                models = { "gpt-4o", "gpt-4o-mini", "gpt-4-turbo", "gpt-3.5-turbo" };
-            
-            models.sort(true);
-            processor.setAvailableModels(models);
-            processor.setAiStatusMessage("OpenAI connected (" + juce::String(models.size()) + " models)");
+        // Running jobs are reported by their worker when they unwind
+        for (auto& job : removed)
+            dropQueued(*job);
+    }
+
+    // For a job taken off the queue before it ran
+    void dropQueued(const Job& job)
+    {
+        reportCancelled(job);
+        if (job.race != nullptr)
+            finishRacer(job);
+    }
+
+    // Highest priority first, FIFO within a priority, at most one running job per
+    // kind (the two racers of a suggestion race count as one)
+    std::shared_ptr<Job> takeNextJob()
+    {
+        const juce::ScopedLock lock(queueLock);
+        const auto now = juce::Time::getMillisecondCounterHiRes();
+        auto next = queued.end();
+        for (auto it = queued.begin(); it != queued.end(); ++it)
+        {
+            const auto& candidate = *it;
+            if (candidate->notBeforeMs > now)
+                continue;
+            // Background work never takes the last free worker
+            if (candidate->kind == Job::Kind::Speculative && static_cast<int>(running.size()) >= NUM_WORKERS - 1)
+                continue;
+            const bool kindBusy = std::any_of(running.begin(), running.end(), [&candidate](const std::shared_ptr<Job>& job)
+            {
+                return job->kind == candidate->kind && (job->race == nullptr || job->race != candidate->race);
+            });
+            if (! kindBusy && (next == queued.end() || candidate->kind < (*next)->kind))
+                next = it;
         }
-        else if (provider == SimpleGainAudioProcessor::AiProvider::Anthropic)
+
+        if (next == queued.end())
+            return nullptr;
+
+        auto job = *next;
+        queued.erase(next);
+        running.push_back(job);
+        return job;
+    }
+
+    void runJob(Job& job)
+    {
+        if (! job.providerPinned)
         {
-            // Anthropic doesn't have a public models endpoint, use known models
-            juce::StringArray models = { 
-                "claude-sonnet-4-20250514", 
-                "claude-3-5-sonnet-20241022", 
-                "claude-3-5-haiku-20241022", 
-                "claude-3-opus-20240229",
-                "claude-3-haiku-20240307"
-            };
-            processor.setAvailableModels(models);
-            
-            if (apiKey.isEmpty())
-                processor.setAiStatusMessage("API key required for Anthropic");
-            else
-                processor.setAiStatusMessage("Anthropic ready (" + juce::String(models.size()) + " models)");
+            job.provider = processor.getAiProvider();
+            job.model = processor.getSelectedModel();
         }
-        else if (provider == SimpleGainAudioProcessor::AiProvider::OpenRouter)
+        const auto provider = job.provider;
+        const auto model = job.model;
+        auto apiKey = processor.getApiKey();
+        job.startedMs = juce::Time::getMillisecondCounterHiRes();
+
+        if (job.kind == Job::Kind::ModelList)
         {
-            if (apiKey.isEmpty())
-            {
-                processor.setAiStatusMessage("API key required for OpenRouter");
-                processor.setAvailableModels({ 
-                    "openai/gpt-4o", "anthropic/claude-sonnet-4-20250514", "anthropic/claude-3.5-sonnet",
-                    "google/gemini-pro-1.5", "meta-llama/llama-3.1-70b-instruct"
-                });
+            fetchModelsForProvider(job, provider, apiKey);
+        }
+        else if (job.kind == Job::Kind::WarmUp)
+        {
+            warmUpProvider(job, provider, model);
+        }
+        else if (job.kind == Job::Kind::Chat)
+        {
+            // A conversation cleared while this turn waited has nothing left to send
+            const auto messages = processor.chatConversation.getMessagesForTurn(job.turnId);
+            if (messages.empty() || messages.back().role != AiChatMessage::Role::User)
                 return;
-            }
 
-            // Fetch models from OpenRouter API
-            juce::URL url("https://openrouter.ai/api/v1/models");
-            int statusCode = 0;
-            auto options = juce::URL::InputStreamOptions(juce::URL::ParameterHandling::inAddress)
-                .withExtraHeaders("Authorization: Bearer " + apiKey)
-                .withConnectionTimeoutMs(15000)
-                .withStatusCode(&statusCode);
+            AR3S_TRACE_SCOPE("ai request");
+            sendRequestToProvider(job, provider, apiKey, model, processor.chatConversation.getSystemPrompt(), messages, true);
+        }
+        else
+        {
+            AR3S_TRACE_SCOPE("ai request");
+            sendRequestToProvider(job, provider, apiKey, model, {}, { { AiChatMessage::Role::User, job.prompt } }, false);
+        }
+    }
 
-            auto stream = url.createInputStream(options);
-            if (stream == nullptr || statusCode != 200)
-            {
-                processor.setAiStatusMessage(statusCode == 401 ? "Invalid API key" : "OpenRouter connection failed");
-                processor.setAvailableModels({ 
-                    "openai/gpt-4o", "anthropic/claude-sonnet-4-20250514", "anthropic/claude-3.5-sonnet",
-                    "google/gemini-pro-1.5", "meta-llama/llama-3.1-70b-instruct"
-                });
-                return;
-            }
+    void finishJob(const std::shared_ptr<Job>& job)
+    {
+        job->closeStream();
+        {
+            const juce::ScopedLock lock(queueLock);
+            running.erase(std::remove(running.begin(), running.end(), job), running.end());
+        }
 
-            auto responseText = stream->readEntireStreamAsString();
-            auto parsed = juce::JSON::parse(responseText);
-            juce::StringArray models;
+        if (job->isCancelled())
+            reportCancelled(*job);
+
+        // Unanswered turns leave the history, so the next turn doesn't follow a question without a reply
+        if (job->kind == Job::Kind::Chat)
+            processor.chatConversation.abandonTurn(job->turnId);
+
+        if (job->kind == Job::Kind::Suggestion)
+            recordOutcome(*job);
+        if (job->race != nullptr)
+            finishRacer(*job);
+
+        wakeWorkers();  // A job of the same kind may be waiting for this one
+    }
+
+    void reportCancelled(const Job& job)
+    {
+        const auto reason = job.getCancelReason();
+        if (reason == Job::CancelReason::Superseded || isBackground(job))
+            return;
+
+        const bool timedOut = reason == Job::CancelReason::TimedOut;
+        AR3S_LOG_INFO("AiClient", "Request {} {}", job.id, timedOut ? "timed out" : "cancelled");
+        processor.setAiStatusMessage(timedOut ? "AI request timed out" : "AI request cancelled");
+
+        if (job.kind == Job::Kind::Chat)
+            processor.chatConversation.abandonTurn(job.turnId);
+
+        // A chat reply that started streaming has already been closed off in the chat view
+        if (job.kind == Job::Kind::Chat && ! job.streamStarted)
+            processor.setChatResponseMessage(timedOut ? "No answer from the AI provider in time - please try again."
+                                                      : "Request cancelled.");
+    }
+
+    // Nothing about these is shown unless it fails in a way the user should fix
+    static bool isBackground(const Job& job)
+    {
+        return job.kind == Job::Kind::ModelList || job.kind == Job::Kind::WarmUp
+            || (job.kind == Job::Kind::Speculative && ! job.adopted);
+    }
+
+    // A racer's failure only shows if it was the last one still running; until
+    // then the other may yet answer. Background suggestions fail silently.
+    static bool shouldReportFailure(const Job& job)
+    {
+        if (job.isCancelled() || isBackground(job))
+            return false;
+        return job.race == nullptr || (! job.race->decided && job.race->pending.load() <= 1);
+    }
+
+    static void pinProvider(Job& job, SimpleGainAudioProcessor::AiProvider provider, const juce::String& model)
+    {
+        job.providerPinned = true;
+        job.provider = provider;
+        job.model = model;
+    }
+
+    // Running average time to a structured suggestion, per provider. Racers that
+    // lose are cancelled, so all they tell is that their provider took at least
+    // as long as the winner; that still pulls a too-optimistic average up.
+    struct ProviderLatency
+    {
+        double averageMs = 0.0;
+        int samples = 0;
+        int wins = 0;
+        int races = 0;
+        int consecutiveFailures = 0;
+        double lastFailureMs = 0.0;
+    };
+
+    static constexpr int maxConsecutiveFailures = 3;
+    static constexpr double failurePenaltyMs = 5.0 * 60.0 * 1000.0;  // How long a failing racer sits out
+
+    ProviderLatency& getLatency(SimpleGainAudioProcessor::AiProvider provider)
+    {
+        return latency[(size_t) juce::jlimit(0, (int) latency.size() - 1, static_cast<int>(provider))];
+    }
+
+    double getAverageLatencyMs(SimpleGainAudioProcessor::AiProvider provider)
+    {
+        const juce::ScopedLock lock(statsLock);
+        return getLatency(provider).averageMs;  // 0 until measured: unknown providers go first
+    }
+
+    // Start the second racer once the first is clearly slower than usual; with
+    // too few samples to know what usual is, start both together
+    double getHedgeDelayMs(SimpleGainAudioProcessor::AiProvider first)
+    {
+        const juce::ScopedLock lock(statsLock);
+        const auto& stats = getLatency(first);
+        return stats.samples < 3 ? 0.0 : juce::jlimit(250.0, 5000.0, stats.averageMs * 1.5);
+    }
+
+    bool isProviderUsable(SimpleGainAudioProcessor::AiProvider provider, double now)
+    {
+        const juce::ScopedLock lock(statsLock);
+        const auto& stats = getLatency(provider);
+        return stats.consecutiveFailures < maxConsecutiveFailures || now - stats.lastFailureMs > failurePenaltyMs;
+    }
+
+    void recordOutcome(const Job& job)
+    {
+        const auto now = juce::Time::getMillisecondCounterHiRes();
+        const juce::ScopedLock lock(statsLock);
+        auto& stats = getLatency(job.provider);
+
+        if (job.replyMs > 0.0)
+        {
+            stats.averageMs = stats.samples == 0 ? job.replyMs : stats.averageMs * 0.8 + job.replyMs * 0.2;
+            ++stats.samples;
+            stats.consecutiveFailures = 0;
+        }
+        else if (job.race != nullptr && job.race->decided && ! job.wonRace)
+        {
+            if (job.startedMs > 0.0)
+                stats.averageMs = std::max(stats.averageMs, stats.averageMs * 0.8 + (now - job.startedMs) * 0.2);
+        }
+        else if (! job.isCancelled() && job.startedMs > 0.0)
+        {
+            ++stats.consecutiveFailures;
+            stats.lastFailureMs = now;
+        }
 
-            if (parsed.isObject())
+        if (job.race != nullptr && job.startedMs > 0.0)
+        {
+            ++stats.races;
+            stats.wins += job.wonRace ? 1 : 0;
+            AR3S_LOG_DEBUG("AiClient", "Racer provider {}: {} of {} races won, average {} ms",
+                           static_cast<int>(job.provider), stats.wins, stats.races, stats.averageMs);
+        }
+    }
+
+    void finishRacer(const Job& job)
+    {
+        auto& race = *job.race;
+        const bool lastOut = race.pending.fetch_sub(1) == 1;
+        if (race.decided || job.getCancelReason() == Job::CancelReason::Superseded)
+            return;
+
+        if (! lastOut)
+        {
+            // This one failed: the other needn't wait out its hedge delay
             {
-                auto* obj = parsed.getDynamicObject();
-                auto dataVar = obj->getProperty("data");
-                if (dataVar.isArray())
-                {
-                    for (const auto& item : *dataVar.getArray())
-                    {
-                        if (item.isObject())
-                        {
-                            auto idVar = item.getDynamicObject()->getProperty("id");
-                            if (idVar.isString())
-                            {
-                                auto id = idVar.toString();
-                                // Filter for popular/useful models
-                                if (id.contains("gpt-4") || id.contains("claude") || 
-                                    id.contains("gemini") || id.contains("llama") ||
-                                    id.contains("mixtral") || id.contains("mistral"))
-                                    models.addIfNotAlreadyThere(id);
-                            }
-                        }
-                    }
-                }
+                const juce::ScopedLock lock(queueLock);
+                for (auto& other : queued)
+                    if (other->race == job.race)
+                        other->notBeforeMs = 0.0;
             }
+            return;
+        }
+
+        // Neither produced a structured reply: show what there is, as a single request would
+        juce::String fallback;
+        {
+            const juce::ScopedLock lock(race.fallbackLock);
+            fallback = race.fallbackText;
+        }
+        if (fallback.isNotEmpty())
+            processor.applyAiResponseText(fallback);
+    }
+
+    void wakeWorkers()
+    {
+        for (auto* worker : workers)
+            worker->notify();
+    }
+
+    void fetchModelsForProvider(Job& job, SimpleGainAudioProcessor::AiProvider provider, const juce::String& apiKey)
+    {
+        processor.setAiStatusMessage("Fetching models...");
 
-            if (models.isEmpty())
+        if (provider == SimpleGainAudioProcessor::AiProvider::Ollama
+            || provider == SimpleGainAudioProcessor::AiProvider::OpenAI
+            || provider == SimpleGainAudioProcessor::AiProvider::OpenRouter)
+        {
+            if (provider != SimpleGainAudioProcessor::AiProvider::Ollama && apiKey.isEmpty())
             {
-                models = { 
-                    "openai/gpt-4o", "anthropic/claude-sonnet-4-20250514", "anthropic/claude-3.5-sonnet",
-                    "google/gemini-pro-1.5", "meta-llama/llama-3.1-70b-instruct"
-                };
+                processor.setAiStatusMessage(provider == SimpleGainAudioProcessor::AiProvider::OpenAI
+                                                 ? "API key required" : "API key required for OpenRouter");
+                processor.setAvailableModels(getFallbackModels(provider));
+                return;
             }
-            
-            models.sort(true);
+            fetchModelCatalogue(job, provider, getModelCatalogue(provider, apiKey));
+        }
+        else if (provider == SimpleGainAudioProcessor::AiProvider::Anthropic)
+        {
+            // Anthropic doesn't have a public models endpoint, use known models
+            juce::StringArray models = { 
+                "claude-sonnet-4-20250514", 
+                "claude-3-5-sonnet-20241022", 
+                "claude-3-5-haiku-20241022", 
+                "claude-3-opus-20240229",
+                "claude-3-haiku-20240307"
+            };
             processor.setAvailableModels(models);
-            processor.setAiStatusMessage("OpenRouter connected (" + juce::String(models.size()) + " models)");
+            
+            if (apiKey.isEmpty())
+                processor.setAiStatusMessage("API key required for Anthropic");
+            else
+                processor.setAiStatusMessage("Anthropic ready (" + juce::String(models.size()) + " models)");
         }
         else if (provider == SimpleGainAudioProcessor::AiProvider::MiniMax)
         {
@@ -357,17 +1048,104 @@ private:
         }
     }
 
-    void sendRequestToProvider(SimpleGainAudioProcessor::AiProvider provider, 
+    // Streams the catalogue through ModelIdScanner, revalidating the cached list
+    // with its ETag. If the fetch fails the cached list stays, else the fallback.
+    void fetchModelCatalogue(Job& job, SimpleGainAudioProcessor::AiProvider provider, const ModelCatalogue& catalogue)
+    {
+        const bool isOllama = provider == SimpleGainAudioProcessor::AiProvider::Ollama;
+        const auto cached = ModelListCache::load(catalogue.cacheName, catalogue.sourceKey);
+
+        auto headers = catalogue.headers;
+        if (cached.valid && cached.etag.isNotEmpty())
+            headers << (headers.isEmpty() ? "" : "\r\n") << "If-None-Match: " << cached.etag;
+
+        const auto startMs = juce::Time::getMillisecondCounterHiRes();
+        int statusCode = 0;
+        auto* stream = job.openStream(juce::URL(catalogue.url), false, headers, isOllama ? 10000 : 15000, statusCode);
+
+        if (stream == nullptr || (statusCode != 200 && statusCode != 304))
+        {
+            if (job.isCancelled())
+                return;
+            if (isOllama)
+            {
+                const bool cloud = std::getenv("OLLAMA_API_URL") != nullptr;
+                processor.setAiStatusMessage(stream == nullptr ? (cloud ? "Ollama (cloud) not reachable" : "Ollama not reachable")
+                                                               : "Ollama error (HTTP " + juce::String(statusCode) + ")");
+                if (stream == nullptr)
+                    processor.setAiNotesMessage(cloud ? "Check OLLAMA_API_URL and OLLAMA_API_KEY" : "Start Ollama with `ollama serve` and retry.");
+            }
+            else
+            {
+                processor.setAiStatusMessage(statusCode == 401 ? juce::String("Invalid API key")
+                                                               : catalogue.providerName + " connection failed");
+            }
+            processor.setAvailableModels(cached.valid ? cached.models : getFallbackModels(provider));
+            return;
+        }
+
+        juce::StringArray models;
+        juce::String etag;
+        if (statusCode == 304)
+        {
+            models = cached.models;
+            etag = cached.etag;
+        }
+        else
+        {
+            ModelIdScanner scanner(catalogue.field);
+            char buffer[8192];
+            while (! job.isCancelled())
+            {
+                const int bytesRead = stream->read(buffer, static_cast<int>(sizeof(buffer)));
+                if (bytesRead <= 0)
+                    break;
+                scanner.feed(buffer, bytesRead, [&models, provider](const juce::String& id)
+                {
+                    if (acceptModelId(provider, id))
+                        models.addIfNotAlreadyThere(id);
+                });
+            }
+            if (job.isCancelled())
+                return;
+            etag = stream->getResponseHeaders()["ETag"];
+        }
+
+        AR3S_LOG_INFO("AiClient", "{} models: {} in {} ms (HTTP {})", catalogue.providerName, models.size(),
+                      juce::Time::getMillisecondCounterHiRes() - startMs, statusCode);
+
+        if (models.isEmpty())
+        {
+            models = getFallbackModels(provider);
+        }
+        else
+        {
+            if (! isOllama)
+                models.sort(true);
+            ModelListCache::store(catalogue.cacheName, catalogue.sourceKey, models, etag);
+        }
+
+        processor.setAvailableModels(models);
+        if (isOllama)
+            processor.setAiStatusMessage("Models updated (" + juce::String(models.size()) + " available) ["
+                                         + (std::getenv("OLLAMA_API_URL") != nullptr ? "Ollama Cloud" : "Local Ollama") + "]");
+        else
+            processor.setAiStatusMessage(catalogue.providerName + " connected (" + juce::String(models.size()) + " models)");
+    }
+
+    void sendRequestToProvider(Job& job, SimpleGainAudioProcessor::AiProvider provider, 
                                 const juce::String& apiKey, 
                                 const juce::String& model, 
-                                const juce::String& prompt,
+                                const juce::String& systemPrompt,
+                                const std::vector<AiChatMessage>& messages,
                                 bool isChatMode = false)
     {
-        processor.setAiStatusMessage("Querying " + model + "...");
+        if (! isBackground(job))
+            processor.setAiStatusMessage("Querying " + model + "...");
 
         if (provider == SimpleGainAudioProcessor::AiProvider::Ollama)
         {
-            sendOllamaRequest(model, prompt, isChatMode);
+            sendOllamaRequest(job, model, systemPrompt, messages, isChatMode);
         }
         else if (provider == SimpleGainAudioProcessor::AiProvider::OpenAI)
         {
@@ -377,7 +1155,7 @@ private:
                 processor.setAiNotesMessage("Add your OpenAI API key in Settings to use this feature.");
                 return;
             }
-            sendOpenAIRequest(apiKey, model, prompt, isChatMode);
+            sendOpenAIRequest(job, apiKey, model, systemPrompt, messages, isChatMode);
         }
         else if (provider == SimpleGainAudioProcessor::AiProvider::Anthropic)
         {
@@ -387,7 +1165,7 @@ private:
                 processor.setAiNotesMessage("Add your Anthropic API key in Settings to use this feature.");
                 return;
             }
-            sendAnthropicRequest(apiKey, model, prompt, isChatMode);
+            sendAnthropicRequest(job, apiKey, model, systemPrompt, messages, isChatMode);
         }
         else if (provider == SimpleGainAudioProcessor::AiProvider::OpenRouter)
         {
@@ -397,7 +1175,7 @@ private:
                 processor.setAiNotesMessage("Add your OpenRouter API key in Settings to use this feature.");
                 return;
             }
-            sendOpenRouterRequest(apiKey, model, prompt, isChatMode);
+            sendOpenRouterRequest(job, apiKey, model, systemPrompt, messages, isChatMode);
         }
         else if (provider == SimpleGainAudioProcessor::AiProvider::MiniMax)
         {
@@ -407,23 +1185,233 @@ private:
                 processor.setAiNotesMessage("Add your MiniMax API key in Settings to use this feature.");
                 return;
             }
-            sendMiniMaxRequest(apiKey, model, prompt, isChatMode);
+            sendMiniMaxRequest(job, apiKey, model, systemPrompt, messages, isChatMode);
+        }
+    }
+
+    struct StreamedReply
+    {
+        juce::String text;
+        juce::String error;
+        bool complete = false;  // The provider marked the end (rather than the connection closing)
+    };
+
+    // Reads an NDJSON / SSE reply line by line as it arrives. Chat text is forwarded
+    // to the editor piece by piece; the whole reply is returned as well.
+    StreamedReply readStreamedReply(Job& job, juce::InputStream& stream, AiStreamParser::Format format, bool isChatMode)
+    {
+        StreamedReply reply;
+        uint32_t streamId = 0;
+
+        while (! stream.isExhausted() && ! job.isCancelled())
+        {
+            const auto delta = AiStreamParser::parseLine(format, stream.readNextLine(), reply.complete, reply.error);
+            if (delta.isNotEmpty())
+            {
+                if (reply.text.isEmpty())
+                    job.firstTextMs = juce::Time::getMillisecondCounterHiRes();
+                reply.text += delta;
+                if (isChatMode)
+                {
+                    if (streamId == 0)
+                    {
+                        streamId = processor.beginChatStream();
+                        job.streamStarted = true;
+                    }
+                    processor.appendChatStream(streamId, delta);
+                }
+            }
+            if (reply.complete || reply.error.isNotEmpty())
+                break;
+        }
+
+        if (job.isCancelled())
+            reply.error = job.getCancelReason() == Job::CancelReason::TimedOut ? "timed out" : "stopped";
+
+        if (streamId != 0)
+        {
+            if (reply.error.isNotEmpty())
+                processor.appendChatStream(streamId, "\n[" + reply.error + "]");
+            processor.endChatStream(streamId, reply.text);
+        }
+        return reply;
+    }
+
+    void deliverStreamedReply(Job& job, const StreamedReply& reply, const juce::String& providerName, bool isChatMode)
+    {
+        if (job.isCancelled())
+            return;  // Reported by finishJob
+
+        if (reply.error.isEmpty() && reply.text.isNotEmpty())
+            recordTiming(job, providerName);
+
+        if (reply.text.isEmpty())
+        {
+            if (! shouldReportFailure(job))
+                return;
+            const auto message = reply.error.isNotEmpty() ? reply.error : "Empty response from " + providerName;
+            processor.setAiStatusMessage(providerName + " error");
+            if (isChatMode) processor.setChatResponseMessage(message);
+            else processor.setAiNotesMessage(message);
+            return;
+        }
+
+        // Chat text has already been streamed to the editor; a complete reply joins the history
+        if (isChatMode)
+        {
+            if (reply.error.isEmpty())
+                processor.chatConversation.completeTurn(job.turnId, reply.text);
+            return;
+        }
+
+        // Kept until it's asked for
+        if (isBackground(job))
+        {
+            if (reply.error.isEmpty() && job.cacheKey != 0 && isStructuredSuggestion(reply.text))
+                processor.aiResponseCache.store(job.cacheKey, reply.text);
+            return;
+        }
+
+        if (job.race != nullptr)
+        {
+            // Only a structured reply can win; an unstructured one is kept in case neither does
+            if (! isStructuredSuggestion(reply.text))
+            {
+                const juce::ScopedLock lock(job.race->fallbackLock);
+                job.race->fallbackText = reply.text;
+                return;
+            }
+
+            bool expected = false;
+            if (! job.race->decided.compare_exchange_strong(expected, true))
+                return;  // The other racer got there first
+            job.wonRace = true;
+            const auto race = job.race;
+            cancelWhere([&race, &job](const Job& other) { return other.race == race && &other != &job; },
+                        Job::CancelReason::Superseded);
+        }
+
+        const auto parseStartMs = juce::Time::getMillisecondCounterHiRes();
+        const bool applied = processor.applyAiResponseText(reply.text);
+        processor.aiLatency.add(AiLatencyStats::Parse, juce::Time::getMillisecondCounterHiRes() - parseStartMs);
+        if (! applied)
+            return;
+
+        job.replyMs = juce::Time::getMillisecondCounterHiRes() - job.startedMs;
+        if (job.cacheKey != 0)
+            processor.aiResponseCache.store(job.cacheKey, reply.text);
+        if (job.race != nullptr)
+            processor.setAiStatusMessage(processor.getAiStatus() + " [" + providerName + ", "
+                                         + juce::String(juce::roundToInt(job.replyMs)) + " ms]");
+    }
+
+    void recordTiming(const Job& job, const juce::String& providerName)
+    {
+        const auto now = juce::Time::getMillisecondCounterHiRes();
+        if (job.connectedMs > job.startedMs)
+            processor.aiLatency.add(AiLatencyStats::Connect, job.connectedMs - job.startedMs);
+        if (job.firstTextMs > job.startedMs)
+            processor.aiLatency.add(AiLatencyStats::FirstToken, job.firstTextMs - job.startedMs);
+        processor.aiLatency.add(AiLatencyStats::Total, now - job.startedMs);
+
+        AR3S_LOG_INFO("AiClient", "{} reply: first text after {} ms, done after {} ms", providerName,
+                      juce::roundToInt(job.firstTextMs - job.startedMs), juce::roundToInt(now - job.startedMs));
+    }
+
+    // role/content messages (Ollama, OpenAI, OpenRouter), the system prompt first
+    static juce::Array<juce::var> makeRoleMessages(const juce::String& systemPrompt, const std::vector<AiChatMessage>& messages)
+    {
+        juce::Array<juce::var> messagesArray;
+        if (systemPrompt.isNotEmpty())
+        {
+            auto systemObj = juce::DynamicObject::Ptr(new juce::DynamicObject());
+            systemObj->setProperty("role", "system");
+            systemObj->setProperty("content", systemPrompt);
+            messagesArray.add(juce::var(systemObj.get()));
+        }
+        for (const auto& message : messages)
+        {
+            auto messageObj = juce::DynamicObject::Ptr(new juce::DynamicObject());
+            messageObj->setProperty("role", message.role == AiChatMessage::Role::User ? "user" : "assistant");
+            messageObj->setProperty("content", message.text);
+            messagesArray.add(juce::var(messageObj.get()));
+        }
+        return messagesArray;
+    }
+
+    // A text content block marked as the end of a cacheable prefix (Anthropic prompt caching)
+    static juce::var makeCachedTextBlock(const juce::String& text)
+    {
+        auto cacheControl = juce::DynamicObject::Ptr(new juce::DynamicObject());
+        cacheControl->setProperty("type", "ephemeral");
+
+        auto block = juce::DynamicObject::Ptr(new juce::DynamicObject());
+        block->setProperty("type", "text");
+        block->setProperty("text", text);
+        block->setProperty("cache_control", juce::var(cacheControl.get()));
+
+        juce::Array<juce::var> blocks;
+        blocks.add(juce::var(block.get()));
+        return juce::var(blocks);
+    }
+
+    // Only Ollama has anything to warm: it unloads a model after a few idle minutes
+    // and reloading costs seconds. A generate request without a prompt just loads
+    // the model, and keep_alive (sent with every request) keeps it resident. The
+    // cloud providers are already contacted by the model-list fetch when the
+    // editor opens, and juce::WebInputStream has no connection pool to keep warm.
+    void warmUpProvider(Job& job, SimpleGainAudioProcessor::AiProvider provider, const juce::String& model)
+    {
+        if (provider != SimpleGainAudioProcessor::AiProvider::Ollama || model.isEmpty())
+            return;
+
+        auto requestObject = juce::DynamicObject::Ptr(new juce::DynamicObject());
+        requestObject->setProperty("model", model);
+        requestObject->setProperty("keep_alive", ollamaKeepAlive);
+
+        const char* envUrl = std::getenv("OLLAMA_API_URL");
+        juce::String baseUrl = envUrl ? juce::String(envUrl) : "http://127.0.0.1:11434";
+        juce::URL url = juce::URL(baseUrl + "/api/generate").withPOSTData(juce::JSON::toString(juce::var(requestObject.get())));
+
+        juce::String headers = "Content-Type: application/json";
+        const char* envKey = std::getenv("OLLAMA_API_KEY");
+        if (envKey != nullptr && envKey[0] != '\0')
+            headers += "\r\nAuthorization: Bearer " + juce::String(envKey);
+
+        const auto startMs = juce::Time::getMillisecondCounterHiRes();
+        int statusCode = 0;
+        auto* stream = job.openStream(url, true, headers, 120000, statusCode);
+        if (stream == nullptr || statusCode != 200)
+        {
+            if (! job.isCancelled())
+                AR3S_LOG_INFO("AiClient", "Warm-up of {} failed (HTTP {})", model, statusCode);
+            return;
         }
+
+        stream->readEntireStreamAsString();
+        const auto elapsedMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+        AR3S_LOG_INFO("AiClient", "Warmed up {} in {} ms", model, elapsedMs);
+        if (elapsedMs > 1000.0)
+            processor.setAiStatusMessage(model + " loaded (" + juce::String(elapsedMs / 1000.0, 1) + " s)");
     }
 
-    void sendOllamaRequest(const juce::String& model, const juce::String& prompt, bool isChatMode = false)
+    // /api/chat: while the model stays loaded, Ollama reuses its KV cache for the
+    // part of the conversation it has already seen
+    void sendOllamaRequest(Job& job, const juce::String& model, const juce::String& systemPrompt,
+                           const std::vector<AiChatMessage>& messages, bool isChatMode = false)
     {
         auto requestObject = juce::DynamicObject::Ptr(new juce::DynamicObject());
         requestObject->setProperty("model", model);
-        requestObject->setProperty("prompt", prompt);
-        requestObject->setProperty("stream", false);
+        requestObject->setProperty("messages", makeRoleMessages(systemPrompt, messages));
+        requestObject->setProperty("stream", true);
+        requestObject->setProperty("keep_alive", ollamaKeepAlive);
 
         auto jsonBody = juce::JSON::toString(juce::var(requestObject.get()));
         
         // Use OLLAMA_API_URL for cloud or default to local server
         const char* envUrl = std::getenv("OLLAMA_API_URL");
         juce::String baseUrl = envUrl ? juce::String(envUrl) : "http://127.0.0.1:11434";
-        juce::URL url(baseUrl + "/api/generate");
+        juce::URL url(baseUrl + "/api/chat");
         url = url.withPOSTData(jsonBody);
 
         int statusCode = 0;
@@ -432,15 +1420,12 @@ private:
         if (envKey != nullptr && envKey[0] != '\0')
             headers += "\r\nAuthorization: Bearer " + juce::String(envKey);
 
-        auto options = juce::URL::InputStreamOptions(juce::URL::ParameterHandling::inPostData)
-            .withExtraHeaders(headers)
-            .withConnectionTimeoutMs(120000)
-            .withStatusCode(&statusCode);
-
-        auto stream = url.createInputStream(options);
+        auto* stream = job.openStream(url, true, headers, 120000, statusCode);
         
         if (stream == nullptr)
         {
+            if (! shouldReportFailure(job))
+                return;
             processor.setAiStatusMessage(envUrl ? "Ollama (cloud) connection failed" : "Ollama connection failed");
             if (isChatMode)
                 processor.setChatResponseMessage("Could not connect to Ollama. Check your OLLAMA_API_URL / OLLAMA_API_KEY or start local Ollama with `ollama serve`.");
@@ -449,10 +1434,11 @@ private:
             return;
         }
 
-        auto responseText = stream->readEntireStreamAsString();
-
         if (statusCode != 200)
         {
+            if (! shouldReportFailure(job))
+                return;
+            auto responseText = stream->readEntireStreamAsString();
             processor.setAiStatusMessage("Ollama error (HTTP " + juce::String(statusCode) + ")");
             if (isChatMode)
                 processor.setChatResponseMessage(responseText.isNotEmpty() ? responseText : "No response body");
@@ -461,54 +1447,33 @@ private:
             return;
         }
 
-        auto parsed = juce::JSON::parse(responseText);
-        if (parsed.isObject())
-        {
-            auto* obj = parsed.getDynamicObject();
-            auto responseVar = obj->getProperty("response");
-            if (responseVar.isString())
-            {
-                if (isChatMode)
-                    processor.setChatResponseMessage(responseVar.toString());
-                else
-                    processor.applyAiResponseText(responseVar.toString());
-                return;
-            }
-        }
-        if (isChatMode)
-            processor.setChatResponseMessage(responseText);
-        else
-            processor.applyAiResponseText(responseText);
+        deliverStreamedReply(job, readStreamedReply(job, *stream, AiStreamParser::Format::OllamaNdjson, isChatMode), "Ollama", isChatMode);
     }
 
-    void sendOpenAIRequest(const juce::String& apiKey, const juce::String& model, const juce::String& prompt, bool isChatMode = false)
+    // OpenAI caches long prompt prefixes on its own; the history is resent unchanged so the prefix matches
+    void sendOpenAIRequest(Job& job, const juce::String& apiKey, const juce::String& model, const juce::String& systemPrompt,
+                           const std::vector<AiChatMessage>& messages, bool isChatMode = false)
     {
-        auto messagesArray = juce::Array<juce::var>();
-        auto messageObj = juce::DynamicObject::Ptr(new juce::DynamicObject());
-        messageObj->setProperty("role", "user");
-        messageObj->setProperty("content", prompt);
-        messagesArray.add(juce::var(messageObj.get()));
+        auto messagesArray = makeRoleMessages(systemPrompt, messages);
 
         auto requestObject = juce::DynamicObject::Ptr(new juce::DynamicObject());
         requestObject->setProperty("model", model);
         requestObject->setProperty("messages", messagesArray);
+        requestObject->setProperty("stream", true);
         requestObject->setProperty("max_tokens", 1000);
 
         auto jsonBody = juce::JSON::toString(juce::var(requestObject.get()));
         
-        juce::URL url("https://api.openai.com/v1/chat/completions");
+        juce::URL url(getCloudBaseUrl(SimpleGainAudioProcessor::AiProvider::OpenAI) + "/chat/completions");
         url = url.withPOSTData(jsonBody);
 
         int statusCode = 0;
-        auto options = juce::URL::InputStreamOptions(juce::URL::ParameterHandling::inPostData)
-            .withExtraHeaders("Content-Type: application/json\r\nAuthorization: Bearer " + apiKey)
-            .withConnectionTimeoutMs(60000)
-            .withStatusCode(&statusCode);
-
-        auto stream = url.createInputStream(options);
+        auto* stream = job.openStream(url, true, "Content-Type: application/json\r\nAuthorization: Bearer " + apiKey, 60000, statusCode);
         
         if (stream == nullptr)
         {
+            if (! shouldReportFailure(job))
+                return;
             processor.setAiStatusMessage("OpenAI connection failed");
             auto errMsg = "Could not connect to OpenAI API. Check your internet connection.";
             if (isChatMode) processor.setChatResponseMessage(errMsg);
@@ -516,10 +1481,10 @@ private:
             return;
         }
 
-        auto responseText = stream->readEntireStreamAsString();
-
         if (statusCode == 401)
         {
+            if (! shouldReportFailure(job))
+                return;
             processor.setAiStatusMessage("Invalid OpenAI API key");
             auto errMsg = "Please check your API key in Settings.";
             if (isChatMode) processor.setChatResponseMessage(errMsg);
@@ -529,68 +1494,54 @@ private:
 
         if (statusCode != 200)
         {
+            if (! shouldReportFailure(job))
+                return;
+            auto responseText = stream->readEntireStreamAsString();
             processor.setAiStatusMessage("OpenAI error (HTTP " + juce::String(statusCode) + ")");
             if (isChatMode) processor.setChatResponseMessage(responseText);
             else processor.applyAiResponseText(responseText);
             return;
         }
 
-        auto parsed = juce::JSON::parse(responseText);
-        if (parsed.isObject())
-        {
-            auto* obj = parsed.getDynamicObject();
-            auto choicesVar = obj->getProperty("choices");
-            if (choicesVar.isArray() && choicesVar.getArray()->size() > 0)
-            {
-                auto firstChoice = choicesVar.getArray()->getFirst();
-                if (firstChoice.isObject())
-                {
-                    auto messageVar = firstChoice.getDynamicObject()->getProperty("message");
-                    if (messageVar.isObject())
-                    {
-                        auto contentVar = messageVar.getDynamicObject()->getProperty("content");
-                        if (contentVar.isString())
-                        {
-                            if (isChatMode) processor.setChatResponseMessage(contentVar.toString());
-                            else processor.applyAiResponseText(contentVar.toString());
-                            return;
-                        }
-                    }
-                }
-            }
-        }
-        if (isChatMode) processor.setChatResponseMessage(responseText);
-        else processor.applyAiResponseText(responseText);
+        deliverStreamedReply(job, readStreamedReply(job, *stream, AiStreamParser::Format::OpenAiSse, isChatMode), "OpenAI", isChatMode);
     }
 
-    void sendAnthropicRequest(const juce::String& apiKey, const juce::String& model, const juce::String& prompt, bool isChatMode = false)
+    // Cache breakpoints on the system prompt and on the newest turn: the next turn
+    // reads everything up to here from the cache instead of processing it again
+    void sendAnthropicRequest(Job& job, const juce::String& apiKey, const juce::String& model, const juce::String& systemPrompt,
+                              const std::vector<AiChatMessage>& messages, bool isChatMode = false)
     {
         auto messagesArray = juce::Array<juce::var>();
-        auto messageObj = juce::DynamicObject::Ptr(new juce::DynamicObject());
-        messageObj->setProperty("role", "user");
-        messageObj->setProperty("content", prompt);
-        messagesArray.add(juce::var(messageObj.get()));
+        for (size_t i = 0; i < messages.size(); ++i)
+        {
+            const bool isLast = i + 1 == messages.size();
+            auto messageObj = juce::DynamicObject::Ptr(new juce::DynamicObject());
+            messageObj->setProperty("role", messages[i].role == AiChatMessage::Role::User ? "user" : "assistant");
+            messageObj->setProperty("content", isChatMode && isLast ? makeCachedTextBlock(messages[i].text)
+                                                                    : juce::var(messages[i].text));
+            messagesArray.add(juce::var(messageObj.get()));
+        }
 
         auto requestObject = juce::DynamicObject::Ptr(new juce::DynamicObject());
         requestObject->setProperty("model", model);
+        if (systemPrompt.isNotEmpty())
+            requestObject->setProperty("system", makeCachedTextBlock(systemPrompt));
         requestObject->setProperty("messages", messagesArray);
+        requestObject->setProperty("stream", true);
         requestObject->setProperty("max_tokens", 1000);
 
         auto jsonBody = juce::JSON::toString(juce::var(requestObject.get()));
         
-        juce::URL url("https://api.anthropic.com/v1/messages");
+        juce::URL url(getCloudBaseUrl(SimpleGainAudioProcessor::AiProvider::Anthropic) + "/v1/messages");
         url = url.withPOSTData(jsonBody);
 
         int statusCode = 0;
-        auto options = juce::URL::InputStreamOptions(juce::URL::ParameterHandling::inPostData)
-            .withExtraHeaders("Content-Type: application/json\r\nx-api-key: " + apiKey + "\r\nanthropic-version: 2023-06-01")
-            .withConnectionTimeoutMs(60000)
-            .withStatusCode(&statusCode);
-
-        auto stream = url.createInputStream(options);
+        auto* stream = job.openStream(url, true, "Content-Type: application/json\r\nx-api-key: " + apiKey + "\r\nanthropic-version: 2023-06-01", 60000, statusCode);
         
         if (stream == nullptr)
         {
+            if (! shouldReportFailure(job))
+                return;
             processor.setAiStatusMessage("Anthropic connection failed");
             auto errMsg = "Could not connect to Anthropic API. Check your internet connection.";
             if (isChatMode) processor.setChatResponseMessage(errMsg);
@@ -598,10 +1549,10 @@ private:
             return;
         }
 
-        auto responseText = stream->readEntireStreamAsString();
-
         if (statusCode == 401)
         {
+            if (! shouldReportFailure(job))
+                return;
             processor.setAiStatusMessage("Invalid Anthropic API key");
             auto errMsg = "Please check your API key in Settings.";
             if (isChatMode) processor.setChatResponseMessage(errMsg);
@@ -611,183 +1562,356 @@ private:
 
         if (statusCode != 200)
         {
+            if (! shouldReportFailure(job))
+                return;
+            auto responseText = stream->readEntireStreamAsString();
             processor.setAiStatusMessage("Anthropic error (HTTP " + juce::String(statusCode) + ")");
             if (isChatMode) processor.setChatResponseMessage(responseText);
             else processor.applyAiResponseText(responseText);
             return;
         }
 
-        auto parsed = juce::JSON::parse(responseText);
-        if (parsed.isObject())
+        deliverStreamedReply(job, readStreamedReply(job, *stream, AiStreamParser::Format::AnthropicSse, isChatMode), "Anthropic", isChatMode);
+    }
+
+    void sendOpenRouterRequest(Job& job, const juce::String& apiKey, const juce::String& model, const juce::String& systemPrompt,
+                               const std::vector<AiChatMessage>& messages, bool isChatMode = false)
+    {
+        auto messagesArray = makeRoleMessages(systemPrompt, messages);
+
+        auto requestObject = juce::DynamicObject::Ptr(new juce::DynamicObject());
+        requestObject->setProperty("model", model);
+        requestObject->setProperty("messages", messagesArray);
+        requestObject->setProperty("stream", true);
+
+        auto jsonBody = juce::JSON::toString(juce::var(requestObject.get()));
+        
+        juce::URL url(getCloudBaseUrl(SimpleGainAudioProcessor::AiProvider::OpenRouter) + "/chat/completions");
+        url = url.withPOSTData(jsonBody);
+
+        int statusCode = 0;
+        auto* stream = job.openStream(url, true, "Content-Type: application/json\r\nAuthorization: Bearer " + apiKey, 60000, statusCode);
+        
+        if (stream == nullptr)
         {
-            auto* obj = parsed.getDynamicObject();
-            auto contentVar = obj->getProperty("content");
-            if (contentVar.isArray() && contentVar.getArray()->size() > 0)
-            {
-                auto firstContent = contentVar.getArray()->getFirst();
-                if (firstContent.isObject())
-                {
-                    auto textVar = firstContent.getDynamicObject()->getProperty("text");
-                    if (textVar.isString())
-                    {
-                        if (isChatMode) processor.setChatResponseMessage(textVar.toString());
-                        else processor.applyAiResponseText(textVar.toString());
-                        return;
-                    }
-                }
-            }
+            if (! shouldReportFailure(job))
+                return;
+            processor.setAiStatusMessage("OpenRouter connection failed");
+            if (isChatMode) processor.setChatResponseMessage("Connection failed");
+            return;
+        }
+
+        if (statusCode != 200)
+        {
+            if (! shouldReportFailure(job))
+                return;
+            auto responseText = stream->readEntireStreamAsString();
+            processor.setAiStatusMessage("OpenRouter error (HTTP " + juce::String(statusCode) + ")");
+            if (isChatMode) processor.setChatResponseMessage(responseText);
+            else processor.applyAiResponseText(responseText);
+            return;
         }
-        if (isChatMode) processor.setChatResponseMessage(responseText);
-        else processor.applyAiResponseText(responseText);
+
+        deliverStreamedReply(job, readStreamedReply(job, *stream, AiStreamParser::Format::OpenAiSse, isChatMode), "OpenRouter", isChatMode);
     }
 
-    void sendOpenRouterRequest(const juce::String& apiKey, const juce::String& model, const juce::String& prompt, bool isChatMode = false)
+    void sendMiniMaxRequest(Job& job, const juce::String& apiKey, const juce::String& model, const juce::String& systemPrompt,
+                            const std::vector<AiChatMessage>& messages, bool isChatMode = false)
     {
+        // No system role in this message format: the system prompt leads the first turn
         auto messagesArray = juce::Array<juce::var>();
-        auto messageObj = juce::DynamicObject::Ptr(new juce::DynamicObject());
-        messageObj->setProperty("role", "user");
-        messageObj->setProperty("content", prompt);
-        messagesArray.add(juce::var(messageObj.get()));
+        for (size_t i = 0; i < messages.size(); ++i)
+        {
+            const bool isUser = messages[i].role == AiChatMessage::Role::User;
+            auto messageObj = juce::DynamicObject::Ptr(new juce::DynamicObject());
+            messageObj->setProperty("sender_type", isUser ? "USER" : "BOT");
+            messageObj->setProperty("text", i == 0 && systemPrompt.isNotEmpty() ? systemPrompt + "\n\n" + messages[i].text
+                                                                               : messages[i].text);
+            messagesArray.add(juce::var(messageObj.get()));
+        }
 
         auto requestObject = juce::DynamicObject::Ptr(new juce::DynamicObject());
         requestObject->setProperty("model", model);
         requestObject->setProperty("messages", messagesArray);
+        requestObject->setProperty("stream", true);
 
         auto jsonBody = juce::JSON::toString(juce::var(requestObject.get()));
         
-        juce::URL url("https://openrouter.ai/api/v1/chat/completions");
+        juce::URL url(getCloudBaseUrl(SimpleGainAudioProcessor::AiProvider::MiniMax) + "/text/chatcompletion_v2");
         url = url.withPOSTData(jsonBody);
 
         int statusCode = 0;
-        auto options = juce::URL::InputStreamOptions(juce::URL::ParameterHandling::inPostData)
-            .withExtraHeaders("Content-Type: application/json\r\nAuthorization: Bearer " + apiKey)
-            .withConnectionTimeoutMs(60000)
-            .withStatusCode(&statusCode);
-
-        auto stream = url.createInputStream(options);
+        auto* stream = job.openStream(url, true, "Content-Type: application/json\r\nAuthorization: Bearer " + apiKey, 60000, statusCode);
         
         if (stream == nullptr)
         {
-            processor.setAiStatusMessage("OpenRouter connection failed");
+            if (! shouldReportFailure(job))
+                return;
+            processor.setAiStatusMessage("MiniMax connection failed");
             if (isChatMode) processor.setChatResponseMessage("Connection failed");
             return;
         }
 
-        auto responseText = stream->readEntireStreamAsString();
+        if (statusCode != 200)
+        {
+            if (! shouldReportFailure(job))
+                return;
+            auto responseText = stream->readEntireStreamAsString();
+            processor.setAiStatusMessage("MiniMax error (HTTP " + juce::String(statusCode) + ")");
+            if (isChatMode) processor.setChatResponseMessage(responseText);
+            else processor.applyAiResponseText(responseText);
+            return;
+        }
+
+        deliverStreamedReply(job, readStreamedReply(job, *stream, AiStreamParser::Format::OpenAiSse, isChatMode), "MiniMax", isChatMode);
+    }
+
+    SimpleGainAudioProcessor& processor;
+    juce::OwnedArray<Worker> workers;
+    juce::CriticalSection queueLock;
+    std::vector<std::shared_ptr<Job>> queued;   // Arrival order
+    std::vector<std::shared_ptr<Job>> running;
+    uint64_t nextJobId = 0;
+    juce::CriticalSection statsLock;
+    std::array<ProviderLatency, 5> latency;     // By AiProvider
+};
+
+// Keeps the cross-track masking matrix up to date. Polls the satellites' band
+// energy at 5 Hz. Satellites republish bands on every FFT frame, so a row is only
+// re-scored when some band moved by rescoreThresholdDb since it was last scored (or
+// the slot changed owner): steady material costs O(changed x active), not O(N^2).
+class SimpleGainAudioProcessor::CrossTrackAnalyzer : public juce::Thread
+{
+public:
+    explicit CrossTrackAnalyzer(SimpleGainAudioProcessor& owner)
+        : juce::Thread("CrossTrackAnalyzer"), processor(owner)
+    {
+        startThread(juce::Thread::Priority::low);
+    }
+
+    ~CrossTrackAnalyzer() override
+    {
+        signalThreadShouldExit();
+        wakeEvent.signal();
+        waitForThreadToExit(2000);
+    }
+
+    void run() override
+    {
+        AR3S_TRACE_THREAD_NAME("cross-track analyzer");
+        while (! threadShouldExit())
+        {
+            wakeEvent.wait(200);
+            if (threadShouldExit())
+                break;
+
+            AR3S_TRACE_SCOPE("cross-track pass");
+            if (updateMatrix())
+            {
+                const juce::ScopedLock lock(processor.maskingLock);
+                processor.maskingSnapshot = matrix;
+            }
+            
+            if (processor.continuousGainSolving.load())
+                processor.solveSatelliteGains(processor.gainSolverTargetDb.load(), true);
+            
+            // Phase checks need fresh 4096-frame windows, so every third pass is plenty
+            if (++passCount % 3 == 0)
+            {
+                checkPhaseAlignment();
+                
+                const auto prediction = processor.predictSummedBus(GccPhatEstimator::windowSize);
+                const juce::ScopedLock lock(processor.phaseLock);
+                processor.busPrediction = prediction;
+            }
+        }
+    }
+
+private:
+    SimpleGainAudioProcessor& processor;
+    juce::WaitableEvent wakeEvent;
+
+    static constexpr float rescoreThresholdDb = 1.0f;
 
-        if (statusCode != 200)
-        {
-            processor.setAiStatusMessage("OpenRouter error (HTTP " + juce::String(statusCode) + ")");
-            if (isChatMode) processor.setChatResponseMessage(responseText);
-            else processor.applyAiResponseText(responseText);
-            return;
-        }
+    MaskingSnapshot matrix;
+    float bands[MAX_SATELLITES][NUM_ANALYSIS_BANDS] {};  // As last scored
+    uint32_t seenGeneration[MAX_SATELLITES] {};
+    uint32_t seenBandsVersion[MAX_SATELLITES] {};
+
+    int passCount = 0;
+    GccPhatEstimator phaseEstimator;
+    juce::AudioBuffer<float> capture;
+    std::vector<float> captureMono;
+    std::vector<float> spectra[MAX_SATELLITES];
+
+    // Returns true if the matrix changed
+    bool updateMatrix()
+    {
+        auto* data = processor.sharedMemoryConnected ? processor.sharedMemory.getData() : nullptr;
+        if (data == nullptr)
+            return false;
 
-        auto parsed = juce::JSON::parse(responseText);
-        if (parsed.isObject())
+        const auto now = getMonotonicMillis();
+        std::array<bool, MAX_SATELLITES> dirty {};
+        bool anyDirty = false;
+
+        for (int i = 0; i < MAX_SATELLITES; ++i)
         {
-            auto* obj = parsed.getDynamicObject();
-            auto choicesVar = obj->getProperty("choices");
-            if (choicesVar.isArray() && choicesVar.getArray()->size() > 0)
+            const auto& sat = data->satellites[i];
+            const bool live = data->isSlotLive(i, now, 3000) && sat.analysisProfile.load() >= 2
+                              && sat.bandsVersion.load(std::memory_order_acquire) != 0;
+
+            if (! live)
             {
-                auto firstChoice = choicesVar.getArray()->getFirst();
-                if (firstChoice.isObject())
+                if (matrix.active[(size_t) i])
                 {
-                    auto messageVar = firstChoice.getDynamicObject()->getProperty("message");
-                    if (messageVar.isObject())
-                    {
-                        auto contentVar = messageVar.getDynamicObject()->getProperty("content");
-                        if (contentVar.isString())
-                        {
-                            if (isChatMode) processor.setChatResponseMessage(contentVar.toString());
-                            else processor.applyAiResponseText(contentVar.toString());
-                            return;
-                        }
-                    }
+                    matrix.active[(size_t) i] = false;
+                    dirty[(size_t) i] = anyDirty = true;
                 }
+                continue;
             }
-        }
-        if (isChatMode) processor.setChatResponseMessage(responseText);
-        else processor.applyAiResponseText(responseText);
-    }
 
-    void sendMiniMaxRequest(const juce::String& apiKey, const juce::String& model, const juce::String& prompt, bool isChatMode = false)
-    {
-        auto messagesArray = juce::Array<juce::var>();
-        auto messageObj = juce::DynamicObject::Ptr(new juce::DynamicObject());
-        messageObj->setProperty("sender_type", "USER");
-        messageObj->setProperty("text", prompt);
-        messagesArray.add(juce::var(messageObj.get()));
+            const auto generation = sat.generation.load();
+            const auto version = sat.bandsVersion.load(std::memory_order_acquire);
+            const bool sameOwner = matrix.active[(size_t) i] && generation == seenGeneration[i];
+            if ((sameOwner && version == seenBandsVersion[i]) || (version & 1u) != 0)
+                continue;  // Nothing new, or the satellite is mid-update (next pass)
 
-        auto requestObject = juce::DynamicObject::Ptr(new juce::DynamicObject());
-        requestObject->setProperty("model", model);
-        requestObject->setProperty("messages", messagesArray);
+            float fresh[NUM_ANALYSIS_BANDS];
+            float largestMoveDb = 0.0f;
+            for (int k = 0; k < NUM_ANALYSIS_BANDS; ++k)
+            {
+                fresh[k] = sat.bandEnergyDb[k].load(std::memory_order_relaxed);
+                largestMoveDb = std::max(largestMoveDb, std::abs(fresh[k] - bands[i][k]));
+            }
 
-        auto jsonBody = juce::JSON::toString(juce::var(requestObject.get()));
-        
-        juce::URL url("https://api.minimax.chat/v1/text/chatcompletion_v2");
-        url = url.withPOSTData(jsonBody);
+            // Rewritten while we copied - try again next pass
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sat.bandsVersion.load(std::memory_order_relaxed) != version)
+                continue;
 
-        int statusCode = 0;
-        auto options = juce::URL::InputStreamOptions(juce::URL::ParameterHandling::inPostData)
-            .withExtraHeaders("Content-Type: application/json\r\nAuthorization: Bearer " + apiKey)
-            .withConnectionTimeoutMs(60000)
-            .withStatusCode(&statusCode);
+            seenBandsVersion[i] = version;
+            if (sameOwner && largestMoveDb < rescoreThresholdDb)
+                continue;
 
-        auto stream = url.createInputStream(options);
-        
-        if (stream == nullptr)
-        {
-            processor.setAiStatusMessage("MiniMax connection failed");
-            if (isChatMode) processor.setChatResponseMessage("Connection failed");
-            return;
+            std::copy(std::begin(fresh), std::end(fresh), bands[i]);
+            seenGeneration[i] = generation;
+            matrix.active[(size_t) i] = true;
+            dirty[(size_t) i] = anyDirty = true;
         }
 
-        auto responseText = stream->readEntireStreamAsString();
+        if (! anyDirty)
+            return false;
 
-        if (statusCode != 200)
+        for (int i = 0; i < MAX_SATELLITES; ++i)
         {
-            processor.setAiStatusMessage("MiniMax error (HTTP " + juce::String(statusCode) + ")");
-            if (isChatMode) processor.setChatResponseMessage(responseText);
-            else processor.applyAiResponseText(responseText);
-            return;
+            if (! dirty[(size_t) i])
+                continue;
+
+            for (int j = 0; j < MAX_SATELLITES; ++j)
+            {
+                float severity = 0.0f;
+                int dominant = -1;
+                if (i != j && matrix.active[(size_t) i] && matrix.active[(size_t) j])
+                    severity = computeMaskingSeverity(bands[i], bands[j], dominant);
+
+                matrix.severity[(size_t) (i * MAX_SATELLITES + j)] = severity;
+                matrix.severity[(size_t) (j * MAX_SATELLITES + i)] = severity;
+                matrix.dominantBand[(size_t) (i * MAX_SATELLITES + j)] = static_cast<int8_t>(dominant);
+                matrix.dominantBand[(size_t) (j * MAX_SATELLITES + i)] = static_cast<int8_t>(dominant);
+            }
         }
 
-        auto parsed = juce::JSON::parse(responseText);
-        if (parsed.isObject())
+        ++matrix.version;
+        return true;
+    }
+
+    // GCC-PHAT between every pair of phase-checked satellites, on windows that
+    // end at the same host timeline position
+    void checkPhaseAlignment()
+    {
+        auto* data = processor.sharedMemoryConnected ? processor.sharedMemory.getData() : nullptr;
+        const auto mask = processor.phaseCheckMask.load();
+        std::vector<PhaseAlignment> results;
+        
+        if (data != nullptr && mask != 0)
         {
-            auto* obj = parsed.getDynamicObject();
-            auto choicesVar = obj->getProperty("choices");
-            if (choicesVar.isArray() && choicesVar.getArray()->size() > 0)
+            const auto now = getMonotonicMillis();
+            std::vector<int> tracks;
+            int64_t commonEnd = std::numeric_limits<int64_t>::max();
+            double frameRate = 0.0;
+            
+            for (int i = 0; i < MAX_SATELLITES; ++i)
+            {
+                if ((mask & (1u << i)) == 0)
+                    continue;
+                
+                // Track went away - stop asking the slot's next owner to stream
+                if (! data->isSlotLive(i, now, 3000))
+                {
+                    processor.setSatellitePhaseCheck(i, false);
+                    continue;
+                }
+                
+                // Only full-rate streams with a running transport can be aligned sample-accurately
+                const auto& ring = data->satellites[i].audio;
+                const auto latest = ring.getTimelinePosition(ring.writePosition.load());
+                if (ring.decimation.load() != 1 || latest < 0)
+                    continue;
+                
+                commonEnd = std::min(commonEnd, latest);
+                frameRate = ring.frameRate.load();
+                tracks.push_back(i);
+            }
+            
+            if (tracks.size() >= 2)
             {
-                auto firstChoice = choicesVar.getArray()->getFirst();
-                if (firstChoice.isObject())
+                constexpr int windowSize = GccPhatEstimator::windowSize;
+                captureMono.resize(static_cast<size_t>(windowSize));
+                
+                std::vector<int> ready;
+                for (int index : tracks)
+                {
+                    int64_t timelineStart = -1;
+                    if (processor.readSatelliteAudio(index, windowSize, capture, timelineStart, commonEnd) != windowSize)
+                        continue;
+                    
+                    const auto* left = capture.getReadPointer(0);
+                    const auto* right = capture.getReadPointer(1);
+                    for (int n = 0; n < windowSize; ++n)
+                        captureMono[(size_t) n] = 0.5f * (left[n] + right[n]);
+                    
+                    if (phaseEstimator.computeSpectrum(captureMono.data(), spectra[index]))
+                        ready.push_back(index);
+                }
+                
+                // Mic spacing beyond ~7 m (20 ms) isn't a phase problem, it's an echo
+                const int maxLag = juce::jlimit(1, windowSize - 1, juce::roundToInt(frameRate * 0.02));
+                
+                for (size_t a = 0; a < ready.size(); ++a)
                 {
-                    auto messageVar = firstChoice.getDynamicObject()->getProperty("message");
-                    if (messageVar.isObject())
+                    for (size_t b = a + 1; b < ready.size(); ++b)
                     {
-                        auto contentVar = messageVar.getDynamicObject()->getProperty("content");
-                        if (contentVar.isString())
-                        {
-                            if (isChatMode) processor.setChatResponseMessage(contentVar.toString());
-                            else processor.applyAiResponseText(contentVar.toString());
-                            return;
-                        }
+                        const auto estimate = phaseEstimator.compare(spectra[ready[a]], spectra[ready[b]], maxLag);
+                        if (! estimate.valid)
+                            continue;
+                        
+                        PhaseAlignment alignment;
+                        alignment.trackA = ready[a];
+                        alignment.trackB = ready[b];
+                        alignment.offsetSamples = estimate.offsetSamples;
+                        alignment.offsetMs = frameRate > 0.0 ? static_cast<float>(estimate.offsetSamples * 1000.0 / frameRate) : 0.0f;
+                        alignment.polarityInverted = estimate.polarityInverted;
+                        alignment.confidence = estimate.confidence;
+                        results.push_back(alignment);
                     }
                 }
             }
         }
-        if (isChatMode) processor.setChatResponseMessage(responseText);
-        else processor.applyAiResponseText(responseText);
+        
+        const juce::ScopedLock lock(processor.phaseLock);
+        processor.phaseAlignments = std::move(results);
     }
-
-    SimpleGainAudioProcessor& processor;
-    juce::WaitableEvent requestEvent;
-    juce::CriticalSection requestLock;
-    juce::String pendingPrompt;
-    bool pendingIsChatMode = false;
-    bool hasRequest = false;
-    bool wantsModelList = false;
 };
 
 SimpleGainAudioProcessor::SimpleGainAudioProcessor()
@@ -797,18 +1921,177 @@ SimpleGainAudioProcessor::SimpleGainAudioProcessor()
       parameters(*this, nullptr, "PARAMETERS", createParameterLayout())
 {
     aiClient = std::make_unique<AiClient>(*this);
+    aiResponseCache.open();
+    chatConversation.setSystemPrompt(getChatSystemPrompt());
     availableModels = { "llama3" };
     loadSettings();
     
     // Initialize shared memory for satellite communication
     initializeSharedMemory();
+    crossTrackAnalyzer = std::make_unique<CrossTrackAnalyzer>(*this);
+    
+    sessionStartMs = getMonotonicMillis();
+    residentStartBytes.store(getResidentMemoryBytes());
+    residentCurrentBytes.store(residentStartBytes.load());
+    residentPeakBytes.store(residentStartBytes.load());
+    
+    for (auto* id : { "genre", "source", "situation" })
+        parameters.addParameterListener(id, this);
+    
+    // Reap slots of crashed/closed hosts a few times per second (kill() is a
+    // syscall, so this stays off the audio thread)
+    startTimerHz(4);
 }
 
 SimpleGainAudioProcessor::~SimpleGainAudioProcessor()
 {
+    for (auto* id : { "genre", "source", "situation" })
+        parameters.removeParameterListener(id, this);
+    stopTimer();
+    aiClient.reset();  // Abort AI requests while the state they report into still exists
+    crossTrackAnalyzer.reset();  // Stop reading shared memory before it is unmapped
     sharedMemory.close();
 }
 
+void SimpleGainAudioProcessor::timerCallback()
+{
+    if (sharedMemoryConnected)
+    {
+        if (auto* data = sharedMemory.getData())
+            data->reapDeadOwners();
+        
+        // Time the same full-slot sweep the editor does every frame
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < MAX_SATELLITES; ++i)
+            juce::ignoreUnused(getSatelliteInfo(i));
+        const auto sweepMicros = static_cast<float>(juce::Time::highResolutionTicksToSeconds(
+            juce::Time::getHighResolutionTicks() - startTicks) * 1.0e6);
+        ipcSweepMicros.store(0.9f * ipcSweepMicros.load() + 0.1f * sweepMicros);
+    }
+    
+    if (++healthTimerTicks >= 4)
+    {
+        healthTimerTicks = 0;
+        const auto resident = getResidentMemoryBytes();
+        residentCurrentBytes.store(resident);
+        residentPeakBytes.store(std::max(residentPeakBytes.load(), resident));
+        
+        // Caches, the model connection and the editor are all warm by now
+        if (residentBaselineBytes.load() == 0 && getMonotonicMillis() - sessionStartMs >= growthBaselineMs)
+            residentBaselineBytes.store(resident);
+    }
+    
+    // While the editor is open, keep the local model loaded (keep_alive is 30 min)
+    if (getAiProvider() == AiProvider::Ollama && getActiveEditor() != nullptr
+        && getMonotonicMillis() - lastAiWarmUpMs > 20 * 60 * 1000)
+        warmUpAiProvider();
+
+    updateSpeculativeSuggestion();
+}
+
+// May come from the audio thread (automation): only note it, the timer does the rest
+void SimpleGainAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    juce::ignoreUnused(parameterID, newValue);
+    aiContextChanged.store(true);
+}
+
+// After a genre/source/situation change, wait until the choice has stood for a
+// few seconds and the input level has settled, then ask for the suggestion in the
+// background. Another change cancels the request and starts the wait again.
+void SimpleGainAudioProcessor::updateSpeculativeSuggestion()
+{
+    constexpr int64_t debounceMs = 3000;
+    constexpr int settledTicksNeeded = 4;      // 1 s at the 4 Hz timer
+    constexpr int64_t budgetWindowMs = 60 * 60 * 1000;
+
+    const auto now = getMonotonicMillis();
+    if (aiContextChanged.exchange(false))
+    {
+        speculationDueMs = now + debounceMs;
+        speculationSettledTicks = 0;
+        if (aiClient != nullptr)
+            aiClient->cancelSpeculative();
+    }
+
+    // Only while someone is there to click "Ask AI"
+    if (speculationDueMs == 0 || now < speculationDueMs || getActiveEditor() == nullptr)
+        return;
+
+    const auto analysis = getAnalysisSnapshot();
+    const bool settled = analysis.preRmsDb > -60.0f && std::abs(analysis.preRmsDb - speculationLastRmsDb) < 1.5f;
+    speculationLastRmsDb = analysis.preRmsDb;
+    speculationSettledTicks = settled ? speculationSettledTicks + 1 : 0;
+    if (speculationSettledTicks < settledTicksNeeded)
+        return;
+    speculationDueMs = 0;
+
+    while (! speculationTimesMs.empty() && now - speculationTimesMs.front() > budgetWindowMs)
+        speculationTimesMs.pop_front();
+
+    const auto budget = getSpeculativeSuggestionsPerHour();
+    if (static_cast<int>(speculationTimesMs.size()) >= budget)
+    {
+        if (budget > 0)
+            AR3S_LOG_DEBUG("AiClient", "Background suggestion skipped, {} sent in the last hour", budget);
+        return;
+    }
+
+    // Cloud requests without a key would only fail
+    if (getAiProvider() != AiProvider::Ollama && getApiKey().isEmpty())
+        return;
+
+    juce::String genre, source, situation;
+    getAiContextNames(genre, source, situation);
+    if (sendAiSuggestion(genre, source, situation, true))
+        speculationTimesMs.push_back(now);
+}
+
+void SimpleGainAudioProcessor::exportTraces()
+{
+   #if AR3S_ENABLE_TRACING
+    // Satellites in this process see the same request but leave the export to us
+    auto* memData = sharedMemory.getData();
+    const bool shared = sharedMemoryConnected && memData != nullptr;
+    if (shared && !TraceRecorder::getInstance().claimExport(memData->traceExportRequest.fetch_add(1) + 1))
+        return;
+    
+    juce::Thread::launch([] {
+        const auto file = TraceRecorder::getDefaultTraceFile();
+        if (TraceRecorder::getInstance().writeChromeTrace(file))
+            AR3S_LOG_INFO("Master", "Trace written to {}", file.getFileName());
+    });
+   #endif
+}
+
+SimpleGainAudioProcessor::SessionHealth SimpleGainAudioProcessor::getSessionHealth() const
+{
+    SessionHealth health;
+    const auto uptimeMs = getMonotonicMillis() - sessionStartMs;
+    health.uptimeMinutes = static_cast<double>(uptimeMs) / 60000.0;
+    
+    constexpr float bytesPerMb = 1024.0f * 1024.0f;
+    health.residentMb = static_cast<float>(residentCurrentBytes.load()) / bytesPerMb;
+    health.residentStartMb = static_cast<float>(residentStartBytes.load()) / bytesPerMb;
+    health.residentPeakMb = static_cast<float>(residentPeakBytes.load()) / bytesPerMb;
+    const auto baselineBytes = residentBaselineBytes.load();
+    const auto sinceBaselineMs = uptimeMs - growthBaselineMs;
+    if (baselineBytes > 0 && sinceBaselineMs >= growthBaselineMs)
+        health.growthMbPerHour = (static_cast<float>(residentCurrentBytes.load() - baselineBytes) / bytesPerMb)
+                                 / static_cast<float>(sinceBaselineMs / 3600000.0);
+    
+    if (auto* memData = sharedMemory.getData(); sharedMemoryConnected && memData != nullptr)
+    {
+        health.slotClaims = memData->slotClaims.load();
+        health.slotTakeovers = memData->slotTakeovers.load();
+        health.slotReleases = memData->slotReleases.load();
+        health.slotsReaped = memData->slotsReaped.load();
+        health.slotClaimFailures = memData->slotClaimFailures.load();
+    }
+    
+    return health;
+}
+
 const juce::String SimpleGainAudioProcessor::getName() const
 {
     return JucePlugin_Name;
@@ -875,6 +2158,8 @@ void SimpleGainAudioProcessor::prepareToPlay(double sampleRate, int)
     fftData.fill(0.0f);
     fftInputBuffer.fill(0.0f);
     fftInputPos = 0;
+    
+    loadMeter.prepare(sampleRate);
 }
 
 void SimpleGainAudioProcessor::releaseResources()
@@ -896,6 +2181,9 @@ bool SimpleGainAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts
 void SimpleGainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
+    const ProcessingLoadMeter::ScopedBlock loadScope(loadMeter, buffer.getNumSamples());
+    AR3S_TRACE_THREAD_NAME("audio");
+    AR3S_TRACE_SCOPE("master processBlock");
 
     const auto numChannels = buffer.getNumChannels();
     const auto numSamples = buffer.getNumSamples();
@@ -1043,6 +2331,7 @@ void SimpleGainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
         // Always apply if ceiling is below 0 dB
         if (ceilingDb < -0.1f)
         {
+            loadMeter.markStage(StageCeiling);
             float ceilingLinear = dbToLinear(ceilingDb);
             const int numChannels = buffer.getNumChannels();
             const int numSamples = buffer.getNumSamples();
@@ -1092,7 +2381,7 @@ void SimpleGainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
     // Only push when values change OR every 50ms (20 times per second max)
     if (sharedMemoryConnected)
     {
-        const auto currentTime = juce::Time::currentTimeMillis();
+        const auto currentTime = getMonotonicMillis();
         const auto targetDb = autoTargetDb->load();
         const auto autoEn = autoEnabled->load() > 0.5f;
         const auto riderAmt = riderAmount->load();
@@ -1108,6 +2397,7 @@ void SimpleGainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
         
         if (valuesChanged || timeExpired)
         {
+            loadMeter.markStage(StageIpcPush);
             auto* memData = sharedMemory.getData();
             if (memData != nullptr)
             {
@@ -1140,8 +2430,8 @@ void SimpleGainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
                 for (int i = 0; i < MAX_SATELLITES; ++i)
                 {
                     auto& sat = memData->satellites[i];
-                    // Push to active satellites (updated within 2 seconds)
-                    if (currentTime - sat.lastUpdateTime.load() < 2000)
+                    // Push to live satellites (heartbeat within 2 seconds)
+                    if (memData->isSlotLive(i, currentTime, 2000))
                     {
                         sat.control.targetDb.store(targetDb);
                         sat.control.autoEnabled.store(autoEn);
@@ -1276,6 +2566,8 @@ void SimpleGainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
             // When buffer is full, perform FFT analysis
             if (fftInputPos >= fftSize)
             {
+                AR3S_TRACE_SCOPE("master fft frame");
+                loadMeter.markStage(StageFftFrame);
                 fftInputPos = 0;
                 
                 // Copy to FFT data and apply window
@@ -1332,6 +2624,19 @@ void SimpleGainAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
     auto state = parameters.copyState();
     std::unique_ptr<juce::XmlElement> xml(state.createXml());
+    
+    // Group offsets belong to the session, not to whichever satellites are loaded
+    auto* groupsXml = xml->createNewChildElement("Groups");
+    for (int groupId = 1; groupId <= MAX_SATELLITE_GROUPS; ++groupId)
+    {
+        const auto group = getGroupInfo(groupId);
+        auto* groupXml = groupsXml->createNewChildElement("Group");
+        groupXml->setAttribute("id", groupId);
+        groupXml->setAttribute("gainOffsetDb", group.gainOffsetDb);
+        groupXml->setAttribute("targetOffsetDb", group.targetOffsetDb);
+        groupXml->setAttribute("ceilingOffsetDb", group.ceilingOffsetDb);
+    }
+    
     copyXmlToBinary(*xml, destData);
 }
 
@@ -1341,7 +2646,31 @@ void SimpleGainAudioProcessor::setStateInformation(const void* data, int sizeInB
 
     if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
     {
+        // Sessions saved before groups were stored load with every offset at 0 dB
+        GroupInfo groups[MAX_SATELLITE_GROUPS + 1];
+        if (auto* groupsXml = xmlState->getChildByName("Groups"))
+        {
+            for (auto* groupXml : groupsXml->getChildWithTagNameIterator("Group"))
+            {
+                const int groupId = groupXml->getIntAttribute("id");
+                if (groupId <= 0 || groupId > MAX_SATELLITE_GROUPS)
+                    continue;
+                
+                groups[groupId].gainOffsetDb = static_cast<float>(groupXml->getDoubleAttribute("gainOffsetDb"));
+                groups[groupId].targetOffsetDb = static_cast<float>(groupXml->getDoubleAttribute("targetOffsetDb"));
+                groups[groupId].ceilingOffsetDb = static_cast<float>(groupXml->getDoubleAttribute("ceilingOffsetDb"));
+            }
+            xmlState->removeChildElement(groupsXml, true);
+        }
+        
         parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+        
+        for (int groupId = 1; groupId <= MAX_SATELLITE_GROUPS; ++groupId)
+        {
+            setGroupGain(groupId, groups[groupId].gainOffsetDb);
+            setGroupTarget(groupId, groups[groupId].targetOffsetDb);
+            setGroupCeiling(groupId, groups[groupId].ceilingOffsetDb);
+        }
     }
 }
 
@@ -1353,6 +2682,13 @@ juce::AudioProcessorValueTreeState& SimpleGainAudioProcessor::getValueTreeState(
 void SimpleGainAudioProcessor::requestAiSuggestion(const juce::String& genre,
                                                    const juce::String& source,
                                                    const juce::String& situation)
+{
+    sendAiSuggestion(genre, source, situation, false);
+}
+
+// true if a request was sent. A speculative one is cached when it arrives, not shown.
+bool SimpleGainAudioProcessor::sendAiSuggestion(const juce::String& genre, const juce::String& source,
+                                                const juce::String& situation, bool speculative)
 {
     const auto analysis = getAnalysisSnapshot();
     
@@ -1365,6 +2701,27 @@ void SimpleGainAudioProcessor::requestAiSuggestion(const juce::String& genre,
         iface = selectedInterface;
     }
 
+    // Respect user's language selection: instruct AI to reply using the selected language
+    auto langNames = Localization::getLanguageNames();
+    auto langIdx = static_cast<int>(getLanguage());
+    juce::String langName = (langIdx >= 0 && langIdx < langNames.size()) ? langNames[langIdx] : "English";
+
+    // Same question about practically the same material: answer from the cache
+    const auto cacheKey = AiResponseCache::makeKey(getSuggestionCacheContext(genre, source, situation, langName,
+                                                                             mic, preamp, iface, analysis));
+    juce::String cachedResponse;
+    if (aiResponseCache.lookup(cacheKey, cachedResponse))
+    {
+        if (speculative)
+            return false;  // Already answered
+        if (applyAiResponseText(cachedResponse))
+        {
+            AR3S_LOG_DEBUG("AiClient", "Suggestion served from cache ({} hits so far)", aiResponseCache.getHitCount());
+            setAiStatusMessage(getAiStatus() + " [cached]");
+            return false;
+        }
+    }
+
     juce::String prompt;
     prompt << "You are a gain staging assistant for audio production. "
               "Return strict JSON only in this format: {\"gain_db\":0,\"target_db\":-18,\"rider_amount\":0.5,\"notes\":\"...\",\"satellite_gains\":[]}. "
@@ -1375,21 +2732,8 @@ void SimpleGainAudioProcessor::requestAiSuggestion(const juce::String& genre,
     prompt << "Genre: " << genre << "\n";
     prompt << "Source: " << source << "\n";
     prompt << "Situation: " << situation << "\n";
-
-    // Respect user's language selection: instruct AI to reply using the selected language
-    auto langNames = Localization::getLanguageNames();
-    auto langIdx = static_cast<int>(getLanguage());
-    juce::String langName = (langIdx >= 0 && langIdx < langNames.size()) ? langNames[langIdx] : "English";
     prompt << "Language: " << langName << ". Respond in this language and output only the JSON as specified.\n";
     
-    // Include satellite information
-    juce::String satelliteSummary = getSatellitesSummary();
-    if (!satelliteSummary.contains("No satellite"))
-    {
-        prompt << "\nSatellite Tracks (summary):\n" << satelliteSummary << "\n";
-        prompt << "\nSatellite Tracks (json):\n" << getSatellitesJsonContext() << "\n";
-    }
-    
     // Include equipment context if specified
     if (mic.isNotEmpty() && mic != "Not Specified")
         prompt << "Microphone: " << mic << "\n";
@@ -1398,38 +2742,154 @@ void SimpleGainAudioProcessor::requestAiSuggestion(const juce::String& genre,
     if (iface.isNotEmpty() && iface != "Not Specified")
         prompt << "Audio Interface: " << iface << "\n";
     
-    prompt << "Analysis: RMS " << juce::String(analysis.rmsDb, 1) << " dB, Peak "
-           << juce::String(analysis.peakDb, 1) << " dB, Crest " << juce::String(analysis.crestDb, 1) << " dB, "
-           << "Short-Term LUFS " << juce::String(shortTermLufs.load(), 1) << ", Phase " << juce::String(analysis.phaseCorrelation, 2) << ".\n";
-    
-    // Include current plugin settings
-    if (auto* gainParam = parameters.getRawParameterValue("gain"))
-        prompt << "Current Gain: " << juce::String(gainParam->load(), 1) << " dB. ";
-    if (auto* ceilingParam = parameters.getRawParameterValue("ceiling"))
-        prompt << "Ceiling: " << juce::String(ceilingParam->load(), 1) << " dB.\n";
+    // Each suggestion prompt stands alone, so it gets every track in full: a fresh
+    // builder has nothing to fold into the rest line. Only chat sends deltas.
+    AiContextBuilder suggestionContext;
+    prompt << "\nSession context (one record per line, key=value, levels in dB, '-' = not measured; "
+              "trk = satellite track by id, rest = the other tracks summarised, mask/align = track pairs):\n"
+           << buildAiContext(suggestionContext, analysis) << "\n";
     
     prompt << "Calculate gain_db = target_db - current_rms_db (clamped to -24 to +12). "
               "Consider similar current songs for this context. Target gain staging with headroom and stable vocal levels.";
 
-    if (aiClient != nullptr)
-        aiClient->request(prompt, false);
+    if (aiClient == nullptr)
+        return false;
+
+    const auto provider = getAiProvider();
+    if (speculative)
+        return aiClient->requestSpeculativeSuggestion(prompt, cacheKey) != 0;
+    if (isAiRaceMode() && provider != AiProvider::Ollama)
+        return aiClient->requestSuggestionRace(prompt, cacheKey, provider, getSelectedModel(), getRaceLocalModel()) != 0;
+    return aiClient->requestSuggestion(prompt, cacheKey) != 0;
 }
 
-void SimpleGainAudioProcessor::requestChatMessage(const juce::String& userMessage)
+// The Ollama model last chosen in settings, else the first one Ollama listed
+juce::String SimpleGainAudioProcessor::getRaceLocalModel() const
 {
-    const auto analysis = getAnalysisSnapshot();
-    
-    // Get equipment and context settings
-    juce::String mic, preamp, iface;
     {
         const juce::ScopedLock lock(settingsLock);
-        mic = selectedMic;
-        preamp = selectedPreamp;
-        iface = selectedInterface;
+        if (localModel.isNotEmpty())
+            return localModel;
     }
-    
-    // Get genre and source context
-    juce::String genre, source, situation;
+
+    const auto catalogue = getModelCatalogue(AiProvider::Ollama, {});
+    const auto cached = ModelListCache::load(catalogue.cacheName, catalogue.sourceKey);
+    return cached.valid ? cached.models[0] : juce::String("llama3");
+}
+
+// Everything a suggestion prompt depends on, with levels rounded to 1 dB (phase to
+// 0.1) so that near-identical material maps to the same cache entry
+juce::String SimpleGainAudioProcessor::getSuggestionCacheContext(const juce::String& genre, const juce::String& source,
+                                                                 const juce::String& situation, const juce::String& language,
+                                                                 const juce::String& mic, const juce::String& preamp,
+                                                                 const juce::String& iface, const AnalysisSnapshot& analysis) const
+{
+    // Measured levels go in 3 dB steps: live material drifts by a dB or two between a
+    // speculative request and the click it is meant to answer, and a suggestion
+    // that close is still the right one. Settings (the parameters below) stay exact.
+    const auto level = [] (float db) { return 3 * juce::roundToInt(db / 3.0f); };
+
+    juce::String context;
+    context << static_cast<int>(getAiProvider()) << "|" << getSelectedModel() << "|" << genre << "|" << source << "|"
+            << situation << "|" << language << "|" << mic << "|" << preamp << "|" << iface << "|"
+            << level(analysis.rmsDb) << "|" << level(analysis.peakDb) << "|"
+            << level(analysis.crestDb) << "|" << level(shortTermLufs.load()) << "|"
+            << juce::roundToInt(analysis.phaseCorrelation * 4.0f);
+
+    if (auto* gainParam = parameters.getRawParameterValue("gain"))
+        context << "|g" << juce::roundToInt(gainParam->load());
+    if (auto* ceilingParam = parameters.getRawParameterValue("ceiling"))
+        context << "|c" << juce::roundToInt(ceilingParam->load());
+
+    for (int i = 0; i < MAX_SATELLITES; ++i)
+    {
+        const auto info = getSatelliteInfo(i);
+        if (! info.active)
+            continue;
+        context << "|" << i << ":" << info.channelName << ":" << info.sourceType << ":" << info.groupId << ":"
+                << level(info.rmsDb) << ":" << level(info.peakDb) << ":"
+                << level(info.crestDb) << ":" << level(info.shortTermLufs) << ":"
+                << level(20.0f * std::log10(std::max(0.0001f, info.currentGain)));
+    }
+    return context;
+}
+
+// Master, satellite and pair data in the compact form the builder keeps under budget
+juce::String SimpleGainAudioProcessor::buildAiContext(AiContextBuilder& builder, const AnalysisSnapshot& analysis)
+{
+    builder.setTokenBudget(getAiContextTokenBudget());
+
+    AiContextMaster master;
+    master.rmsDb = analysis.rmsDb;
+    master.peakDb = analysis.peakDb;
+    master.crestDb = analysis.crestDb;
+    master.phaseCorrelation = analysis.phaseCorrelation;
+    master.shortTermLufs = shortTermLufs.load();
+    master.integratedLufs = integratedLufs.load();
+    if (auto* gainParam = parameters.getRawParameterValue("gain"))
+        master.gainDb = gainParam->load();
+    if (auto* targetParam = parameters.getRawParameterValue("auto_target_db"))
+        master.targetDb = targetParam->load();
+    if (auto* ceilingParam = parameters.getRawParameterValue("ceiling"))
+        master.ceilingDb = ceilingParam->load();
+
+    std::vector<AiContextTrack> tracks;
+    for (int i = 0; i < MAX_SATELLITES; ++i)
+    {
+        const auto info = getSatelliteInfo(i);
+        if (! info.active)
+            continue;
+
+        AiContextTrack track;
+        track.index = i;
+        track.name = info.channelName.isEmpty() ? "Track " + juce::String(i + 1) : info.channelName;
+        track.source = getSatelliteSourceName(info.sourceType);
+        if (info.groupId > 0)
+            track.group = getSatelliteGroupName(info.groupId);
+        track.rmsDb = info.rmsDb;
+        track.peakDb = info.peakDb;
+        track.crestDb = info.crestDb;
+        track.shortTermLufs = info.shortTermLufs;
+        track.truePeakDb = info.truePeakDb;
+        track.gainDb = linearToDb(info.currentGain);
+        track.phaseCorrelation = info.phaseCorrelation;
+        track.cpuPeakLoad = info.cpuPeakLoad;
+        track.overruns = info.overrunCount;
+        track.controlledByMaster = info.controlledByMaster;
+
+        const auto trend = getSatelliteHistoryStats(i, 30);
+        track.trendValid = trend.valid;
+        track.trendAvgDb = trend.avgRmsDb;
+        track.trendMinDb = trend.minRmsDb;
+        track.trendMaxDb = trend.maxRmsDb;
+        tracks.push_back(track);
+    }
+
+    std::vector<AiContextMasking> masking;
+    for (const auto& pair : getTopMaskingPairs(5))
+        masking.push_back({ pair.trackA, pair.trackB, pair.severity,
+                            pair.dominantBand >= 0 ? getAnalysisBandCentreHz(pair.dominantBand) : 0.0f });
+
+    std::vector<AiContextAlignment> alignments;
+    for (const auto& alignment : getPhaseAlignments())
+        alignments.push_back({ alignment.trackA, alignment.trackB, alignment.offsetSamples, alignment.offsetMs,
+                               alignment.polarityInverted, alignment.confidence });
+
+    const auto context = builder.build(master, tracks, masking, alignments);
+    AR3S_LOG_DEBUG("AiClient", "Context: {} tracks, ~{} tokens (budget {})", static_cast<int>(tracks.size()),
+                   AiContextBuilder::estimateTokens(context), builder.getTokenBudget());
+    return context;
+}
+
+void SimpleGainAudioProcessor::setAiContextTokenBudget(int tokens)
+{
+    const juce::ScopedLock lock(settingsLock);
+    aiContextTokenBudget = juce::jlimit(AiContextBuilder::minTokenBudget, AiContextBuilder::maxTokenBudget, tokens);
+}
+
+// The genre/source/situation choices as the editor's boxes show them
+void SimpleGainAudioProcessor::getAiContextNames(juce::String& genre, juce::String& source, juce::String& situation) const
+{
     if (auto* p = parameters.getRawParameterValue("genre"))
     {
         const char* genres[] = {"Pop", "Rock", "Hip-Hop", "R&B", "Trap", "Reggaeton", "EDM", "Jazz", "Classical", "Podcast", "Lo-Fi", "Metal", "Country", "Other"};
@@ -1448,22 +2908,32 @@ void SimpleGainAudioProcessor::requestChatMessage(const juce::String& userMessag
         int idx = static_cast<int>(p->load());
         if (idx >= 0 && idx < 4) situation = situations[idx];
     }
+}
+
+void SimpleGainAudioProcessor::requestChatMessage(const juce::String& userMessage)
+{
+    const auto analysis = getAnalysisSnapshot();
+    
+    // Get equipment and context settings
+    juce::String mic, preamp, iface;
+    {
+        const juce::ScopedLock lock(settingsLock);
+        mic = selectedMic;
+        preamp = selectedPreamp;
+        iface = selectedInterface;
+    }
+    
+    // Get genre and source context
+    juce::String genre, source, situation;
+    getAiContextNames(genre, source, situation);
+
+    // Earlier turns are resent as they were. If some had to go, the track detail
+    // sent only with them goes too, so this turn carries everything again.
+    chatConversation.makeRoom(AiConversation::estimateTokens(userMessage) + getAiContextTokenBudget() + 100);
+    if (chatConversation.takeHistoryLost())
+        chatContext.reset();
 
     juce::String prompt;
-    prompt << "You are ARES, an expert audio engineer, mixer, producer, and mastering engineer. "
-              "You are a comprehensive mixing assistant that helps with ALL aspects of music production:\n"
-              "- Gain staging and level optimization\n"
-              "- Plugin recommendations (EQ, compression, reverb, delay, saturation, etc.)\n"
-              "- Specific plugin settings and parameters\n"
-              "- Signal chain order and routing\n"
-              "- Mixing techniques for each instrument/element\n"
-              "- Frequency balance and EQ curves\n"
-              "- Compression ratios, attack, release for different sources\n"
-              "- Reverb and delay settings\n"
-              "- Stereo imaging and panning\n"
-              "- Mastering chain suggestions\n"
-              "- Reference track analysis\n"
-              "- Genre-specific production techniques\n\n";
     
     // Context data for AI awareness (internal use only - don't recite back to user)
     prompt << "[INTERNAL CONTEXT - Use this data to inform your answers but do NOT list it back to the user]\n";
@@ -1473,16 +2943,6 @@ void SimpleGainAudioProcessor::requestChatMessage(const juce::String& userMessag
     auto langIdx = static_cast<int>(getLanguage());
     juce::String langName = (langIdx >= 0 && langIdx < langNames.size()) ? langNames[langIdx] : "English";
     prompt << "Language: " << langName << ". Respond in this language when replying.\n";
-    prompt << "Levels: RMS=" << juce::String(analysis.rmsDb, 1) << "dB, Peak=" << juce::String(analysis.peakDb, 1) << "dB, ";
-    prompt << "Crest=" << juce::String(analysis.crestDb, 1) << "dB, Phase=" << juce::String(analysis.phaseCorrelation, 2) << ", ";
-    prompt << "LUFS=" << juce::String(shortTermLufs.load(), 1) << "/" << juce::String(integratedLufs.load(), 1) << ". ";
-    
-    if (auto* gainParam = parameters.getRawParameterValue("gain"))
-        prompt << "Gain=" << juce::String(gainParam->load(), 1) << "dB, ";
-    if (auto* targetParam = parameters.getRawParameterValue("auto_target_db"))
-        prompt << "Target=" << juce::String(targetParam->load(), 1) << "dB, ";
-    if (auto* ceilingParam = parameters.getRawParameterValue("ceiling"))
-        prompt << "Ceiling=" << juce::String(ceilingParam->load(), 1) << "dB. ";
     
     if (genre.isNotEmpty()) prompt << "Genre=" << genre << ", ";
     if (source.isNotEmpty()) prompt << "Source=" << source << ", ";
@@ -1491,19 +2951,19 @@ void SimpleGainAudioProcessor::requestChatMessage(const juce::String& userMessag
     if (preamp.isNotEmpty() && preamp != "Not Specified") prompt << "Pre=" << preamp << ", ";
     if (iface.isNotEmpty() && iface != "Not Specified") prompt << "Interface=" << iface << ". ";
     
-    // Include satellite tracks information
-    juce::String satelliteSummary = getSatellitesSummary();
-    if (!satelliteSummary.contains("No satellite"))
-        prompt << "Satellites: " << satelliteSummary << " ";
-    
+    // key=value records, levels in dB; trk = satellite by id, rest = the others summarised
+    prompt << "\n" << buildAiContext(chatContext, analysis);
     prompt << "[END INTERNAL CONTEXT]\n\n";
-    
-    prompt << "User: " << userMessage << "\n\n";
-    prompt << "Answer directly and concisely. Only mention the user's levels/settings if directly relevant to their question. "
-              "Don't recite back all the context data - just use it to give informed answers.";
+    prompt << userMessage;
 
-    if (aiClient != nullptr)
-        aiClient->request(prompt, true);
+    const auto turnId = chatConversation.beginTurn(prompt);
+    if (aiClient == nullptr || aiClient->requestChat(turnId) == 0)
+        chatConversation.abandonTurn(turnId);
+}
+
+void SimpleGainAudioProcessor::startNewChatConversation()
+{
+    chatConversation.clear();
 }
 
 void SimpleGainAudioProcessor::requestOllamaModelList()
@@ -1511,12 +2971,43 @@ void SimpleGainAudioProcessor::requestOllamaModelList()
     refreshModelList();
 }
 
-void SimpleGainAudioProcessor::refreshModelList()
+void SimpleGainAudioProcessor::refreshModelList(bool force)
 {
+    // The last fetched list shows straight away; the catalogue is only asked
+    // for again once it is older than its TTL (or on an explicit refresh)
+    const auto provider = getAiProvider();
+    if (provider == AiProvider::Ollama || provider == AiProvider::OpenAI || provider == AiProvider::OpenRouter)
+    {
+        const auto catalogue = getModelCatalogue(provider, getApiKey());
+        const auto cached = ModelListCache::load(catalogue.cacheName, catalogue.sourceKey);
+        if (cached.valid)
+        {
+            setAvailableModels(cached.models);
+            if (! force && juce::Time::currentTimeMillis() - cached.fetchedMs < catalogue.ttlMs)
+            {
+                setAiStatusMessage(catalogue.providerName + " ready (" + juce::String(cached.models.size()) + " models, cached)");
+                return;
+            }
+        }
+    }
+
     if (aiClient != nullptr)
         aiClient->requestModelList();
 }
 
+void SimpleGainAudioProcessor::warmUpAiProvider()
+{
+    lastAiWarmUpMs = getMonotonicMillis();
+    if (aiClient != nullptr)
+        aiClient->requestWarmUp();
+}
+
+void SimpleGainAudioProcessor::cancelAiRequests()
+{
+    if (aiClient != nullptr)
+        aiClient->cancelAll();
+}
+
 void SimpleGainAudioProcessor::applyAiRecommendation()
 {
     juce::ScopedLock lock(aiLock);
@@ -1677,7 +3168,7 @@ int SimpleGainAudioProcessor::getAvailableModelsVersion() const
     return availableModelsVersion.load();
 }
 
-void SimpleGainAudioProcessor::applyAiResponseText(const juce::String& response)
+bool SimpleGainAudioProcessor::applyAiResponseText(const juce::String& response)
 {
     juce::ScopedLock lock(aiLock);
     aiNotes = response;
@@ -1707,9 +3198,10 @@ void SimpleGainAudioProcessor::applyAiResponseText(const juce::String& response)
         if (notesVar.isString())
             aiNotes = notesVar.toString();
         
-        // Parse and apply satellite gains if provided
+        // Parse and apply satellite gains if provided (as one batch, so all tracks change together)
         if (satGainsVar.isArray())
         {
+            std::vector<std::pair<int, SatelliteControl>> satControls;
             auto* satArray = satGainsVar.getArray();
             for (int i = 0; i < satArray->size(); ++i)
             {
@@ -1725,19 +3217,22 @@ void SimpleGainAudioProcessor::applyAiResponseText(const juce::String& response)
                         SatelliteControl ctrl;
                         ctrl.gainDb = satGain;
                         ctrl.controlledByMaster = true;
-                        setSatelliteControl(track, ctrl);
+                        satControls.push_back({ track, ctrl });
                     }
                 }
             }
+            setSatelliteControls(satControls);
         }
 
         aiHasRecommendation = true;
         aiStatus = "AI suggestion ready (" + juce::String(aiGainDb, 1) + " dB)";
-        return;
+        aiResultReadyMs.store(juce::Time::getMillisecondCounterHiRes());
+        return true;
     }
 
     aiHasRecommendation = false;
     aiStatus = "AI response received (unstructured)";
+    return false;
 }
 
 void SimpleGainAudioProcessor::setAiNotesMessage(const juce::String& message)
@@ -1770,6 +3265,52 @@ void SimpleGainAudioProcessor::setChatResponseMessage(const juce::String& messag
     chatResponseVersion.fetch_add(1);
 }
 
+uint32_t SimpleGainAudioProcessor::beginChatStream()
+{
+    aiResultReadyMs.store(juce::Time::getMillisecondCounterHiRes());
+    const auto streamId = nextChatStreamId.fetch_add(1) + 1;
+    chatStream.push(AiStreamChunk::Kind::Begin, streamId);
+    return streamId;
+}
+
+void SimpleGainAudioProcessor::appendChatStream(uint32_t streamId, const juce::String& text)
+{
+    // Drops happen when no editor is open to drain the queue; note it once per reply
+    if (! chatStream.pushText(streamId, text) && droppedChatStreamId.exchange(streamId) != streamId)
+        AR3S_LOG_DEBUG("AiClient", "Chat stream {} not drained, text dropped", streamId);
+}
+
+void SimpleGainAudioProcessor::endChatStream(uint32_t streamId, const juce::String& fullText)
+{
+    {
+        // Keep getChatResponse current without bumping the version: the editor
+        // already has this reply from the stream
+        const juce::ScopedLock lock(aiLock);
+        chatResponse = fullText;
+    }
+    chatStream.push(AiStreamChunk::Kind::End, streamId);
+}
+
+bool SimpleGainAudioProcessor::popChatStreamChunk(AiStreamChunk& chunk)
+{
+    return chatStream.pop(chunk);
+}
+
+void SimpleGainAudioProcessor::discardChatStream()
+{
+    chatStream.clear();
+}
+
+void SimpleGainAudioProcessor::noteAiResultShown()
+{
+    const auto readyMs = aiResultReadyMs.exchange(0.0);
+    const auto delayMs = juce::Time::getMillisecondCounterHiRes() - readyMs;
+
+    // Longer means no editor was open when the result came in, not a slow one
+    if (readyMs > 0.0 && delayMs < 2000.0)
+        aiLatency.add(AiLatencyStats::Apply, delayMs);
+}
+
 void SimpleGainAudioProcessor::setAvailableModels(const juce::StringArray& models)
 {
     const juce::ScopedLock lock(aiLock);
@@ -1779,10 +3320,14 @@ void SimpleGainAudioProcessor::setAvailableModels(const juce::StringArray& model
 
 void SimpleGainAudioProcessor::setAiProvider(AiProvider provider)
 {
+    bool changed = false;
     {
         const juce::ScopedLock lock(settingsLock);
+        changed = currentProvider != provider;
         currentProvider = provider;
     }
+    if (changed)
+        cancelAiRequests();  // Anything in flight was for the old provider
     refreshModelList();
 }
 
@@ -1802,6 +3347,8 @@ void SimpleGainAudioProcessor::setSelectedModel(const juce::String& model)
 {
     const juce::ScopedLock lock(settingsLock);
     selectedModel = model;
+    if (currentProvider == AiProvider::Ollama)
+        localModel = model;
 }
 
 juce::String SimpleGainAudioProcessor::getSelectedModel() const
@@ -1827,6 +3374,10 @@ void SimpleGainAudioProcessor::saveSettings()
         xml->setAttribute("interface", selectedInterface);
         xml->setAttribute("language", static_cast<int>(currentLanguage));
         xml->setAttribute("theme", currentThemeIndex);
+        xml->setAttribute("aiContextTokens", aiContextTokenBudget);
+        xml->setAttribute("localModel", localModel);
+        xml->setAttribute("aiRace", aiRaceMode);
+        xml->setAttribute("aiSpeculativePerHour", speculativePerHour);
     }
     
     xml->writeTo(settingsFile);
@@ -1875,6 +3426,11 @@ void SimpleGainAudioProcessor::loadSettings()
         selectedInterface = xml->getStringAttribute("interface", "");
         currentLanguage = static_cast<Language>(xml->getIntAttribute("language", 0));
         currentThemeIndex = xml->getIntAttribute("theme", 1);  // Default to Modern Dark
+        aiContextTokenBudget = juce::jlimit(AiContextBuilder::minTokenBudget, AiContextBuilder::maxTokenBudget,
+                                            xml->getIntAttribute("aiContextTokens", AiContextBuilder::defaultTokenBudget));
+        localModel = xml->getStringAttribute("localModel", "");
+        aiRaceMode = xml->getBoolAttribute("aiRace", false);
+        speculativePerHour = juce::jlimit(0, 60, xml->getIntAttribute("aiSpeculativePerHour", defaultSpeculativePerHour));
         Localization::getInstance().setLanguage(currentLanguage);
     }
 }
@@ -1998,15 +3554,16 @@ void SimpleGainAudioProcessor::initializeSharedMemory()
         auto* data = sharedMemory.getData();
         if (data != nullptr)
         {
-            // Clear all stale satellite data from previous sessions
-            data->clearAllSatellites();
+            // Only drop slots whose host process is gone - satellites that are still
+            // alive keep their slots, so reconnecting after a master reload is instant
+            const int reaped = data->reapDeadOwners();
             data->masterInitTime.store(juce::Time::currentTimeMillis());
-            DBG("AR3S Master: Shared memory initialized and cleared");
+            AR3S_LOG_INFO("Master", "Shared memory initialized, reaped {} dead satellite slots", reaped);
         }
     }
     else
     {
-        DBG("AR3S Master: Failed to initialize shared memory");
+        AR3S_LOG_ERROR("Master", "Failed to initialize shared memory");
     }
 }
 
@@ -2017,15 +3574,13 @@ int SimpleGainAudioProcessor::getActiveSatelliteCount() const
         return 0;
     
     int count = 0;
-    auto currentTime = juce::Time::currentTimeMillis();
+    const auto currentTime = getMonotonicMillis();
     
     for (int i = 0; i < MAX_SATELLITES; ++i)
     {
-        // Check BOTH active flag AND recent update time
-        bool isActive = memData->satellites[i].active.load();
-        auto lastUpdate = memData->satellites[i].lastUpdateTime.load();
-        // Consider satellite active if marked active AND updated within last 3 seconds
-        if (isActive && (currentTime - lastUpdate < 3000))
+        // Consider satellite active if claimed AND heartbeating within the last 3 seconds.
+        // Slots of crashed hosts are reaped by the timer, so they never reach the timeout.
+        if (memData->isSlotLive(i, currentTime, 3000))
             ++count;
     }
     
@@ -2041,12 +3596,9 @@ SimpleGainAudioProcessor::SatelliteInfo SimpleGainAudioProcessor::getSatelliteIn
         return info;
     
     const auto& sat = memData->satellites[index];
-    auto currentTime = juce::Time::currentTimeMillis();
-    auto lastUpdate = sat.lastUpdateTime.load();
-    bool isActive = sat.active.load();
     
-    // Check BOTH active flag AND recent update time (within 3 seconds)
-    info.active = isActive && (currentTime - lastUpdate < 3000);
+    // Check BOTH ownership AND recent heartbeat (within 3 seconds)
+    info.active = memData->isSlotLive(index, getMonotonicMillis(), 3000);
     
     if (info.active)
     {
@@ -2057,7 +3609,21 @@ SimpleGainAudioProcessor::SatelliteInfo SimpleGainAudioProcessor::getSatelliteIn
         info.phaseCorrelation = sat.phaseCorrelation.load();
         info.currentGain = sat.currentGain.load();
         info.sourceType = sat.sourceType.load();
-        info.lastUpdateTime = lastUpdate;
+        info.groupId = juce::jlimit(0, MAX_SATELLITE_GROUPS, sat.groupId.load());
+        info.analysisProfile = sat.analysisProfile.load();
+        info.momentaryLufs = sat.momentaryLufs.load();
+        info.shortTermLufs = sat.shortTermLufs.load();
+        info.integratedLufs = sat.integratedLufs.load();
+        info.truePeakDb = sat.truePeakDb.load();
+        info.cpuAverageMicros = sat.cpuAverageMicros.load();
+        info.cpuMaxMicros = sat.cpuMaxMicros.load();
+        info.cpuAverageLoad = sat.cpuAverageLoad.load();
+        info.cpuPeakLoad = sat.cpuPeakLoad.load();
+        info.overrunCount = sat.overrunCount.load();
+        info.nearMissCount = sat.nearMissCount.load();
+        info.lastUpdateTime = sat.lastUpdateTime.load();
+        info.ownerPid = sat.ownerPid.load();
+        info.generation = sat.generation.load();
         
         // Read control values
         info.gainDb = sat.control.gainDb.load();
@@ -2071,15 +3637,205 @@ SimpleGainAudioProcessor::SatelliteInfo SimpleGainAudioProcessor::getSatelliteIn
     return info;
 }
 
+int SimpleGainAudioProcessor::getSatelliteHistory(int index, std::vector<MeterHistoryPoint>& dest, int maxFrames) const
+{
+    dest.resize(static_cast<size_t>(juce::jlimit(0, MeterHistoryRing::CAPACITY, maxFrames)));
+    
+    auto* memData = sharedMemory.getData();
+    if (!sharedMemoryConnected || memData == nullptr || index < 0 || index >= MAX_SATELLITES || dest.empty())
+    {
+        dest.clear();
+        return 0;
+    }
+    
+    const int copied = memData->satellites[index].history.read(dest.data(), static_cast<int>(dest.size()));
+    dest.resize(static_cast<size_t>(copied));
+    return copied;
+}
+
+SimpleGainAudioProcessor::SatelliteHistoryStats SimpleGainAudioProcessor::getSatelliteHistoryStats(int index, int seconds) const
+{
+    SatelliteHistoryStats stats;
+    
+    std::vector<MeterHistoryPoint> history;
+    if (getSatelliteHistory(index, history, seconds * MeterHistoryRing::RATE_HZ) == 0)
+        return stats;
+    
+    // Ignore silence so gaps between takes don't drag the average down
+    double powerSum = 0.0;
+    int counted = 0;
+    for (const auto& point : history)
+    {
+        if (point.rmsDb <= -80.0f)
+            continue;
+        
+        powerSum += std::pow(10.0, point.rmsDb / 10.0);
+        stats.minRmsDb = counted == 0 ? point.rmsDb : std::min(stats.minRmsDb, point.rmsDb);
+        stats.maxRmsDb = std::max(stats.maxRmsDb, point.rmsDb);
+        stats.maxPeakDb = std::max(stats.maxPeakDb, point.peakDb);
+        ++counted;
+    }
+    
+    if (counted == 0)
+        return {};
+    
+    stats.valid = true;
+    stats.avgRmsDb = static_cast<float>(10.0 * std::log10(powerSum / counted));
+    return stats;
+}
+
+void SimpleGainAudioProcessor::setSatelliteAudioStreaming(int index, int decimation)
+{
+    auto* memData = sharedMemory.getData();
+    if (!sharedMemoryConnected || memData == nullptr || index < 0 || index >= MAX_SATELLITES)
+        return;
+    
+    memData->satellites[index].control.audioStreamDecimation.store(juce::jlimit(0, 64, decimation));
+}
+
+int SimpleGainAudioProcessor::readSatelliteAudio(int index, int numFrames, juce::AudioBuffer<float>& dest,
+                                                 int64_t& timelineStart, int64_t alignToTimelineEnd) const
+{
+    timelineStart = -1;
+    
+    auto* memData = sharedMemory.getData();
+    if (!sharedMemoryConnected || memData == nullptr || index < 0 || index >= MAX_SATELLITES
+        || numFrames <= 0 || numFrames > SatelliteAudioRing::CAPACITY)
+        return 0;
+    
+    const auto& ring = memData->satellites[index].audio;
+    const int decimation = ring.decimation.load();
+    if (decimation <= 0)
+        return 0;
+    
+    // Default to the newest audio; when aligning, step back so the window ends at the
+    // requested host timeline position
+    auto endFrame = ring.writePosition.load();
+    if (alignToTimelineEnd >= 0)
+    {
+        const auto latestTimeline = ring.getTimelinePosition(endFrame);
+        if (latestTimeline < 0 || latestTimeline < alignToTimelineEnd)
+            return 0;
+        
+        const auto framesBack = static_cast<uint64_t>((latestTimeline - alignToTimelineEnd) / decimation);
+        if (framesBack > endFrame)
+            return 0;
+        endFrame -= framesBack;
+    }
+    
+    dest.setSize(SatelliteAudioRing::NUM_CHANNELS, numFrames, false, false, true);
+    if (!ring.read(endFrame, numFrames, dest.getArrayOfWritePointers(), dest.getNumChannels()))
+        return 0;
+    
+    timelineStart = ring.getTimelinePosition(endFrame - static_cast<uint64_t>(numFrames));
+    return numFrames;
+}
+
+SimpleGainAudioProcessor::BusPrediction SimpleGainAudioProcessor::predictSummedBus(int numFrames) const
+{
+    BusPrediction prediction;
+    
+    auto* memData = sharedMemory.getData();
+    if (!sharedMemoryConnected || memData == nullptr)
+        return prediction;
+    
+    // Collect streaming satellites that share the first one's decimation, and the
+    // latest host timeline position they all have audio for
+    std::vector<int> streaming;
+    int decimation = 0;
+    int64_t commonEnd = std::numeric_limits<int64_t>::max();
+    const auto currentTime = getMonotonicMillis();
+    
+    for (int i = 0; i < MAX_SATELLITES; ++i)
+    {
+        if (!memData->isSlotLive(i, currentTime, 3000))
+            continue;
+        
+        ++prediction.numLiveTracks;
+        const auto& ring = memData->satellites[i].audio;
+        const int satDecimation = ring.decimation.load();
+        if (satDecimation <= 0 || (decimation != 0 && satDecimation != decimation))
+            continue;
+        
+        decimation = satDecimation;
+        streaming.push_back(i);
+        
+        const auto latestTimeline = ring.getTimelinePosition(ring.writePosition.load());
+        commonEnd = (latestTimeline < 0 || commonEnd < 0) ? -1 : std::min(commonEnd, latestTimeline);
+    }
+    
+    if (streaming.empty())
+        return prediction;
+    
+    // Without a running transport (commonEnd == -1) there's nothing to align on, so
+    // the newest audio of each track is summed
+    const int64_t alignTo = commonEnd;
+    
+    juce::AudioBuffer<float> sum(SatelliteAudioRing::NUM_CHANNELS, numFrames);
+    juce::AudioBuffer<float> track;
+    sum.clear();
+    
+    for (int index : streaming)
+    {
+        int64_t timelineStart = -1;
+        if (readSatelliteAudio(index, numFrames, track, timelineStart, alignTo) != numFrames)
+            continue;
+        
+        for (int ch = 0; ch < sum.getNumChannels(); ++ch)
+            sum.addFrom(ch, 0, track, ch, 0, numFrames);
+        ++prediction.numTracks;
+    }
+    
+    if (prediction.numTracks == 0)
+        return prediction;
+    
+    float sumSquares = 0.0f;
+    for (int ch = 0; ch < sum.getNumChannels(); ++ch)
+    {
+        const auto* data = sum.getReadPointer(ch);
+        for (int i = 0; i < numFrames; ++i)
+            sumSquares += data[i] * data[i];
+    }
+    
+    prediction.valid = true;
+    prediction.rmsDb = linearToDb(std::sqrt(sumSquares / static_cast<float>(sum.getNumChannels() * numFrames)));
+    prediction.peakDb = linearToDb(sum.getMagnitude(0, numFrames));
+    return prediction;
+}
+
 void SimpleGainAudioProcessor::setSatelliteControl(int index, const SatelliteControl& control)
 {
     auto* memData = sharedMemory.getData();
     if (!sharedMemoryConnected || memData == nullptr || index < 0 || index >= MAX_SATELLITES)
         return;
 
-    auto& sat = memData->satellites[index];
+    const juce::ScopedLock lock(commandLock);
+    queueSatelliteControl(*memData, index, control, 0);
+}
+
+void SimpleGainAudioProcessor::setSatelliteControls(const std::vector<std::pair<int, SatelliteControl>>& controls)
+{
+    auto* memData = sharedMemory.getData();
+    if (!sharedMemoryConnected || memData == nullptr || controls.empty())
+        return;
+    
+    // Satellites hold back batched commands until the batch is committed, so every
+    // track picks up its change in the same processing cycle
+    const juce::ScopedLock lock(commandLock);
+    const auto batchId = memData->allocateBatchId();
+    for (const auto& [index, control] : controls)
+        if (index >= 0 && index < MAX_SATELLITES)
+            queueSatelliteControl(*memData, index, control, batchId);
+    
+    memData->commitBatch(batchId);
+}
+
+void SimpleGainAudioProcessor::queueSatelliteControl(SharedPluginData& memData, int index,
+                                                     const SatelliteControl& control, uint32_t batchId)
+{
+    auto& sat = memData.satellites[index];
 
-    // Set all values, enable per-satellite override
+    // Control block for display (the global push may rewrite it later)
     sat.control.gainDb.store(control.gainDb);
     sat.control.targetDb.store(control.targetDb);
     sat.control.ceilingDb.store(control.ceilingDb);
@@ -2087,7 +3843,24 @@ void SimpleGainAudioProcessor::setSatelliteControl(int index, const SatelliteCon
     sat.control.riderAmount.store(control.riderAmount);
     sat.control.perSatelliteOverride.store(true);
     sat.control.controlledByMaster.store(false); // Only one mode active
-    sat.control.controlUpdateTime.store(juce::Time::currentTimeMillis());
+    sat.control.controlUpdateTime.store(getMonotonicMillis());
+    
+    SatelliteCommand command;
+    command.type = SatelliteCommandType::SetControl;
+    command.batchId = batchId;
+    command.gainDb = control.gainDb;
+    command.targetDb = control.targetDb;
+    command.ceilingDb = control.ceilingDb;
+    command.riderAmount = control.riderAmount;
+    command.autoEnabled = control.autoEnabled;
+    command.issuedAtUs = getMonotonicMicros();
+    sat.lastCommand.store(command);  // Snapshot first - it is what the satellite resyncs from
+    ipcCommandsSent.fetch_add(1);
+    if (!sat.commands.push(command))
+    {
+        ipcCommandsDropped.fetch_add(1);
+        AR3S_LOG_WARNING("Master", "Command queue full for slot {}, satellite will resync", index);
+    }
 }
 
 void SimpleGainAudioProcessor::releaseSatelliteControl(int index)
@@ -2096,18 +3869,138 @@ void SimpleGainAudioProcessor::releaseSatelliteControl(int index)
     if (!sharedMemoryConnected || memData == nullptr || index < 0 || index >= MAX_SATELLITES)
         return;
     
-    memData->satellites[index].control.perSatelliteOverride.store(false);
-    memData->satellites[index].control.controlledByMaster.store(false);
+    const juce::ScopedLock lock(commandLock);
+    auto& sat = memData->satellites[index];
+    sat.control.perSatelliteOverride.store(false);
+    sat.control.controlledByMaster.store(false);
+    
+    SatelliteCommand command;
+    command.type = SatelliteCommandType::ReleaseControl;
+    command.issuedAtUs = getMonotonicMicros();
+    sat.lastCommand.store(command);
+    ipcCommandsSent.fetch_add(1);
+    if (!sat.commands.push(command))
+        ipcCommandsDropped.fetch_add(1);
 }
 
-juce::String SimpleGainAudioProcessor::getSatellitesSummary() const
+SimpleGainAudioProcessor::IpcStats SimpleGainAudioProcessor::getIpcStats() const
+{
+    IpcStats stats;
+    stats.commandsSent = ipcCommandsSent.load();
+    stats.commandsDropped = ipcCommandsDropped.load();
+    stats.sweepMicros = ipcSweepMicros.load();
+    
+    auto* memData = sharedMemory.getData();
+    if (!sharedMemoryConnected || memData == nullptr)
+        return stats;
+    
+    // Sum the live satellites' histograms
+    uint64_t counts[IpcLatencyHistogram::NUM_BUCKETS] {};
+    uint64_t total = 0;
+    const auto nowMs = getMonotonicMillis();
+    for (int i = 0; i < MAX_SATELLITES; ++i)
+    {
+        if (!memData->isSlotLive(i, nowMs, 3000))
+            continue;
+        
+        ++stats.liveSlots;
+        const auto& histogram = memData->satellites[i].commandLatency;
+        for (int b = 0; b < IpcLatencyHistogram::NUM_BUCKETS; ++b)
+        {
+            const auto count = histogram.counts[b].load(std::memory_order_relaxed);
+            counts[b] += count;
+            total += count;
+        }
+    }
+    
+    stats.latencySamples = static_cast<uint32_t>(std::min<uint64_t>(total, UINT32_MAX));
+    if (total == 0)
+        return stats;
+    
+    auto percentileMs = [&counts, total](double fraction)
+    {
+        const auto rank = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(total)));
+        uint64_t seen = 0;
+        for (int b = 0; b < IpcLatencyHistogram::NUM_BUCKETS; ++b)
+        {
+            seen += counts[b];
+            if (seen >= rank)
+                return static_cast<float>(IpcLatencyHistogram::bucketLimitUs(b)) / 1000.0f;
+        }
+        return static_cast<float>(IpcLatencyHistogram::bucketLimitUs(IpcLatencyHistogram::NUM_BUCKETS - 1)) / 1000.0f;
+    };
+    
+    stats.latencyP50Ms = percentileMs(0.50);
+    stats.latencyP90Ms = percentileMs(0.90);
+    stats.latencyP99Ms = percentileMs(0.99);
+    stats.latencyMaxMs = percentileMs(1.0);
+    return stats;
+}
+
+SimpleGainAudioProcessor::MaskingSnapshot SimpleGainAudioProcessor::getMaskingSnapshot() const
+{
+    const juce::ScopedLock lock(maskingLock);
+    return maskingSnapshot;
+}
+
+std::vector<SimpleGainAudioProcessor::MaskingPair> SimpleGainAudioProcessor::getTopMaskingPairs(int maxPairs, float minSeverity) const
 {
-    // Source type names for better AI context
-    const char* sourceNames[] = { "Vocals", "Background Vocals", "Kick", "Snare", "Hi-Hat", 
-                                  "Drums", "Bass", "Electric Guitar", "Acoustic Guitar", 
-                                  "Keys/Piano", "Synth", "Strings", "Other" };
-    const int numSourceNames = 13;
+    const auto snapshot = getMaskingSnapshot();
     
+    std::vector<MaskingPair> pairs;
+    for (int a = 0; a < MAX_SATELLITES; ++a)
+    {
+        if (!snapshot.active[(size_t) a])
+            continue;
+        
+        for (int b = a + 1; b < MAX_SATELLITES; ++b)
+        {
+            if (snapshot.active[(size_t) b] && snapshot.getSeverity(a, b) >= minSeverity)
+                pairs.push_back({ a, b, snapshot.getSeverity(a, b), snapshot.getDominantBand(a, b) });
+        }
+    }
+    
+    std::sort(pairs.begin(), pairs.end(), [](const MaskingPair& x, const MaskingPair& y) { return x.severity > y.severity; });
+    if (static_cast<int>(pairs.size()) > maxPairs)
+        pairs.resize(static_cast<size_t>(std::max(0, maxPairs)));
+    
+    return pairs;
+}
+
+void SimpleGainAudioProcessor::setSatellitePhaseCheck(int index, bool enabled)
+{
+    if (index < 0 || index >= MAX_SATELLITES)
+        return;
+    
+    const auto bit = 1u << index;
+    if (enabled)
+        phaseCheckMask.fetch_or(bit);
+    else
+        phaseCheckMask.fetch_and(~bit);
+    
+    // Sample-accurate offsets need the undecimated signal
+    setSatelliteAudioStreaming(index, enabled ? 1 : 0);
+}
+
+bool SimpleGainAudioProcessor::isSatellitePhaseCheckEnabled(int index) const
+{
+    return index >= 0 && index < MAX_SATELLITES && (phaseCheckMask.load() & (1u << index)) != 0;
+}
+
+std::vector<SimpleGainAudioProcessor::PhaseAlignment> SimpleGainAudioProcessor::getPhaseAlignments() const
+{
+    const juce::ScopedLock lock(phaseLock);
+    return phaseAlignments;
+}
+
+SimpleGainAudioProcessor::BusPrediction SimpleGainAudioProcessor::getBusPrediction() const
+{
+    const juce::ScopedLock lock(phaseLock);
+    return busPrediction;
+}
+
+juce::String SimpleGainAudioProcessor::getSatellitesSummary() const
+{
     juce::String summary;
     int activeCount = 0;
     
@@ -2123,8 +4016,12 @@ juce::String SimpleGainAudioProcessor::getSatellitesSummary() const
             summary << "- " << trackName;
             
             // Source type in parentheses
-            if (info.sourceType >= 0 && info.sourceType < numSourceNames)
-                summary << " (" << sourceNames[info.sourceType] << ")";
+            const auto sourceName = getSatelliteSourceName(info.sourceType);
+            if (sourceName.isNotEmpty())
+                summary << " (" << sourceName << ")";
+            
+            if (info.groupId > 0)
+                summary << " [" << getSatelliteGroupName(info.groupId) << " group]";
             
             summary << ": ";
             
@@ -2132,16 +4029,31 @@ juce::String SimpleGainAudioProcessor::getSatellitesSummary() const
             summary << "RMS " << juce::String(info.rmsDb, 1) << "dB, ";
             summary << "Peak " << juce::String(info.peakDb, 1) << "dB, ";
             summary << "Crest " << juce::String(info.crestDb, 1) << "dB";
+            if (info.shortTermLufs > -70.0f)
+                summary << ", " << juce::String(info.shortTermLufs, 1) << " LUFS-S, True Peak "
+                        << juce::String(info.truePeakDb, 1) << " dBTP";
             
             // Current gain adjustment
             float gainDb = 20.0f * std::log10(std::max(0.0001f, info.currentGain));
             if (std::abs(gainDb) > 0.1f)
                 summary << ", Gain " << (gainDb >= 0 ? "+" : "") << juce::String(gainDb, 1) << "dB";
             
+            // Loudness trend over the last 30 seconds
+            auto trend = getSatelliteHistoryStats(i, 30);
+            if (trend.valid)
+                summary << ", 30s avg " << juce::String(trend.avgRmsDb, 1) << "dB (range "
+                        << juce::String(trend.minRmsDb, 1) << " to " << juce::String(trend.maxRmsDb, 1) << ")";
+            
             // Phase correlation warning
             if (info.phaseCorrelation < 0.3f)
                 summary << " [Phase issues!]";
             
+            // A single track eating half the block deadline is a dropout risk
+            if (info.cpuPeakLoad >= 0.5f)
+                summary << " [CPU peak " << juce::String(info.cpuPeakLoad * 100.0f, 0) << "% of block time]";
+            if (info.overrunCount > 0)
+                summary << " [" << juce::String(info.overrunCount) << " block overruns]";
+            
             if (info.controlledByMaster)
                 summary << " [Master controlled]";
                 
@@ -2154,6 +4066,52 @@ juce::String SimpleGainAudioProcessor::getSatellitesSummary() const
     else
         summary << "\n(Total: " << activeCount << " active satellite tracks)";
     
+    // Tracks competing for the same frequency bands
+    auto maskingPairs = getTopMaskingPairs(5);
+    if (!maskingPairs.empty())
+    {
+        summary << "\nFrequency masking (0-100%):";
+        for (const auto& pair : maskingPairs)
+        {
+            auto nameA = getSatelliteInfo(pair.trackA).channelName;
+            auto nameB = getSatelliteInfo(pair.trackB).channelName;
+            if (nameA.isEmpty()) nameA = "Track " + juce::String(pair.trackA + 1);
+            if (nameB.isEmpty()) nameB = "Track " + juce::String(pair.trackB + 1);
+            summary << "\n- " << nameA << " vs " << nameB << ": " << juce::roundToInt(pair.severity * 100.0f) << "%";
+            if (pair.dominantBand >= 0)
+                summary << " around " << getAnalysisBandLabel(pair.dominantBand) << "Hz";
+        }
+    }
+    
+    // Inter-track timing/polarity of phase-checked multi-mic sources
+    bool phaseHeader = false;
+    for (const auto& alignment : getPhaseAlignments())
+    {
+        if (alignment.confidence < 0.5f)
+            continue;
+        
+        if (!phaseHeader)
+        {
+            summary << "\nMulti-mic phase check:";
+            phaseHeader = true;
+        }
+        
+        auto nameA = getSatelliteInfo(alignment.trackA).channelName;
+        auto nameB = getSatelliteInfo(alignment.trackB).channelName;
+        if (nameA.isEmpty()) nameA = "Track " + juce::String(alignment.trackA + 1);
+        if (nameB.isEmpty()) nameB = "Track " + juce::String(alignment.trackB + 1);
+        summary << "\n- " << nameB << " vs " << nameA << ": " << (alignment.offsetSamples >= 0 ? "+" : "")
+                << alignment.offsetSamples << " samples (" << juce::String(alignment.offsetMs, 2) << " ms)"
+                << (alignment.polarityInverted ? ", POLARITY INVERTED" : ", polarity OK")
+                << ", confidence " << juce::roundToInt(alignment.confidence * 100.0f) << "%";
+    }
+    
+    // What the streamed tracks add up to before they reach the bus
+    const auto bus = getBusPrediction();
+    if (bus.valid && bus.numTracks >= 2)
+        summary << "\nPredicted bus from " << bus.numTracks << " of " << bus.numLiveTracks << " tracks (streamed only): RMS "
+                << juce::String(bus.rmsDb, 1) << " dB, peak " << juce::String(bus.peakDb, 1) << " dB";
+    
     return summary;
 }
 
@@ -2171,13 +4129,16 @@ void SimpleGainAudioProcessor::setAllSatellitesGain(float gainDb)
             auto& sat = memData->satellites[i];
             sat.control.gainDb.store(gainDb);
             sat.control.controlledByMaster.store(true);
-            sat.control.controlUpdateTime.store(juce::Time::currentTimeMillis());
+            sat.control.controlUpdateTime.store(getMonotonicMillis());
         }
     }
 }
 
 void SimpleGainAudioProcessor::setAllSatellitesTarget(float targetDb)
 {
+    // Continuous auto-balance follows the global target
+    gainSolverTargetDb.store(targetDb);
+    
     auto* memData = sharedMemory.getData();
     if (!sharedMemoryConnected || memData == nullptr)
         return;
@@ -2190,7 +4151,7 @@ void SimpleGainAudioProcessor::setAllSatellitesTarget(float targetDb)
             auto& sat = memData->satellites[i];
             sat.control.targetDb.store(targetDb);
             sat.control.controlledByMaster.store(true);
-            sat.control.controlUpdateTime.store(juce::Time::currentTimeMillis());
+            sat.control.controlUpdateTime.store(getMonotonicMillis());
         }
     }
 }
@@ -2209,34 +4170,236 @@ void SimpleGainAudioProcessor::setAllSatellitesCeiling(float ceilingDb)
             auto& sat = memData->satellites[i];
             sat.control.ceilingDb.store(ceilingDb);
             sat.control.controlledByMaster.store(true);
-            sat.control.controlUpdateTime.store(juce::Time::currentTimeMillis());
+            sat.control.controlUpdateTime.store(getMonotonicMillis());
         }
     }
 }
 
 void SimpleGainAudioProcessor::autoGainAllSatellites(float targetDb)
+{
+    solveSatelliteGains(targetDb, false);
+}
+
+void SimpleGainAudioProcessor::setContinuousGainSolving(bool enabled, float targetDb)
+{
+    gainSolverTargetDb.store(targetDb);
+    continuousGainSolving.store(enabled);
+}
+
+SimpleGainAudioProcessor::GainSolverReport SimpleGainAudioProcessor::getGainSolverReport() const
+{
+    const juce::ScopedLock lock(gainSolverLock);
+    return gainSolverReport;
+}
+
+void SimpleGainAudioProcessor::solveSatelliteGains(float targetDb, bool onlyIfChanged)
 {
     auto* memData = sharedMemory.getData();
     if (!sharedMemoryConnected || memData == nullptr)
         return;
     
+    // Balance relative to the target per source type (same order as the source
+    // names), and how firmly each type holds its level when the bus forces a compromise
+    static constexpr float sourceOffsetDb[] = { 0.0f, -6.0f, -2.0f, -3.0f, -10.0f, -2.0f, -3.0f,
+                                                -5.0f, -5.0f, -6.0f, -6.0f, -7.0f, -6.0f };
+    static constexpr float sourceWeight[] = { 4.0f, 1.5f, 2.0f, 2.0f, 1.0f, 2.0f, 2.5f,
+                                              1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+    constexpr int numSourceTypes = 13;
+    
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    const juce::ScopedLock lock(gainSolverLock);
+    
+    // Levels, peaks and the hold after a gain change all cover the short-term window
+    constexpr int64_t levelWindowMs = 3000;
+    const auto now = getMonotonicMillis();
+    
+    std::vector<int> indices;
+    std::vector<SatelliteInfo> infos;
+    std::vector<GainSolverTrack> tracks;
+    
     for (int i = 0; i < MAX_SATELLITES; ++i)
     {
         auto info = getSatelliteInfo(i);
-        if (info.active)
+        if (!info.active || info.generation != solverGeneration[i])
         {
-            // Calculate gain needed to reach target
-            float neededGain = targetDb - info.rmsDb;
-            neededGain = juce::jlimit(-24.0f, 12.0f, neededGain);
-            
-            auto& sat = memData->satellites[i];
-            sat.control.gainDb.store(neededGain);
-            sat.control.targetDb.store(targetDb);
-            sat.control.autoEnabled.store(true);
-            sat.control.controlledByMaster.store(true);
-            sat.control.controlUpdateTime.store(juce::Time::currentTimeMillis());
+            solverSlotValid[i] = false;
+            solverGeneration[i] = info.generation;
+            solverPeakMs[i] = 0;
+            solverGainChangeMs[i] = 0;
+        }
+        
+        // Silent tracks keep whatever gain they have
+        if (!info.active || info.rmsDb < -60.0f)
+            continue;
+        
+        // Pre-gain level doesn't move when we change the gain, so it is what gets
+        // smoothed. One-shot solves use the last 3 s of history instead.
+        const float appliedGainDb = linearToDb(info.currentGain);
+        if (solverSlotValid[i] && std::abs(appliedGainDb - solverAppliedGainDb[i]) >= 0.1f)
+            solverGainChangeMs[i] = now;
+        solverAppliedGainDb[i] = appliedGainDb;
+        
+        // Until the window has refilled at the new gain (the satellite also ramps to
+        // it), level minus gain mixes old and new audio, so keep the last estimate
+        // rather than chase our own change
+        const bool settling = onlyIfChanged && solverSlotValid[i] && now - solverGainChangeMs[i] < levelWindowMs;
+        
+        const bool hasLoudness = info.shortTermLufs > -70.0f;
+        float preLevelDb = info.rmsDb - appliedGainDb;
+        float prePeakDb = info.peakDb - appliedGainDb;
+        if (hasLoudness)
+        {
+            // Satellite measured K-weighted loudness itself: short-term is already a
+            // 3 s window, and K-weighted power sums on the bus just like RMS does
+            preLevelDb = info.shortTermLufs - appliedGainDb;
+            prePeakDb = info.truePeakDb - appliedGainDb;
+        }
+        
+        if (settling)
+        {
+            preLevelDb = solverPreLevelDb[i];
+            prePeakDb = solverPrePeakDb[i];
+        }
+        else if (onlyIfChanged)
+        {
+            if (solverSlotValid[i])
+                preLevelDb = 0.8f * solverPreLevelDb[i] + 0.2f * preLevelDb;
+        }
+        else
+        {
+            auto trend = getSatelliteHistoryStats(i, 3);
+            if (!hasLoudness && trend.valid && trend.avgRmsDb > -60.0f)
+                preLevelDb = trend.avgRmsDb - appliedGainDb;
+            if (trend.valid)
+                prePeakDb = std::max(prePeakDb, trend.maxPeakDb - appliedGainDb);
+        }
+        
+        // The published peak covers one 100 ms block, so hold it across the level
+        // window: crest is then peak over level measured on the same 3 s
+        if (!settling)
+        {
+            if (solverPeakMs[i] != 0 && now - solverPeakMs[i] < levelWindowMs && solverPrePeakDb[i] > prePeakDb)
+                prePeakDb = solverPrePeakDb[i];
+            else
+                solverPeakMs[i] = now;
         }
+        const float crestDb = prePeakDb - preLevelDb;
+        solverPreLevelDb[i] = preLevelDb;
+        solverPrePeakDb[i] = prePeakDb;
+        
+        const int type = juce::jlimit(0, numSourceTypes - 1, info.sourceType);
+        GainSolverTrack track;
+        track.levelDb = preLevelDb;
+        track.crestDb = std::max(0.0f, crestDb);
+        track.desiredGainDb = targetDb + sourceOffsetDb[type] - preLevelDb;
+        track.weight = sourceWeight[type];
+        
+        indices.push_back(i);
+        infos.push_back(info);
+        tracks.push_back(track);
+    }
+    
+    // Bus constraints: the LUFS target when LUFS mode is on, and the master ceiling
+    // less 1 dB of margin for inter-sample (true) peaks
+    float busTargetDb = -200.0f;
+    if (auto* lufsEnabled = parameters.getRawParameterValue("lufs_enabled"))
+        if (lufsEnabled->load() > 0.5f)
+            if (auto* lufsTarget = parameters.getRawParameterValue("lufs_target"))
+                busTargetDb = lufsTarget->load();
+    
+    float busPeakLimitDb = -1.0f;
+    if (auto* ceilingParam = parameters.getRawParameterValue("ceiling"))
+        busPeakLimitDb = ceilingParam->load() - 1.0f;
+    
+    std::vector<float> gains;
+    const auto result = GainStagingSolver::solve(tracks, busTargetDb, busPeakLimitDb, gains);
+    
+    std::vector<std::pair<int, SatelliteControl>> controls;
+    for (size_t n = 0; n < indices.size(); ++n)
+    {
+        const int i = indices[n];
+        const bool changed = !solverSlotValid[i] || std::abs(gains[n] - solvedGainDb[i]) >= 0.1f;
+        solverSlotValid[i] = true;
+        if (onlyIfChanged && !changed)
+            continue;
+        
+        solvedGainDb[i] = gains[n];
+        
+        // The solver owns the gain, so the satellite's own auto-gain is switched off
+        SatelliteControl control;
+        control.gainDb = gains[n];
+        control.targetDb = targetDb + sourceOffsetDb[juce::jlimit(0, numSourceTypes - 1, infos[n].sourceType)];
+        control.ceilingDb = infos[n].ceilingDb;
+        control.autoEnabled = false;
+        control.riderAmount = infos[n].riderAmount;
+        controls.push_back({ i, control });
+    }
+    setSatelliteControls(controls);
+    
+    gainSolverReport.valid = result.valid;
+    gainSolverReport.numTracks = static_cast<int>(tracks.size());
+    gainSolverReport.busLevelDb = result.busLevelDb;
+    gainSolverReport.busPeakDb = result.busPeakDb;
+    gainSolverReport.peakLimited = result.peakLimited;
+    gainSolverReport.solveTimeMs = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+}
+
+void SimpleGainAudioProcessor::setGroupGain(int groupId, float offsetDb)
+{
+    if (groupId <= 0 || groupId > MAX_SATELLITE_GROUPS)
+        return;
+    
+    {
+        const juce::ScopedLock lock(settingsLock);
+        groupOffsets[groupId].gainOffsetDb = juce::jlimit(-24.0f, 12.0f, offsetDb);
+    }
+    publishGroup(groupId);
+}
+
+void SimpleGainAudioProcessor::setGroupTarget(int groupId, float offsetDb)
+{
+    if (groupId <= 0 || groupId > MAX_SATELLITE_GROUPS)
+        return;
+    
+    {
+        const juce::ScopedLock lock(settingsLock);
+        groupOffsets[groupId].targetOffsetDb = juce::jlimit(-24.0f, 24.0f, offsetDb);
+    }
+    publishGroup(groupId);
+}
+
+void SimpleGainAudioProcessor::setGroupCeiling(int groupId, float offsetDb)
+{
+    if (groupId <= 0 || groupId > MAX_SATELLITE_GROUPS)
+        return;
+    
+    {
+        const juce::ScopedLock lock(settingsLock);
+        groupOffsets[groupId].ceilingOffsetDb = juce::jlimit(-24.0f, 0.0f, offsetDb);
     }
+    publishGroup(groupId);
+}
+
+SimpleGainAudioProcessor::GroupInfo SimpleGainAudioProcessor::getGroupInfo(int groupId) const
+{
+    if (groupId <= 0 || groupId > MAX_SATELLITE_GROUPS)
+        return {};
+    
+    const juce::ScopedLock lock(settingsLock);
+    return groupOffsets[groupId];
+}
+
+void SimpleGainAudioProcessor::publishGroup(int groupId)
+{
+    auto* memData = sharedMemory.getData();
+    if (!sharedMemoryConnected || memData == nullptr)
+        return;
+    
+    const auto info = getGroupInfo(groupId);
+    auto& group = memData->groups[groupId];
+    group.gainOffsetDb.store(info.gainOffsetDb);
+    group.targetOffsetDb.store(info.targetOffsetDb);
+    group.ceilingOffsetDb.store(info.ceilingOffsetDb);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
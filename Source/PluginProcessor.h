@@ -2,10 +2,24 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include <deque>
 #include "SharedMemory.h"
+#include "SatelliteAnalysis.h"
+#include "GainSolver.h"
+#include "AiStreaming.h"
+#include "AiResponseCache.h"
+#include "AiContextBuilder.h"
+#include "AiConversation.h"
+#include "AiModelList.h"
+#include "AiLatencyStats.h"
+#include "PerformanceMonitor.h"
+#include "TraceRecorder.h"
 #include "Localization.h"
+#include "DataDirectory.h"
 
-class SimpleGainAudioProcessor : public juce::AudioProcessor
+class SimpleGainAudioProcessor : public juce::AudioProcessor,
+                                 private juce::AudioProcessorValueTreeState::Listener,
+                                 private juce::Timer
 {
 public:
     struct AnalysisSnapshot
@@ -53,7 +67,21 @@ public:
         float phaseCorrelation = 1.0f;
         float currentGain = 1.0f;
         int sourceType = 0;
-        int64_t lastUpdateTime = 0;
+        int groupId = 0;              // 0 = not in a group
+        int analysisProfile = 2;      // 0=Lite, 1=Standard, 2=Full (computed on the satellite)
+        float momentaryLufs = -120.0f;  // -120 when the profile doesn't measure loudness
+        float shortTermLufs = -120.0f;
+        float integratedLufs = -120.0f;
+        float truePeakDb = -120.0f;
+        float cpuAverageMicros = 0.0f;  // processBlock cost over the last ~1 s
+        float cpuMaxMicros = 0.0f;
+        float cpuAverageLoad = 0.0f;    // Fraction of the block deadline
+        float cpuPeakLoad = 0.0f;
+        uint32_t overrunCount = 0;      // Blocks past their deadline
+        uint32_t nearMissCount = 0;
+        int64_t lastUpdateTime = 0;   // Heartbeat (monotonic ms)
+        int32_t ownerPid = 0;         // Host process owning the slot
+        uint32_t generation = 0;      // Slot ownership generation
         
         // Control values
         float gainDb = 0.0f;
@@ -64,6 +92,108 @@ public:
         bool controlledByMaster = false;
     };
     
+    // Loudness trend over a satellite's recent history
+    struct SatelliteHistoryStats
+    {
+        bool valid = false;
+        float avgRmsDb = -120.0f;   // Power average
+        float minRmsDb = -120.0f;
+        float maxRmsDb = -120.0f;
+        float maxPeakDb = -120.0f;
+    };
+    
+    // Level of the summed satellite bus, predicted from streamed satellite audio.
+    // Only streaming tracks are summed, so it is partial when numTracks < numLiveTracks.
+    struct BusPrediction
+    {
+        bool valid = false;
+        int numTracks = 0;       // Tracks in the sum
+        int numLiveTracks = 0;   // Every live satellite, streaming or not
+        float rmsDb = -120.0f;
+        float peakDb = -120.0f;
+    };
+    
+    // Cross-track frequency masking between satellites (symmetric, indexed by slot)
+    struct MaskingSnapshot
+    {
+        std::array<bool, MAX_SATELLITES> active {};
+        std::array<float, MAX_SATELLITES * MAX_SATELLITES> severity {};      // 0..1
+        std::array<int8_t, MAX_SATELLITES * MAX_SATELLITES> dominantBand {}; // -1 = none
+        uint32_t version = 0;  // Bumped whenever any entry changes
+        
+        float getSeverity(int a, int b) const { return severity[(size_t) (a * MAX_SATELLITES + b)]; }
+        int getDominantBand(int a, int b) const { return dominantBand[(size_t) (a * MAX_SATELLITES + b)]; }
+    };
+    
+    struct MaskingPair
+    {
+        int trackA = -1;
+        int trackB = -1;
+        float severity = 0.0f;
+        int dominantBand = -1;
+    };
+    
+    // Time offset / polarity between two phase-checked satellites (GCC-PHAT)
+    struct PhaseAlignment
+    {
+        int trackA = -1;
+        int trackB = -1;
+        int offsetSamples = 0;         // > 0: track B arrives later than track A
+        float offsetMs = 0.0f;
+        bool polarityInverted = false;
+        float confidence = 0.0f;       // 0..1
+    };
+    
+    // Outcome of the last joint gain-staging solve
+    struct GainSolverReport
+    {
+        bool valid = false;
+        int numTracks = 0;
+        float busLevelDb = -120.0f;
+        float busPeakDb = -120.0f;
+        bool peakLimited = false;
+        double solveTimeMs = 0.0;
+    };
+    
+    // Shared-memory IPC health: command propagation latency (from the satellites'
+    // histograms), queue throughput and what one full slot sweep costs the master
+    struct IpcStats
+    {
+        int liveSlots = 0;
+        uint64_t commandsSent = 0;
+        uint64_t commandsDropped = 0;   // Queue full - satellite resynced from the snapshot
+        uint32_t latencySamples = 0;
+        float latencyP50Ms = 0.0f;      // Percentiles are bucket upper bounds
+        float latencyP90Ms = 0.0f;
+        float latencyP99Ms = 0.0f;
+        float latencyMaxMs = 0.0f;
+        float sweepMicros = 0.0f;       // getSatelliteInfo over every slot (smoothed)
+    };
+    
+    // Long-session health: slot churn across all hosts plus this process's memory,
+    // so soak runs can show whether instances or memory are leaking
+    struct SessionHealth
+    {
+        double uptimeMinutes = 0.0;
+        uint64_t slotClaims = 0;
+        uint64_t slotTakeovers = 0;
+        uint64_t slotReleases = 0;
+        uint64_t slotsReaped = 0;
+        uint64_t slotClaimFailures = 0;
+        float residentMb = 0.0f;       // 0 when the platform doesn't report it
+        float residentStartMb = 0.0f;
+        float residentPeakMb = 0.0f;
+        float growthMbPerHour = 0.0f;  // From the 10-minute mark (past warm-up), once 10 more have run
+    };
+    
+    // Group-level offsets applied on top of each member's own settings
+    struct GroupInfo
+    {
+        float gainOffsetDb = 0.0f;
+        float targetOffsetDb = 0.0f;
+        float ceilingOffsetDb = 0.0f;
+    };
+    
     // Satellite control structure
     struct SatelliteControl
     {
@@ -110,7 +240,10 @@ public:
                              const juce::String& source,
                              const juce::String& situation);
     void requestChatMessage(const juce::String& userMessage);  // Free-form chat
+    void startNewChatConversation();  // Forgets the earlier turns
     void requestOllamaModelList();
+    void cancelAiRequests();  // Queued and in-flight; aborts open connections
+    void warmUpAiProvider();  // Loads the selected local model before it's needed
     void applyAiRecommendation();
     void autoSetGainFromAnalysis();
     AnalysisSnapshot getAnalysisSnapshot() const;
@@ -120,6 +253,14 @@ public:
     juce::StringArray getAvailableModels() const;
     int getAvailableModelsVersion() const;
     int getChatResponseVersion() const;
+    
+    // Streamed chat replies, drained by the editor (message thread only)
+    bool popChatStreamChunk(AiStreamChunk& chunk);
+    void discardChatStream();
+    void noteAiResultShown();  // Editor timer, after showing notes and chat text
+
+    // Per-stage timing of recent AI requests
+    const AiLatencyStats& getAiLatencyStats() const { return aiLatency; }
 
     // AI Provider management
     enum class AiProvider { Ollama = 0, OpenAI, Anthropic, OpenRouter, MiniMax };
@@ -129,7 +270,21 @@ public:
     juce::String getApiKey() const;
     void setSelectedModel(const juce::String& model);
     juce::String getSelectedModel() const;
-    void refreshModelList();
+    void refreshModelList(bool force = false);  // force: ask the provider even if the cached list is fresh
+
+    // Race mode: suggestions also go to the local Ollama model; the first structured reply wins
+    void setAiRaceMode(bool enabled) { const juce::ScopedLock lock(settingsLock); aiRaceMode = enabled; }
+    bool isAiRaceMode() const { const juce::ScopedLock lock(settingsLock); return aiRaceMode; }
+
+    // Suggestions asked in the background once genre/source/situation change and the
+    // input settles, so "Ask AI" answers from the cache. At most this many an hour (0 = off).
+    static constexpr int defaultSpeculativePerHour = 6;
+    void setSpeculativeSuggestionsPerHour(int count) { const juce::ScopedLock lock(settingsLock); speculativePerHour = juce::jlimit(0, 60, count); }
+    int getSpeculativeSuggestionsPerHour() const { const juce::ScopedLock lock(settingsLock); return speculativePerHour; }
+    
+    // Size cap for the session context sent with each AI request (estimated tokens)
+    void setAiContextTokenBudget(int tokens);
+    int getAiContextTokenBudget() const { const juce::ScopedLock lock(settingsLock); return aiContextTokenBudget; }
     
     // Equipment settings
     void setSelectedMic(const juce::String& mic) { const juce::ScopedLock lock(settingsLock); selectedMic = mic; }
@@ -168,10 +323,47 @@ public:
 private:
     class AiClient;
     friend class AiClient;
+    class CrossTrackAnalyzer;
+    friend class CrossTrackAnalyzer;
+
+    // Declared first so the log writer outlives everything that logs
+    RealtimeLogger::Session logSession { "master" };
 
     juce::AudioProcessorValueTreeState parameters;
 
     std::unique_ptr<AiClient> aiClient;
+    std::unique_ptr<CrossTrackAnalyzer> crossTrackAnalyzer;
+    
+    // Latest masking matrix, published by the cross-track analyzer thread
+    juce::CriticalSection maskingLock;
+    MaskingSnapshot maskingSnapshot;
+    
+    // Satellites opted into inter-track phase checking (bit per slot), and the
+    // latest pairwise results from the cross-track analyzer thread
+    static_assert(MAX_SATELLITES <= 32, "phaseCheckMask holds one bit per slot");
+    std::atomic<uint32_t> phaseCheckMask { 0 };
+    juce::CriticalSection phaseLock;
+    std::vector<PhaseAlignment> phaseAlignments;
+    BusPrediction busPrediction;  // Summed streamed tracks, refreshed with the phase checks
+    
+    // Joint gain solver state (solves run on the message thread or the analyzer thread)
+    std::atomic<bool> continuousGainSolving { false };
+    std::atomic<float> gainSolverTargetDb { -18.0f };
+    juce::CriticalSection gainSolverLock;
+    GainSolverReport gainSolverReport;
+    float solvedGainDb[MAX_SATELLITES] {};
+    float solverPreLevelDb[MAX_SATELLITES] {};   // Smoothed pre-gain level (continuous mode)
+    float solverPrePeakDb[MAX_SATELLITES] {};    // Pre-gain peak held over the level window
+    int64_t solverPeakMs[MAX_SATELLITES] {};     // When the held peak was taken, 0 = none
+    float solverAppliedGainDb[MAX_SATELLITES] {};
+    int64_t solverGainChangeMs[MAX_SATELLITES] {};  // Last time the applied gain moved
+    uint32_t solverGeneration[MAX_SATELLITES] {};
+    bool solverSlotValid[MAX_SATELLITES] {};
+    
+    // Group offsets as saved with the session (under settingsLock); shared memory
+    // carries a copy for the satellites
+    GroupInfo groupOffsets[MAX_SATELLITE_GROUPS + 1];
+    void publishGroup(int groupId);
 
     // Pre-processing (input) levels
     std::atomic<float> preRmsDb { -120.0f };
@@ -216,6 +408,14 @@ private:
     juce::String aiStatus;
     juce::String chatResponse;
     std::atomic<int> chatResponseVersion { 0 };
+    AiStreamQueue chatStream;
+    std::atomic<uint32_t> nextChatStreamId { 0 };
+    std::atomic<uint32_t> droppedChatStreamId { 0 };
+    AiLatencyStats aiLatency;
+    std::atomic<double> aiResultReadyMs { 0.0 };  // Millisecond counter, 0 = shown (or nothing new)
+    AiResponseCache aiResponseCache;  // Structured suggestions, shared on disk by all instances
+    AiContextBuilder chatContext;  // Message thread only; remembers what the conversation already has
+    AiConversation chatConversation;
     juce::StringArray availableModels;
     std::atomic<int> availableModelsVersion { 0 };
     float aiTargetDb = -18.0f;
@@ -227,6 +427,10 @@ private:
     AiProvider currentProvider { AiProvider::Ollama };
     juce::String apiKey;
     juce::String selectedModel { "llama3" };
+    juce::String localModel;  // Last Ollama model chosen, raced against the cloud provider
+    bool aiRaceMode = false;
+    int speculativePerHour { defaultSpeculativePerHour };
+    int aiContextTokenBudget { AiContextBuilder::defaultTokenBudget };
     juce::CriticalSection settingsLock;
     
     // Equipment settings
@@ -248,6 +452,33 @@ private:
     float lastPushedTargetDb = -999.0f;
     bool lastPushedAutoEnabled = false;
     float lastPushedRiderAmount = -1.0f;
+    
+    // Producer side of the per-slot command queues (message and analyzer threads)
+    juce::CriticalSection commandLock;
+    std::atomic<uint64_t> ipcCommandsSent { 0 };
+    std::atomic<uint64_t> ipcCommandsDropped { 0 };
+    std::atomic<float> ipcSweepMicros { 0.0f };
+    
+    // This instance's processBlock cost against the block deadline
+    ProcessingLoadMeter loadMeter;
+    
+    // Memory samples for getSessionHealth (taken on the timer, once a second)
+    int64_t sessionStartMs = 0;
+    int healthTimerTicks = 0;
+    std::atomic<int64_t> residentStartBytes { 0 };
+    std::atomic<int64_t> residentCurrentBytes { 0 };
+    std::atomic<int64_t> residentPeakBytes { 0 };
+    std::atomic<int64_t> residentBaselineBytes { 0 };  // Sampled at the 10-minute mark
+    static constexpr int64_t growthBaselineMs = 10 * 60 * 1000;
+    
+    int64_t lastAiWarmUpMs = 0;
+
+    // Background suggestions (message thread; aiContextChanged is set from any thread)
+    std::atomic<bool> aiContextChanged { false };
+    int64_t speculationDueMs = 0;             // 0 = nothing pending
+    int speculationSettledTicks = 0;
+    float speculationLastRmsDb = -120.0f;
+    std::deque<int64_t> speculationTimesMs;   // Sent within the last hour
 
     
 public:
@@ -255,7 +486,20 @@ public:
     void initializeSharedMemory();
     int getActiveSatelliteCount() const;
     SatelliteInfo getSatelliteInfo(int index) const;
+    int getSatelliteHistory(int index, std::vector<MeterHistoryPoint>& dest, int maxFrames = MeterHistoryRing::CAPACITY) const;
+    SatelliteHistoryStats getSatelliteHistoryStats(int index, int seconds) const;
+    void setSatelliteAudioStreaming(int index, int decimation);  // 0 = off, 1 = full rate, N = decimate by N
+    int readSatelliteAudio(int index, int numFrames, juce::AudioBuffer<float>& dest,
+                           int64_t& timelineStart, int64_t alignToTimelineEnd = -1) const;
+    BusPrediction predictSummedBus(int numFrames) const;
+    BusPrediction getBusPrediction() const;  // Latest from the cross-track analyzer thread
+    MaskingSnapshot getMaskingSnapshot() const;
+    std::vector<MaskingPair> getTopMaskingPairs(int maxPairs, float minSeverity = 0.3f) const;
+    void setSatellitePhaseCheck(int index, bool enabled);  // Streams full-rate audio while enabled
+    bool isSatellitePhaseCheckEnabled(int index) const;
+    std::vector<PhaseAlignment> getPhaseAlignments() const;
     void setSatelliteControl(int index, const SatelliteControl& control);
+    void setSatelliteControls(const std::vector<std::pair<int, SatelliteControl>>& controls);  // Applied in one block
     void releaseSatelliteControl(int index);
     juce::String getSatellitesSummary() const;
     juce::String getSatellitesJsonContext() const;
@@ -264,6 +508,23 @@ public:
     void setAllSatellitesCeiling(float ceilingDb);
     void autoGainAllSatellites(float targetDb);
     
+    // Group control: one shared-memory write per change, whatever the group size.
+    // Offsets are saved with the session and republished when it loads.
+    void setGroupGain(int groupId, float offsetDb);
+    void setGroupTarget(int groupId, float offsetDb);
+    void setGroupCeiling(int groupId, float offsetDb);
+    GroupInfo getGroupInfo(int groupId) const;
+    void setContinuousGainSolving(bool enabled, float targetDb);
+    bool isContinuousGainSolving() const { return continuousGainSolving.load(); }
+    GainSolverReport getGainSolverReport() const;
+    IpcStats getIpcStats() const;
+    SessionHealth getSessionHealth() const;
+    const ProcessingLoadMeter& getLoadMeter() const { return loadMeter; }
+    
+    // Dumps this process's trace and asks every satellite process to do the same.
+    // Files land in ARES/traces; a no-op unless built with AR3S_TRACING.
+    void exportTraces();
+    
 private:
     double currentSampleRate = 44100.0;
     float autoSmoothedGain = 1.0f;
@@ -276,11 +537,29 @@ private:
 
 
 
-    void applyAiResponseText(const juce::String& response);
+    void timerCallback() override;
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    void updateSpeculativeSuggestion();
+    bool sendAiSuggestion(const juce::String& genre, const juce::String& source,
+                          const juce::String& situation, bool speculative);
+    void getAiContextNames(juce::String& genre, juce::String& source, juce::String& situation) const;
+    void solveSatelliteGains(float targetDb, bool onlyIfChanged);
+    void queueSatelliteControl(SharedPluginData& memData, int index, const SatelliteControl& control, uint32_t batchId);
+
+    bool applyAiResponseText(const juce::String& response);  // true for a structured suggestion
     void setAiNotesMessage(const juce::String& message);
     void setAiStatusMessage(const juce::String& message);
     void setChatResponseMessage(const juce::String& message);
+    uint32_t beginChatStream();
+    void appendChatStream(uint32_t streamId, const juce::String& text);
+    void endChatStream(uint32_t streamId, const juce::String& fullText);
     void setAvailableModels(const juce::StringArray& models);
+    juce::String buildAiContext(AiContextBuilder& builder, const AnalysisSnapshot& analysis);
+    juce::String getSuggestionCacheContext(const juce::String& genre, const juce::String& source,
+                                           const juce::String& situation, const juce::String& language,
+                                           const juce::String& mic, const juce::String& preamp,
+                                           const juce::String& iface, const AnalysisSnapshot& analysis) const;
+    juce::String getRaceLocalModel() const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SimpleGainAudioProcessor)
 };
@@ -0,0 +1,520 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "SharedMemory.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+// Centre frequency of 1/3-octave analysis band k (band 15 = 1 kHz)
+inline float getAnalysisBandCentreHz(int band)
+{
+    return 1000.0f * std::pow(2.0f, static_cast<float>(band - 15) / 3.0f);
+}
+
+// Short label for a band centre ("125", "2.5k")
+inline juce::String getAnalysisBandLabel(int band)
+{
+    const float hz = getAnalysisBandCentreHz(band);
+    if (hz >= 1000.0f)
+        return juce::String(hz / 1000.0f, hz >= 10000.0f ? 0 : 1) + "k";
+    return juce::String(juce::roundToInt(hz));
+}
+
+// How strongly two tracks fight for the same bands (0 = no overlap, 1 = both
+// tracks put most of their energy into the same bands at similar levels).
+// A band counts when it is significant for both tracks (within 20 dB of each
+// track's loudest band) and the two levels are within 12 dB of each other.
+// dominantBand receives the band contributing most, or -1.
+inline float computeMaskingSeverity(const float* bandsA, const float* bandsB, int& dominantBand)
+{
+    constexpr float significantRangeDb = 20.0f;
+    constexpr float maskingRangeDb = 12.0f;
+    constexpr float silenceDb = -90.0f;
+
+    dominantBand = -1;
+    float maxA = silenceDb, maxB = silenceDb;
+    for (int k = 0; k < NUM_ANALYSIS_BANDS; ++k)
+    {
+        maxA = std::max(maxA, bandsA[k]);
+        maxB = std::max(maxB, bandsB[k]);
+    }
+    if (maxA <= silenceDb || maxB <= silenceDb)
+        return 0.0f;
+
+    float total = 0.0f, strongest = 0.0f;
+    for (int k = 0; k < NUM_ANALYSIS_BANDS; ++k)
+    {
+        const float weightA = 1.0f - (maxA - bandsA[k]) / significantRangeDb;
+        const float weightB = 1.0f - (maxB - bandsB[k]) / significantRangeDb;
+        const float closeness = 1.0f - std::abs(bandsA[k] - bandsB[k]) / maskingRangeDb;
+        if (weightA <= 0.0f || weightB <= 0.0f || closeness <= 0.0f)
+            continue;
+
+        const float contribution = weightA * weightB * closeness;
+        total += contribution;
+        if (contribution > strongest)
+        {
+            strongest = contribution;
+            dominantBand = k;
+        }
+    }
+
+    // Three fully overlapping bands (a full octave) is already a severe clash
+    return juce::jlimit(0.0f, 1.0f, total / 3.0f);
+}
+
+// 1/3-octave band energy analyzer for a satellite's post-gain signal.
+// Runs on the audio thread: mono-sums into a 2048-sample frame and, once per
+// frame (~23 Hz at 48 kHz), does one real FFT and folds the bins into
+// NUM_ANALYSIS_BANDS smoothed dB levels. No allocation after prepare().
+class ThirdOctaveAnalyzer
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+
+    void prepare(double sampleRate)
+    {
+        fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+        window.assign(static_cast<size_t>(fftSize), 0.0f);
+        juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), static_cast<size_t>(fftSize),
+                                                                 juce::dsp::WindowingFunction<float>::hann, false);
+        fftData.assign(static_cast<size_t>(fftSize) * 2, 0.0f);
+        inputPos = 0;
+        frameCount = 0;
+
+        // Power of a full-scale sine through the Hann window should read 0 dB mean square
+        float windowSum = 0.0f;
+        for (auto w : window)
+            windowSum += w;
+        powerScale = 2.0f / (windowSum * windowSum);
+
+        // Bin range of each band. Low bands narrower than one bin get the bin nearest their centre.
+        const double binHz = sampleRate / fftSize;
+        for (int k = 0; k < NUM_ANALYSIS_BANDS; ++k)
+        {
+            const double centre = getAnalysisBandCentreHz(k);
+            const double edge = std::pow(2.0, 1.0 / 6.0);
+            int lo = static_cast<int>(std::ceil(centre / edge / binHz));
+            int hi = static_cast<int>(std::floor(centre * edge / binHz));
+            if (hi < lo)
+                lo = hi = static_cast<int>(std::round(centre / binHz));
+            bandFirstBin[(size_t) k] = juce::jlimit(1, fftSize / 2, lo);
+            bandLastBin[(size_t) k] = juce::jlimit(1, fftSize / 2, hi);
+        }
+
+        // ~300 ms smoothing at the frame rate
+        const double framesPerSecond = sampleRate / fftSize;
+        smoothing = static_cast<float>(std::exp(-1.0 / (framesPerSecond * 0.3)));
+        bandsDb.fill(-120.0f);
+    }
+
+    // Audio thread. Returns true when a new band frame completed in this block.
+    bool process(const float* left, const float* right, int numSamples)
+    {
+        if (fft == nullptr)
+            return false;
+
+        bool completed = false;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            fftData[(size_t) inputPos] = right != nullptr ? 0.5f * (left[i] + right[i]) : left[i];
+            if (++inputPos == fftSize)
+            {
+                analyseFrame();
+                inputPos = 0;
+                completed = true;
+            }
+        }
+        return completed;
+    }
+
+    const std::array<float, NUM_ANALYSIS_BANDS>& getBandsDb() const { return bandsDb; }
+    uint32_t getFrameCount() const { return frameCount; }
+
+private:
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> window;
+    std::vector<float> fftData;
+    std::array<int, NUM_ANALYSIS_BANDS> bandFirstBin {};
+    std::array<int, NUM_ANALYSIS_BANDS> bandLastBin {};
+    std::array<float, NUM_ANALYSIS_BANDS> bandsDb {};
+    float powerScale = 1.0f;
+    float smoothing = 0.8f;
+    int inputPos = 0;
+    uint32_t frameCount = 0;
+
+    void analyseFrame()
+    {
+        for (int i = 0; i < fftSize; ++i)
+            fftData[(size_t) i] *= window[(size_t) i];
+        std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+
+        fft->performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+        for (int k = 0; k < NUM_ANALYSIS_BANDS; ++k)
+        {
+            float power = 0.0f;
+            for (int bin = bandFirstBin[(size_t) k]; bin <= bandLastBin[(size_t) k]; ++bin)
+                power += fftData[(size_t) bin] * fftData[(size_t) bin];
+
+            const float db = 10.0f * std::log10(std::max(power * powerScale, 1.0e-12f));
+            bandsDb[(size_t) k] = smoothing * bandsDb[(size_t) k] + (1.0f - smoothing) * db;
+        }
+        ++frameCount;
+    }
+};
+
+// Time offset and polarity between two tracks by generalized cross-correlation
+// with phase transform (GCC-PHAT). Each track's window is transformed once with
+// computeSpectrum(); compare() then costs one inverse FFT per pair, so checking
+// every pair of 10 drum mics is 10 forward + 45 inverse 8192-point FFTs.
+// The FFT and scratch buffers are reused across calls (worker thread only).
+class GccPhatEstimator
+{
+public:
+    static constexpr int windowSize = 4096;
+    static constexpr int fftOrder = 13;
+    static constexpr int fftSize = 1 << fftOrder;  // Zero-padded so lags don't wrap
+
+    struct Result
+    {
+        bool valid = false;
+        int offsetSamples = 0;        // > 0: track B arrives later than track A
+        bool polarityInverted = false;
+        float confidence = 0.0f;      // 0..1 from the peak's prominence
+    };
+
+    GccPhatEstimator()
+    {
+        window.resize(static_cast<size_t>(windowSize));
+        juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), static_cast<size_t>(windowSize),
+                                                                 juce::dsp::WindowingFunction<float>::hann, false);
+        work.resize(static_cast<size_t>(fftSize) * 2);
+    }
+
+    // Windowed spectrum of windowSize mono samples into spectrum (resized once).
+    // Returns false if the window is too quiet to correlate.
+    bool computeSpectrum(const float* mono, std::vector<float>& spectrum)
+    {
+        float sumSquares = 0.0f;
+        for (int i = 0; i < windowSize; ++i)
+            sumSquares += mono[i] * mono[i];
+        if (sumSquares / windowSize < 1.0e-8f)  // -80 dBFS
+            return false;
+
+        spectrum.resize(static_cast<size_t>(fftSize) * 2);
+        for (int i = 0; i < windowSize; ++i)
+            spectrum[(size_t) i] = mono[i] * window[(size_t) i];
+        std::fill(spectrum.begin() + windowSize, spectrum.end(), 0.0f);
+
+        fft.performRealOnlyForwardTransform(spectrum.data(), true);
+        return true;
+    }
+
+    // Searches lags within +/- maxLag samples for the strongest PHAT peak
+    Result compare(const std::vector<float>& spectrumA, const std::vector<float>& spectrumB, int maxLag)
+    {
+        Result result;
+        maxLag = juce::jlimit(1, windowSize - 1, maxLag);
+
+        // conj(A) * B, whitened so every frequency votes equally for the delay
+        for (int bin = 0; bin <= fftSize / 2; ++bin)
+        {
+            const float ar = spectrumA[(size_t) (2 * bin)], ai = spectrumA[(size_t) (2 * bin + 1)];
+            const float br = spectrumB[(size_t) (2 * bin)], bi = spectrumB[(size_t) (2 * bin + 1)];
+            const float re = ar * br + ai * bi;
+            const float im = ar * bi - ai * br;
+            const float magnitude = std::sqrt(re * re + im * im);
+            const float scale = magnitude > 1.0e-12f ? 1.0f / magnitude : 0.0f;
+            work[(size_t) (2 * bin)] = re * scale;
+            work[(size_t) (2 * bin + 1)] = im * scale;
+        }
+        std::fill(work.begin() + fftSize + 2, work.end(), 0.0f);
+
+        fft.performRealOnlyInverseTransform(work.data());
+
+        // Positive lags sit at the start of the buffer, negative ones wrap to the end
+        float peak = 0.0f, sumSquares = 0.0f;
+        int peakLag = 0;
+        for (int lag = -maxLag; lag <= maxLag; ++lag)
+        {
+            const float value = work[(size_t) (lag >= 0 ? lag : fftSize + lag)];
+            sumSquares += value * value;
+            if (std::abs(value) > std::abs(peak))
+            {
+                peak = value;
+                peakLag = lag;
+            }
+        }
+
+        const float rms = std::sqrt(sumSquares / static_cast<float>(2 * maxLag + 1));
+        if (rms <= 0.0f)
+            return result;
+
+        // Peak-to-RMS of ~3 is noise; ~15 or more is an unambiguous single path
+        result.valid = true;
+        result.offsetSamples = peakLag;
+        result.polarityInverted = peak < 0.0f;
+        result.confidence = juce::jlimit(0.0f, 1.0f, (std::abs(peak) / rms - 3.0f) / 12.0f);
+        return result;
+    }
+
+private:
+    juce::dsp::FFT fft { fftOrder };
+    std::vector<float> window;
+    std::vector<float> work;
+};
+
+// ITU-R BS.1770 loudness of a stereo signal: K-weighting (high shelf + RLB
+// high-pass, coefficients derived for the actual sample rate), 100 ms power
+// blocks, 400 ms momentary, 3 s short-term and gated integrated loudness.
+// Integrated loudness uses a 0.1 LU histogram of the 400 ms gating blocks, so
+// memory stays fixed however long the session runs. Audio thread only.
+class LoudnessMeter
+{
+public:
+    LoudnessMeter()
+    {
+        // Centre power of each 0.1 LU histogram bin, so the gating sums are pow-free
+        for (int bin = 0; bin < histogramBins; ++bin)
+        {
+            const double lufs = histogramMinLufs + (bin + 0.5) * 0.1;
+            binPowers[(size_t) bin] = std::pow(10.0, (lufs + 0.691) / 10.0);
+        }
+    }
+    
+    void prepare(double sampleRate)
+    {
+        // Stage 1: high shelf (+4 dB above ~1.7 kHz)
+        {
+            const double f0 = 1681.974450955533, gainDb = 3.999843853973347, q = 0.7071752369554196;
+            const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+            const double vh = std::pow(10.0, gainDb / 20.0);
+            const double vb = std::pow(vh, 0.4996667741545416);
+            const double a0 = 1.0 + k / q + k * k;
+            shelf.set((vh + vb * k / q + k * k) / a0, 2.0 * (k * k - vh) / a0, (vh - vb * k / q + k * k) / a0,
+                      2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0);
+        }
+        
+        // Stage 2: RLB high-pass (~38 Hz)
+        {
+            const double f0 = 38.13547087602444, q = 0.5003270373238773;
+            const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+            const double a0 = 1.0 + k / q + k * k;
+            highPass.set(1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0);
+        }
+        
+        blockLength = std::max(1, static_cast<int>(sampleRate * 0.1));
+        reset();
+    }
+    
+    void reset()
+    {
+        shelf.reset();
+        highPass.reset();
+        blockSum = 0.0;
+        blockFill = 0;
+        blockPowers.fill(0.0);
+        blocksWritten = 0;
+        histogram.fill(0);
+        momentaryLufs = shortTermLufs = integratedLufs = -120.0f;
+    }
+    
+    // Returns true when a 100 ms block completed (and the readings changed)
+    bool process(const float* left, const float* right, int numSamples)
+    {
+        bool completed = false;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double l = highPass.process(shelf.process(left[i], 0), 0);
+            double power = l * l;
+            if (right != nullptr)
+            {
+                const double r = highPass.process(shelf.process(right[i], 1), 1);
+                power += r * r;  // L and R are weighted 1.0
+            }
+            blockSum += power;
+            
+            if (++blockFill == blockLength)
+            {
+                finishBlock(blockSum / blockLength);
+                blockSum = 0.0;
+                blockFill = 0;
+                completed = true;
+            }
+        }
+        return completed;
+    }
+    
+    float getMomentaryLufs() const { return momentaryLufs; }
+    float getShortTermLufs() const { return shortTermLufs; }
+    float getIntegratedLufs() const { return integratedLufs; }
+    
+private:
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+        double z1[2] {}, z2[2] {};
+        
+        void set(double nb0, double nb1, double nb2, double na1, double na2)
+        {
+            b0 = nb0; b1 = nb1; b2 = nb2; a1 = na1; a2 = na2;
+        }
+        
+        void reset()
+        {
+            z1[0] = z1[1] = z2[0] = z2[1] = 0.0;
+        }
+        
+        double process(double x, int ch)
+        {
+            const double y = b0 * x + z1[ch];
+            z1[ch] = b1 * x - a1 * y + z2[ch];
+            z2[ch] = b2 * x - a2 * y;
+            return y;
+        }
+    };
+    
+    static constexpr int shortTermBlocks = 30;  // 3 s of 100 ms blocks
+    static constexpr int momentaryBlocks = 4;   // 400 ms
+    static constexpr float histogramMinLufs = -70.0f;  // Absolute gate
+    static constexpr int histogramBins = 800;          // -70 .. +10 LUFS in 0.1 LU
+    
+    Biquad shelf, highPass;
+    int blockLength = 4800;
+    double blockSum = 0.0;
+    int blockFill = 0;
+    std::array<double, shortTermBlocks> blockPowers {};
+    int64_t blocksWritten = 0;
+    std::array<uint32_t, histogramBins> histogram {};
+    std::array<double, histogramBins> binPowers {};
+    float momentaryLufs = -120.0f;
+    float shortTermLufs = -120.0f;
+    float integratedLufs = -120.0f;
+    
+    static float powerToLufs(double power)
+    {
+        return power > 1.0e-12 ? static_cast<float>(-0.691 + 10.0 * std::log10(power)) : -120.0f;
+    }
+    
+    double averagePower(int numBlocks) const
+    {
+        const int available = static_cast<int>(std::min<int64_t>(blocksWritten, numBlocks));
+        if (available == 0)
+            return 0.0;
+        
+        double sum = 0.0;
+        for (int n = 0; n < available; ++n)
+            sum += blockPowers[(size_t) ((blocksWritten - 1 - n) % shortTermBlocks)];
+        return sum / available;
+    }
+    
+    void finishBlock(double power)
+    {
+        blockPowers[(size_t) (blocksWritten % shortTermBlocks)] = power;
+        ++blocksWritten;
+        
+        const double momentaryPower = averagePower(momentaryBlocks);
+        momentaryLufs = powerToLufs(momentaryPower);
+        shortTermLufs = powerToLufs(averagePower(shortTermBlocks));
+        
+        // Each 100 ms step yields a 400 ms gating block (75% overlap)
+        if (blocksWritten >= momentaryBlocks && momentaryLufs > histogramMinLufs)
+        {
+            const int bin = juce::jlimit(0, histogramBins - 1, static_cast<int>((momentaryLufs - histogramMinLufs) * 10.0f));
+            ++histogram[(size_t) bin];
+        }
+        
+        // Relative gate at 10 LU below the absolute-gated mean
+        double sum = 0.0;
+        uint64_t count = 0;
+        for (int bin = 0; bin < histogramBins; ++bin)
+        {
+            sum += histogram[(size_t) bin] * binPowers[(size_t) bin];
+            count += histogram[(size_t) bin];
+        }
+        if (count == 0)
+            return;
+        
+        const float relativeGate = powerToLufs(sum / static_cast<double>(count)) - 10.0f;
+        const int firstBin = juce::jlimit(0, histogramBins, static_cast<int>(std::ceil((relativeGate - histogramMinLufs) * 10.0f)));
+        sum = 0.0;
+        count = 0;
+        for (int bin = firstBin; bin < histogramBins; ++bin)
+        {
+            sum += histogram[(size_t) bin] * binPowers[(size_t) bin];
+            count += histogram[(size_t) bin];
+        }
+        if (count > 0)
+            integratedLufs = powerToLufs(sum / static_cast<double>(count));
+    }
+};
+
+// Inter-sample (true) peak via 4x polyphase oversampling, as in BS.1770
+// Annex 2: 48-tap windowed-sinc interpolator split into 4 phases of 12 taps.
+// Audio thread only.
+class TruePeakDetector
+{
+public:
+    static constexpr int oversampling = 4;
+    static constexpr int tapsPerPhase = 12;
+    
+    TruePeakDetector()
+    {
+        constexpr int numTaps = oversampling * tapsPerPhase;
+        const double centre = (numTaps - 1) / 2.0;
+        for (int n = 0; n < numTaps; ++n)
+        {
+            const double x = (n - centre) / oversampling;
+            const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+            const double window = 0.5 - 0.5 * std::cos(2.0 * juce::MathConstants<double>::pi * (n + 0.5) / numTaps);
+            phases[(size_t) (n % oversampling)][(size_t) (n / oversampling)] = static_cast<float>(sinc * window);
+        }
+        reset();
+    }
+    
+    void reset()
+    {
+        for (auto& channel : history)
+            channel.fill(0.0f);
+        writePos = 0;
+        peak = 0.0f;
+    }
+    
+    void process(const float* left, const float* right, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            history[0][(size_t) writePos] = left[i];
+            history[1][(size_t) writePos] = right != nullptr ? right[i] : 0.0f;
+            
+            for (int ch = 0; ch < (right != nullptr ? 2 : 1); ++ch)
+            {
+                for (const auto& taps : phases)
+                {
+                    float sum = 0.0f;
+                    for (int k = 0; k < tapsPerPhase; ++k)
+                        sum += taps[(size_t) k] * history[(size_t) ch][(size_t) ((writePos - k + tapsPerPhase) % tapsPerPhase)];
+                    peak = std::max(peak, std::abs(sum));
+                }
+            }
+            writePos = (writePos + 1) % tapsPerPhase;
+        }
+    }
+    
+    // Highest true peak (linear) since the last call
+    float getAndResetPeak()
+    {
+        const float result = peak;
+        peak = 0.0f;
+        return result;
+    }
+    
+private:
+    std::array<std::array<float, tapsPerPhase>, oversampling> phases {};
+    std::array<std::array<float, tapsPerPhase>, 2> history {};
+    int writePos = 0;
+    float peak = 0.0f;
+};
@@ -63,6 +63,19 @@ SatelliteEditor::SatelliteEditor(SatelliteProcessor& p)
     sourceAttach = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         processor.getValueTreeState(), "source", sourceBox);
     
+    // Group dropdown
+    for (int group = 0; group <= MAX_SATELLITE_GROUPS; ++group)
+        groupBox.addItem(group == 0 ? "No Group" : getSatelliteGroupName(group), group + 1);
+    addAndMakeVisible(groupBox);
+    groupAttach = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        processor.getValueTreeState(), "group", groupBox);
+    
+    // Analysis profile dropdown
+    analysisBox.addItemList({ "Lite Analysis", "Standard Analysis", "Full Analysis" }, 1);
+    addAndMakeVisible(analysisBox);
+    analysisAttach = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        processor.getValueTreeState(), "analysis", analysisBox);
+    
     // Pre/Post meter toggle
     meterModeButton.setButtonText("POST");
     meterModeButton.onClick = [this] {
@@ -100,7 +113,7 @@ void SatelliteEditor::updateThemeFromMaster()
     // Always update knob style from master
     if (knobStyle != masterKnobStyle)
     {
-        DBG("SatelliteEditor: Knob style updated from master: " << masterKnobStyle);
+        AR3S_LOG_DEBUG("Satellite", "Knob style {} from master", masterKnobStyle);
         knobStyle = masterKnobStyle;
         repaint();
     }
@@ -108,7 +121,7 @@ void SatelliteEditor::updateThemeFromMaster()
     // Always update theme from master
     if (lastThemeIndex != masterTheme && masterTheme >= 0)
     {
-        DBG("SatelliteEditor: Theme updated from master: " << masterTheme);
+        AR3S_LOG_DEBUG("Satellite", "Theme {} from master", masterTheme);
         lastThemeIndex = masterTheme;
         theme = getTheme(static_cast<ThemeType>(masterTheme));
 
@@ -122,6 +135,16 @@ void SatelliteEditor::updateThemeFromMaster()
         sourceBox.setColour(juce::ComboBox::outlineColourId, theme.accent.withAlpha(0.4f));
         sourceBox.setColour(juce::ComboBox::arrowColourId, theme.accent);
 
+        groupBox.setColour(juce::ComboBox::backgroundColourId, theme.bgPanel);
+        groupBox.setColour(juce::ComboBox::textColourId, theme.textBright);
+        groupBox.setColour(juce::ComboBox::outlineColourId, theme.accent.withAlpha(0.4f));
+        groupBox.setColour(juce::ComboBox::arrowColourId, theme.accent);
+
+        analysisBox.setColour(juce::ComboBox::backgroundColourId, theme.bgPanel);
+        analysisBox.setColour(juce::ComboBox::textColourId, theme.textBright);
+        analysisBox.setColour(juce::ComboBox::outlineColourId, theme.accent.withAlpha(0.4f));
+        analysisBox.setColour(juce::ComboBox::arrowColourId, theme.accent);
+
         meterModeButton.setColour(juce::TextButton::buttonColourId, theme.bgPanel);
         meterModeButton.setColour(juce::TextButton::textColourOffId, theme.textDim);
 
@@ -400,6 +423,7 @@ void SatelliteEditor::drawPhaseMeter(juce::Graphics& g, juce::Rectangle<float> b
 
 void SatelliteEditor::paint(juce::Graphics& g)
 {
+    AR3S_TRACE_SCOPE("satellite editor paint");
     const int w = getWidth();
     const int h = getHeight();
     
@@ -424,6 +448,14 @@ void SatelliteEditor::paint(juce::Graphics& g)
     g.setColour(theme.textDim);
     g.drawText(connected ? "LINKED" : "STANDALONE", w - 100, 8, 70, 16, juce::Justification::right);
     
+    // Blocks that missed their deadline in this instance
+    const auto overruns = processor.getLoadMeter().getIncidents().getOverrunCount();
+    if (overruns > 0)
+    {
+        g.setColour(theme.meterRed);
+        g.drawText(juce::String(overruns) + (overruns == 1 ? " OVERRUN" : " OVERRUNS"), w - 200, 8, 95, 16, juce::Justification::right);
+    }
+    
     // Master control indicator
     if (processor.isControlledByMaster())
     {
@@ -484,6 +516,12 @@ void SatelliteEditor::resized()
     // Source dropdown - moved further right
     sourceBox.setBounds(342, 42, 110, 22);
     
+    // Group dropdown - under the source
+    groupBox.setBounds(342, 68, 110, 22);
+    
+    // Analysis profile - under the channel name
+    analysisBox.setBounds(200, 68, 140, 22);
+    
     // Gain knob - left side (adjusted for label)
     gainKnob.setBounds(10, 42, 90, 80);
     
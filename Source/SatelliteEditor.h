@@ -38,10 +38,18 @@ private:
     // Source dropdown
     juce::ComboBox sourceBox;
     
+    // Group dropdown
+    juce::ComboBox groupBox;
+    
+    // Analysis profile dropdown
+    juce::ComboBox analysisBox;
+    
     // Attachments
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> gainAttach;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> ceilingAttach;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> sourceAttach;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> groupAttach;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> analysisAttach;
     
     // Meter values
     float smoothedRms = -60.0f;
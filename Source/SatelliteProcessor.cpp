@@ -27,6 +27,7 @@ SatelliteProcessor::SatelliteProcessor()
     
     // Listen for source parameter changes to sync to shared memory
     parameters.addParameterListener("source", this);
+    parameters.addParameterListener("group", this);
     connectToSharedMemory();
     
     // Start timer to keep satellite active even when not processing audio
@@ -36,6 +37,7 @@ SatelliteProcessor::SatelliteProcessor()
 SatelliteProcessor::~SatelliteProcessor()
 {
     parameters.removeParameterListener("source", this);
+    parameters.removeParameterListener("group", this);
     disconnectFromSharedMemory();
     stopTimer();
 }
@@ -44,133 +46,176 @@ void SatelliteProcessor::connectToSharedMemory()
 {
     if (sharedMemory.openOrCreate())
     {
-        auto* data = sharedMemory.getData();
-        if (data != nullptr)
+        // Only answer trace export requests made from now on
+        lastTraceExportRequest = sharedMemory.getData()->traceExportRequest.load();
+        
+        // Nothing is processing yet, so the message thread can claim and name the slot itself
+        if (claimSharedMemorySlot(true))
         {
-            slotIndex = data->findAvailableSlot();
-            if (slotIndex >= 0)
-            {
-                auto& sat = data->satellites[slotIndex];
-                sat.active.store(true);
-                sat.instanceId.store(instanceId);  // Store our unique ID
-                sat.lastUpdateTime.store(juce::Time::currentTimeMillis());
-                sat.sourceType.store(sourceType);
-                std::strncpy(sat.channelName, channelName.toRawUTF8(), 63);
-                sat.channelName[63] = '\0';
-                
-                DBG("AR3S Satellite [" + juce::String(instanceId) + "]: Connected to slot " + juce::String(slotIndex) + " as '" + channelName + "'");
-            }
-            else
-            {
-                DBG("AR3S Satellite: No available slot found!");
-            }
+            publishChannelName();
+            AR3S_LOG_INFO("Satellite", "Instance {} connected to slot {} as '{}'", instanceId, slotIndex.load(), channelName);
+        }
+        else
+        {
+            AR3S_LOG_WARNING("Satellite", "No available slot for instance {}", instanceId);
         }
     }
     else
     {
-        DBG("AR3S Satellite: Failed to open/create shared memory!");
+        AR3S_LOG_ERROR("Satellite", "Failed to open or create shared memory");
+    }
+}
+
+bool SatelliteProcessor::claimSharedMemorySlot(bool allowTakeover)
+{
+    auto* data = sharedMemory.getData();
+    if (data == nullptr)
+        return false;
+    
+    // Claim with our process ID so the master can reap the slot the moment this host dies
+    uint32_t generation = 0;
+    const int index = data->claimSlot(instanceId, static_cast<int32_t>(::getpid()), generation, allowTakeover);
+    if (index < 0)
+    {
+        // Count the outage once, however often we retry while it lasts
+        if (!slotOutage.exchange(true))
+            data->slotClaimFailures.fetch_add(1, std::memory_order_relaxed);
+        return false;
     }
+    
+    slotOutage.store(false);
+    auto& sat = data->satellites[index];
+    sat.sourceType.store(sourceType.load());
+    sat.groupId.store(groupId.load());
+    activeAnalysisProfile.store(-1);  // Republish the profile on the next block
+    channelNamePending.store(true);   // The name belongs to the message thread
+    sat.history.reset();  // Don't inherit the previous owner's history
+    sat.commandLatency.reset();
+    commandResyncPending.store(true);  // Don't apply the previous owner's queued commands
+    slotGeneration.store(generation);
+    slotIndex.store(index);
+    return true;
 }
 
 void SatelliteProcessor::disconnectFromSharedMemory()
 {
-    if (sharedMemory.isValid() && slotIndex >= 0 && slotIndex < MAX_SATELLITES)
+    const int index = slotIndex.exchange(-1);
+    if (sharedMemory.isValid() && index >= 0 && index < MAX_SATELLITES)
     {
         auto* data = sharedMemory.getData();
         if (data != nullptr)
         {
-            // Only clear if the slot is still ours
-            auto& sat = data->satellites[slotIndex];
-            if (sat.instanceId.load() == instanceId)
-            {
-                sat.active.store(false);
-                sat.instanceId.store(0);
-                sat.lastUpdateTime.store(0);
-                DBG("AR3S Satellite [" + juce::String(instanceId) + "]: Disconnected from slot " + juce::String(slotIndex));
-            }
+            // Only clears the slot if it is still ours
+            data->releaseSlot(index, instanceId);
+            AR3S_LOG_INFO("Satellite", "Instance {} disconnected from slot {}", instanceId, index);
         }
     }
-    slotIndex = -1;
+}
+
+void SatelliteProcessor::publishChannelName()
+{
+    const int index = slotIndex.load();
+    if (sharedMemory.isValid() && index >= 0)
+    {
+        auto& sat = sharedMemory.getData()->satellites[index];
+        std::strncpy(sat.channelName, channelName.toRawUTF8(), 63);
+        sat.channelName[63] = '\0';
+    }
 }
 
 void SatelliteProcessor::setChannelName(const juce::String& name)
 {
     channelName = name;
-    if (sharedMemory.isValid() && slotIndex >= 0)
+    publishChannelName();
+}
+
+void SatelliteProcessor::setSourceType(int type)
+{
+    sourceType.store(type);
+    const int index = slotIndex.load();
+    if (sharedMemory.isValid() && index >= 0)
     {
         auto* data = sharedMemory.getData();
-        std::strncpy(data->satellites[slotIndex].channelName, 
-                    name.toRawUTF8(), 63);
+        data->satellites[index].sourceType.store(type);
     }
 }
 
-void SatelliteProcessor::setSourceType(int type)
+void SatelliteProcessor::setGroupId(int group)
 {
-    sourceType = type;
-    if (sharedMemory.isValid() && slotIndex >= 0)
+    const int clampedGroup = juce::jlimit(0, MAX_SATELLITE_GROUPS, group);
+    groupId.store(clampedGroup);
+    const int index = slotIndex.load();
+    if (sharedMemory.isValid() && index >= 0)
     {
         auto* data = sharedMemory.getData();
-        data->satellites[slotIndex].sourceType.store(type);
+        data->satellites[index].groupId.store(clampedGroup);
     }
 }
 
-void SatelliteProcessor::updateSharedMemory()
+int SatelliteProcessor::reclaimSlot(int lostIndex, bool onAudioThread, int64_t nowMs)
+{
+    // Re-claiming resets the slot's history and command latency, which the audio thread
+    // writes while it holds a slot, so only the audio thread gives a lost slot up. It
+    // then only tries free slots; taking over a dead or hung owner's slot needs kill(),
+    // so that is left to the timer, which backs off while every slot stays busy.
+    if (!onAudioThread && (lostIndex >= 0 || nowMs < nextTakeoverAttemptMs))
+        return -1;
+    
+    // The audio thread never waits for the timer: whoever loses just tries again later
+    if (slotClaimBusy.exchange(true, std::memory_order_acquire))
+        return -1;
+    
+    if (lostIndex >= 0)
+    {
+        sharedMemory.getData()->releaseSlot(lostIndex, instanceId);  // Only if it is still ours
+        slotIndex.store(-1);
+    }
+    
+    const bool claimed = claimSharedMemorySlot(!onAudioThread);
+    slotClaimBusy.store(false, std::memory_order_release);
+    
+    if (!onAudioThread)
+    {
+        takeoverBackoffMs = claimed ? 0 : juce::jlimit(1000, 8000, takeoverBackoffMs * 2);
+        nextTakeoverAttemptMs = nowMs + takeoverBackoffMs;
+    }
+    
+    if (!claimed)
+        return -1;
+    
+    const int index = slotIndex.load();
+    AR3S_LOG_INFO("Satellite", "Instance {} re-connected to slot {}", instanceId, index);
+    return index;
+}
+
+void SatelliteProcessor::updateSharedMemory(bool onAudioThread)
 {
     if (!sharedMemory.isValid())
         return;
     
     // Rate limit to 20 times per second (every 50ms) to avoid performance issues
-    const auto currentTime = juce::Time::currentTimeMillis();
+    const auto currentTime = getMonotonicMillis();
     if (currentTime - lastSharedMemoryUpdateTime < 50)
         return;
     
     auto* data = sharedMemory.getData();
     
-    // Check if our slot was cleared by master (e.g. master restarted) or if we don't have a valid slot
-    // If so, we need to re-register
-    bool needsReconnect = (slotIndex < 0);
-    if (!needsReconnect && slotIndex >= 0 && slotIndex < MAX_SATELLITES)
+    // Check if our slot was taken over or cleared (e.g. master reaped it) or if we don't
+    // have a valid slot. The generation check catches a slot that was released and
+    // re-claimed by another instance in between two of our updates. Loaded once: the
+    // other thread may drop the slot while we are in here.
+    int index = slotIndex.load();
+    if (!data->ownsSlot(index, instanceId, slotGeneration.load()))
     {
-        // Check if our slot is still ours using instance ID
-        auto& sat = data->satellites[slotIndex];
-        needsReconnect = !sat.active.load() || (sat.instanceId.load() != instanceId);
-    }
-    
-    if (needsReconnect)
-    {
-        // First, clear our old slot if we had one and it was ours
-        if (slotIndex >= 0 && slotIndex < MAX_SATELLITES)
-        {
-            auto& oldSat = data->satellites[slotIndex];
-            if (oldSat.instanceId.load() == instanceId)
-            {
-                oldSat.active.store(false);
-                oldSat.instanceId.store(0);
-                oldSat.lastUpdateTime.store(0);
-            }
-        }
-        
-        // Find a new slot
-        slotIndex = data->findAvailableSlot();
-        if (slotIndex >= 0)
-        {
-            auto& sat = data->satellites[slotIndex];
-            sat.active.store(true);
-            sat.instanceId.store(instanceId);  // Claim with our unique ID
-            sat.lastUpdateTime.store(currentTime);
-            sat.sourceType.store(sourceType);
-            std::strncpy(sat.channelName, channelName.toRawUTF8(), 63);
-            sat.channelName[63] = '\0';
-            DBG("AR3S Satellite [" + juce::String(instanceId) + "]: Re-connected to slot " + juce::String(slotIndex));
-        }
-        else
+        index = reclaimSlot(index, onAudioThread, currentTime);
+        if (index < 0)
         {
             lastSharedMemoryUpdateTime = currentTime;
             return; // No slot available
         }
     }
     
-    auto& sat = data->satellites[slotIndex];
+    auto& sat = data->satellites[index];
     
     // Send post-processing levels to shared memory (what the master sees)
     sat.rmsDb.store(postRmsDb.load());
@@ -178,25 +223,35 @@ void SatelliteProcessor::updateSharedMemory()
     sat.crestDb.store(postCrestDb.load());
     sat.phaseCorrelation.store(postPhaseCorrelation.load());
     sat.currentGain.store(currentAppliedGain.load());
+    sat.cpuAverageMicros.store(loadMeter.getAverageMicros());
+    sat.cpuMaxMicros.store(loadMeter.getMaxMicros());
+    sat.cpuAverageLoad.store(loadMeter.getAverageLoad());
+    sat.cpuPeakLoad.store(loadMeter.getPeakLoad());
+    sat.overrunCount.store(loadMeter.getIncidents().getOverrunCount());
+    sat.nearMissCount.store(loadMeter.getIncidents().getNearMissCount());
     sat.lastUpdateTime.store(currentTime);
-    sat.active.store(true);  // Keep confirming we're active
     
     lastSharedMemoryUpdateTime = currentTime;
 }
 
 void SatelliteProcessor::readMasterControls()
 {
-    if (!sharedMemory.isValid() || slotIndex < 0)
+    AR3S_TRACE_SCOPE("readMasterControls");
+    const int index = slotIndex.load();
+    if (!sharedMemory.isValid() || index < 0)
         return;
     
     auto* data = sharedMemory.getData();
-    auto& sat = data->satellites[slotIndex];
+    auto& sat = data->satellites[index];
+    
+    // Apply queued commands first (even under local override, so the queue never backs up)
+    drainMasterCommands(sat);
     
     // Check if per-satellite override is active
-    bool perSatelliteOverride = sat.control.perSatelliteOverride.load();
+    bool perSatelliteOverride = slotControl.active;
     bool masterControl = sat.control.controlledByMaster.load();
     auto controlTime = sat.control.controlUpdateTime.load();
-    auto currentTime = juce::Time::currentTimeMillis();
+    auto currentTime = getMonotonicMillis();
 
     // Master control valid if flag is set AND control was updated recently (within 5 seconds)
     bool validMasterControl = masterControl && (currentTime - controlTime < 5000);
@@ -209,7 +264,7 @@ void SatelliteProcessor::readMasterControls()
     // If per-satellite override is active, use those values
     if (perSatelliteOverride)
     {
-        float satGainDb = sat.control.gainDb.load();
+        float satGainDb = slotControl.gainDb;
         satGainDb = juce::jlimit(-24.0f, 12.0f, satGainDb);
         if (auto* gainParam = parameters.getParameter("gain"))
         {
@@ -217,20 +272,20 @@ void SatelliteProcessor::readMasterControls()
             gainParam->setValueNotifyingHost(normalized);
         }
 
-        float satTargetDb = sat.control.targetDb.load();
+        float satTargetDb = slotControl.targetDb;
         if (auto* targetParam = parameters.getParameter("target_db"))
         {
             float normTarget = (satTargetDb - (-48.0f)) / (0.0f - (-48.0f));
             targetParam->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, normTarget));
         }
 
-        bool satAuto = sat.control.autoEnabled.load();
+        bool satAuto = slotControl.autoEnabled;
         if (auto* autoParam = parameters.getParameter("auto_enabled"))
         {
             autoParam->setValueNotifyingHost(satAuto ? 1.0f : 0.0f);
         }
 
-        float satRider = sat.control.riderAmount.load();
+        float satRider = slotControl.riderAmount;
         if (auto* riderParam = parameters.getParameter("rider_amount"))
         {
             riderParam->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, satRider));
@@ -270,6 +325,68 @@ void SatelliteProcessor::readMasterControls()
     }
 }
 
+void SatelliteProcessor::drainMasterCommands(SatelliteData& sat)
+{
+    // Audio thread only - the satellite is the queue's single consumer
+    auto& queue = sat.commands;
+    const bool resync = queue.resyncRequested.exchange(false);
+    if (commandResyncPending.exchange(false) || resync)
+    {
+        // The snapshot holds the last command the master sent, including dropped ones.
+        // It is written before each push, so skipping first can't lose a command.
+        queue.skipAll();
+        SatelliteCommand latest;
+        if (!sat.lastCommand.load(latest))
+        {
+            commandResyncPending.store(true);  // Mid-write - try again next block
+            return;
+        }
+        
+        slotControl.active = latest.type == SatelliteCommandType::SetControl;
+        if (slotControl.active)
+        {
+            slotControl.gainDb = latest.gainDb;
+            slotControl.targetDb = latest.targetDb;
+            slotControl.riderAmount = latest.riderAmount;
+            slotControl.autoEnabled = latest.autoEnabled;
+        }
+    }
+    
+    const auto committedBatch = sharedMemory.getData()->committedBatch.load(std::memory_order_acquire);
+    SatelliteCommand command;
+    uint64_t lastApplied = 0;
+    const auto nowUs = getMonotonicMicros();
+    
+    while (queue.pop(command, committedBatch))
+    {
+        if (command.type != SatelliteCommandType::None && command.issuedAtUs > 0)
+            sat.commandLatency.record(nowUs - command.issuedAtUs);
+        
+        switch (command.type)
+        {
+            case SatelliteCommandType::SetControl:
+                slotControl.active = true;
+                slotControl.gainDb = command.gainDb;
+                slotControl.targetDb = command.targetDb;
+                slotControl.riderAmount = command.riderAmount;
+                slotControl.autoEnabled = command.autoEnabled;
+                break;
+            case SatelliteCommandType::ReleaseControl:
+                slotControl.active = false;
+                break;
+            case SatelliteCommandType::None:
+                continue;  // Skipped entry
+        }
+        lastApplied = command.sequence;
+    }
+    
+    if (lastApplied != 0)
+    {
+        sat.appliedCommandSequence.store(lastApplied);
+        loadMeter.markStage(StageCommands);
+    }
+}
+
 void SatelliteProcessor::prepareToPlay(double sampleRate, int)
 {
     currentSampleRate = sampleRate;
@@ -281,6 +398,11 @@ void SatelliteProcessor::prepareToPlay(double sampleRate, int)
     riderAttackCoeff = std::exp(-1.0 / (sampleRate * 0.08));
     riderReleaseCoeff = std::exp(-1.0 / (sampleRate * 0.3));
     
+    bandAnalyzer.prepare(sampleRate);
+    loudnessMeter.prepare(sampleRate);
+    truePeakDetector.reset();
+    loadMeter.prepare(sampleRate);
+    
     // Reconnect if needed
     if (!sharedMemory.isValid())
         connectToSharedMemory();
@@ -302,6 +424,9 @@ bool SatelliteProcessor::isBusesLayoutSupported(const BusesLayout& layouts) cons
 void SatelliteProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
+    const ProcessingLoadMeter::ScopedBlock loadScope(loadMeter, buffer.getNumSamples());
+    AR3S_TRACE_THREAD_NAME("audio");
+    AR3S_TRACE_SCOPE("satellite processBlock");
     
     // Read controls from master if needed
     readMasterControls();
@@ -309,11 +434,22 @@ void SatelliteProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
     const auto numChannels = buffer.getNumChannels();
     const auto numSamples = buffer.getNumSamples();
     
+    // Group offsets: one write on the master moves every member of the group
+    float groupGainDb = 0.0f, groupTargetDb = 0.0f, groupCeilingDb = 0.0f;
+    const int groupIndex = groupId.load();
+    if (groupIndex > 0 && sharedMemory.isValid())
+    {
+        const auto& group = sharedMemory.getData()->groups[groupIndex];
+        groupGainDb = group.gainOffsetDb.load(std::memory_order_relaxed);
+        groupTargetDb = group.targetOffsetDb.load(std::memory_order_relaxed);
+        groupCeilingDb = group.ceilingOffsetDb.load(std::memory_order_relaxed);
+    }
+    
     // Get parameters - gain is now in dB
-    const float gainDb = *parameters.getRawParameterValue("gain");
+    const float gainDb = juce::jlimit(-48.0f, 24.0f, *parameters.getRawParameterValue("gain") + groupGainDb);
     const float manualGain = dbToLinear(gainDb);  // Convert dB to linear
-    const float targetDb = *parameters.getRawParameterValue("target_db");
-    const float ceilingDb = *parameters.getRawParameterValue("ceiling");
+    const float targetDb = juce::jlimit(-48.0f, 0.0f, *parameters.getRawParameterValue("target_db") + groupTargetDb);
+    const float ceilingDb = juce::jlimit(-24.0f, 0.0f, *parameters.getRawParameterValue("ceiling") + groupCeilingDb);
     const bool autoEnabled = *parameters.getRawParameterValue("auto_enabled") > 0.5f;
     const float riderAmount = *parameters.getRawParameterValue("rider_amount");
     
@@ -411,6 +547,7 @@ void SatelliteProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
     // Transparent peak limiting with smooth gain reduction to avoid pumping
     if (ceilingDb < -0.1f)  // Only apply if ceiling is below 0 dB
     {
+        loadMeter.markStage(StageCeiling);
         float ceilingLinear = dbToLinear(ceilingDb);
         const int numChannels = buffer.getNumChannels();
         const int numSamples = buffer.getNumSamples();
@@ -461,6 +598,12 @@ void SatelliteProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
         ceilingSmoothedGain = 1.0f;
     }
     
+    // ============ AUDIO STREAMING TO MASTER ============
+    streamAudioToMaster(buffer);
+    
+    // ============ LOCAL ANALYSIS (LOUDNESS / BANDS) ============
+    runAnalysisProfile(buffer);
+    
     // ============ POST-PROCESSING METERING ============
     float postSumSquaresL = 0.0f, postSumSquaresR = 0.0f;
     float postPeak = 0.0f;
@@ -509,8 +652,189 @@ void SatelliteProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
     postPeakDb.store(postPeakDbVal);
     postCrestDb.store(postPeakDbVal - postRmsDbVal);
     
+    // Accumulate the history window so each frame covers the full 50 ms, not just one block
+    historySumSquares += postTotalSumSquares;
+    historyPeak = std::max(historyPeak, postPeak);
+    historySampleCount += numSamples;
+    historyValueCount += numChannels * numSamples;
+    
     // Update shared memory with latest data
-    updateSharedMemory();
+    const auto previousUpdateTime = lastSharedMemoryUpdateTime.load();
+    updateSharedMemory(true);
+    if (lastSharedMemoryUpdateTime != previousUpdateTime)
+        loadMeter.markStage(StageIpcPush);
+    pushMeterHistory();
+}
+
+void SatelliteProcessor::streamAudioToMaster(const juce::AudioBuffer<float>& buffer)
+{
+    AR3S_TRACE_SCOPE("streamAudioToMaster");
+    // Audio thread only - the audio ring has a single producer
+    const int index = slotIndex.load();
+    if (!sharedMemory.isValid() || index < 0 || buffer.getNumChannels() == 0)
+        return;
+    
+    auto& sat = sharedMemory.getData()->satellites[index];
+    auto& ring = sat.audio;
+    
+    // Streaming is opt-in: the master asks for it per slot
+    const int requested = juce::jlimit(0, 64, sat.control.audioStreamDecimation.load());
+    if (requested != streamDecimation || streamSlotGeneration != slotGeneration.load())
+    {
+        streamDecimation = requested;
+        streamSlotGeneration = slotGeneration.load();
+        ring.reset(requested, requested > 0 ? currentSampleRate / requested : 0.0);
+        streamAccumL = streamAccumR = 0.0f;
+        streamAccumCount = 0;
+    }
+    
+    if (streamDecimation <= 0)
+        return;
+    
+    const int numSamples = buffer.getNumSamples();
+    const auto* left = buffer.getReadPointer(0);
+    const auto* right = buffer.getNumChannels() > 1 ? buffer.getReadPointer(1) : left;
+    
+    // Anchor the next frame on the host timeline. It started streamAccumCount
+    // samples before this block.
+    int64_t timeline = -1;
+    if (auto* playHead = getPlayHead())
+        if (auto position = playHead->getPosition())
+            if (position->getIsPlaying())
+                if (auto samplePosition = position->getTimeInSamples())
+                    timeline = *samplePosition - streamAccumCount;
+    ring.setAnchor(timeline, getMonotonicMillis());
+    
+    // Boxcar-average each group of streamDecimation samples into one frame
+    const int numFrames = (streamAccumCount + numSamples) / streamDecimation;
+    const float scale = 1.0f / static_cast<float>(streamDecimation);
+    int written = 0;
+    
+    ring.beginWrite(numFrames);
+    for (int i = 0; i < numSamples; ++i)
+    {
+        streamAccumL += left[i];
+        streamAccumR += right[i];
+        if (++streamAccumCount == streamDecimation)
+        {
+            ring.writeFrame(written++, streamAccumL * scale, streamAccumR * scale);
+            streamAccumL = streamAccumR = 0.0f;
+            streamAccumCount = 0;
+        }
+    }
+    ring.endWrite(written);
+    loadMeter.markStage(StageAudioStream);
+}
+
+void SatelliteProcessor::runAnalysisProfile(const juce::AudioBuffer<float>& buffer)
+{
+    AR3S_TRACE_SCOPE("runAnalysisProfile");
+    // Audio thread only. Each profile adds to the cheaper one below it, so
+    // large sessions can trade detail for CPU per track.
+    const int profile = static_cast<int>(parameters.getRawParameterValue("analysis")->load());
+    if (profile != activeAnalysisProfile.load())
+    {
+        activeAnalysisProfile.store(profile);
+        loudnessMeter.reset();
+        truePeakDetector.reset();
+        
+        const int index = slotIndex.load();
+        if (sharedMemory.isValid() && index >= 0)
+        {
+            // Don't leave readings from a richer profile behind
+            auto& sat = sharedMemory.getData()->satellites[index];
+            sat.analysisProfile.store(profile);
+            sat.momentaryLufs.store(-120.0f);
+            sat.shortTermLufs.store(-120.0f);
+            sat.integratedLufs.store(-120.0f);
+            sat.truePeakDb.store(-120.0f);
+            if (profile < 2)
+                sat.clearBands();
+        }
+    }
+    
+    if (profile >= 1)
+        analyseLoudness(buffer);
+    if (profile >= 2)
+        analyseBands(buffer);
+}
+
+void SatelliteProcessor::analyseLoudness(const juce::AudioBuffer<float>& buffer)
+{
+    // Audio thread only
+    if (buffer.getNumChannels() == 0)
+        return;
+    
+    const auto* left = buffer.getReadPointer(0);
+    const auto* right = buffer.getNumChannels() > 1 ? buffer.getReadPointer(1) : nullptr;
+    truePeakDetector.process(left, right, buffer.getNumSamples());
+    if (!loudnessMeter.process(left, right, buffer.getNumSamples()))
+        return;
+    
+    loadMeter.markStage(StageLoudness);
+    
+    // Published once per 100 ms block; true peak is the block maximum
+    const float truePeak = linearToDb(truePeakDetector.getAndResetPeak());
+    const int index = slotIndex.load();
+    if (!sharedMemory.isValid() || index < 0)
+        return;
+    
+    auto& sat = sharedMemory.getData()->satellites[index];
+    sat.momentaryLufs.store(loudnessMeter.getMomentaryLufs(), std::memory_order_relaxed);
+    sat.shortTermLufs.store(loudnessMeter.getShortTermLufs(), std::memory_order_relaxed);
+    sat.integratedLufs.store(loudnessMeter.getIntegratedLufs(), std::memory_order_relaxed);
+    sat.truePeakDb.store(truePeak, std::memory_order_relaxed);
+}
+
+void SatelliteProcessor::analyseBands(const juce::AudioBuffer<float>& buffer)
+{
+    // Audio thread only
+    if (buffer.getNumChannels() == 0)
+        return;
+    
+    const auto* left = buffer.getReadPointer(0);
+    const auto* right = buffer.getNumChannels() > 1 ? buffer.getReadPointer(1) : nullptr;
+    if (!bandAnalyzer.process(left, right, buffer.getNumSamples()))
+        return;
+    
+    loadMeter.markStage(StageFftFrame);
+    
+    const int index = slotIndex.load();
+    if (!sharedMemory.isValid() || index < 0)
+        return;
+    
+    // Seqlock-style: odd while the bands are being written, so readers can retry
+    auto& sat = sharedMemory.getData()->satellites[index];
+    const auto& bands = bandAnalyzer.getBandsDb();
+    const auto version = sat.bandsVersion.load(std::memory_order_relaxed);
+    sat.bandsVersion.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int k = 0; k < NUM_ANALYSIS_BANDS; ++k)
+        sat.bandEnergyDb[k].store(bands[(size_t) k], std::memory_order_relaxed);
+    sat.bandsVersion.store(version + 2, std::memory_order_release);
+}
+
+void SatelliteProcessor::pushMeterHistory()
+{
+    AR3S_TRACE_SCOPE("pushMeterHistory");
+    // Audio thread only - the history ring has a single producer
+    const int framesPerEntry = static_cast<int>(currentSampleRate / MeterHistoryRing::RATE_HZ);
+    if (historySampleCount < framesPerEntry)
+        return;
+    
+    const int index = slotIndex.load();
+    if (sharedMemory.isValid() && index >= 0)
+    {
+        const float rmsDb = linearToDb(std::sqrt(historySumSquares / static_cast<float>(std::max(1, historyValueCount))));
+        const float peakDb = linearToDb(historyPeak);
+        loadMeter.markStage(StageIpcPush);
+        sharedMemory.getData()->satellites[index].history.push(getMonotonicMillis(), rmsDb, peakDb, peakDb - rmsDb);
+    }
+    
+    historySumSquares = 0.0f;
+    historyPeak = 0.0f;
+    historySampleCount = 0;
+    historyValueCount = 0;
 }
 
 bool SatelliteProcessor::hasEditor() const { return true; }
@@ -535,7 +859,7 @@ void SatelliteProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
     juce::XmlElement xml("SatelliteState");
     xml.setAttribute("channelName", channelName);
-    xml.setAttribute("sourceType", sourceType);
+    xml.setAttribute("sourceType", sourceType.load());
     
     auto state = parameters.copyState();
     xml.addChildElement(state.createXml().release());
@@ -549,16 +873,18 @@ void SatelliteProcessor::setStateInformation(const void* data, int sizeInBytes)
     if (xmlState != nullptr)
     {
         channelName = xmlState->getStringAttribute("channelName", "Channel");
-        sourceType = xmlState->getIntAttribute("sourceType", 0);
+        sourceType.store(xmlState->getIntAttribute("sourceType", 0));
         
         if (auto* paramsXml = xmlState->getChildByName(parameters.state.getType()))
             parameters.replaceState(juce::ValueTree::fromXml(*paramsXml));
         
+        setGroupId(static_cast<int>(parameters.getRawParameterValue("group")->load()));
+        
         // Update shared memory
-        if (sharedMemory.isValid() && slotIndex >= 0)
+        if (isConnected())
         {
             setChannelName(channelName);
-            setSourceType(sourceType);
+            setSourceType(sourceType.load());
         }
     }
 }
@@ -603,6 +929,20 @@ juce::AudioProcessorValueTreeState::ParameterLayout SatelliteProcessor::createPa
                            "Synth", "Strings", "Other" },
         0));
     
+    // Group (bus) this track belongs to
+    juce::StringArray groupNames;
+    for (int group = 0; group <= MAX_SATELLITE_GROUPS; ++group)
+        groupNames.add(getSatelliteGroupName(group));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "group", "Group", groupNames, 0));
+    
+    // How much analysis runs locally: Lite = RMS/peak, Standard = + LUFS/true peak,
+    // Full = + 1/3-octave bands for the master's masking view
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "analysis", "Analysis",
+        juce::StringArray { "Lite", "Standard", "Full" },
+        2));
+    
     return { params.begin(), params.end() };
 }
 
@@ -633,7 +973,29 @@ int SatelliteProcessor::getMasterKnobStyle() const
 void SatelliteProcessor::timerCallback()
 {
     // Keep satellite active in shared memory even when not processing audio
-    updateSharedMemory();
+    updateSharedMemory(false);
+    
+    // A slot claimed on the audio thread gets its name from here
+    if (channelNamePending.exchange(false))
+        publishChannelName();
+    
+   #if AR3S_ENABLE_TRACING
+    // The master asks every process to dump its own trace ring, once per process
+    if (sharedMemory.isValid())
+    {
+        const auto request = sharedMemory.getData()->traceExportRequest.load();
+        if (request != lastTraceExportRequest)
+        {
+            lastTraceExportRequest = request;
+            if (TraceRecorder::getInstance().claimExport(request))
+            {
+                juce::Thread::launch([] {
+                    TraceRecorder::getInstance().writeChromeTrace(TraceRecorder::getDefaultTraceFile());
+                });
+            }
+        }
+    }
+   #endif
 }
 
 void SatelliteProcessor::parameterChanged(const juce::String& parameterID, float newValue)
@@ -643,6 +1005,10 @@ void SatelliteProcessor::parameterChanged(const juce::String& parameterID, float
         int newSourceType = static_cast<int>(newValue);
         setSourceType(newSourceType);
     }
+    else if (parameterID == "group")
+    {
+        setGroupId(static_cast<int>(newValue));
+    }
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -3,6 +3,9 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include "SharedMemory.h"
+#include "SatelliteAnalysis.h"
+#include "PerformanceMonitor.h"
+#include "TraceRecorder.h"
 
 class SatelliteProcessor : public juce::AudioProcessor,
                           private juce::AudioProcessorValueTreeState::Listener,
@@ -57,13 +60,16 @@ public:
     // Channel info
     juce::String getChannelName() const { return channelName; }
     void setChannelName(const juce::String& name);
-    int getSourceType() const { return sourceType; }
+    int getSourceType() const { return sourceType.load(); }
     void setSourceType(int type);
+    int getGroupId() const { return groupId.load(); }
+    const ProcessingLoadMeter& getLoadMeter() const { return loadMeter; }
+    void setGroupId(int group);
     
     // Connection status
     bool isConnected() const { return sharedMemory.isValid() && slotIndex >= 0; }
     bool isControlledByMaster() const { return controlledByMaster.load(); }
-    int getSlotIndex() const { return slotIndex; }
+    int getSlotIndex() const { return slotIndex.load(); }
     int getMasterThemeIndex() const;  // Get theme from master via shared memory
     int getMasterKnobStyle() const;   // Get knob style from master via shared memory
     
@@ -77,8 +83,18 @@ public:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
 private:
+    // Declared first so the log writer outlives everything that logs
+    RealtimeLogger::Session logSession { "satellite" };
+    
     SharedMemoryManager sharedMemory;
-    int slotIndex = -1;
+    // Re-claimed by whichever thread notices it is missing (see reclaimSlot), read everywhere
+    std::atomic<int> slotIndex { -1 };
+    std::atomic<uint32_t> slotGeneration { 0 };  // Ownership generation of our slot
+    std::atomic<bool> slotClaimBusy { false };  // One thread claims at a time
+    std::atomic<bool> slotOutage { false };  // Every slot was busy last time we tried
+    int64_t nextTakeoverAttemptMs = 0;  // Takeover backoff (message thread only)
+    int takeoverBackoffMs = 0;
+    std::atomic<bool> channelNamePending { false };  // Slot claimed, name not yet written (message thread)
     
     // Metering - Pre (input) and Post (output)
     std::atomic<float> preRmsDb { -120.0f };
@@ -95,7 +111,8 @@ private:
     
     // Channel info
     juce::String channelName { "Channel" };
-    int sourceType = 0;
+    std::atomic<int> sourceType { 0 };  // Set on the message thread, read when (re-)claiming a slot
+    std::atomic<int> groupId { 0 };     // Set on the message thread, read by processBlock
     
     // Unique instance ID (generated on construction)
     uint64_t instanceId = 0;
@@ -115,13 +132,61 @@ private:
     
     juce::AudioProcessorValueTreeState parameters;
     
-    // Rate limiting for shared memory updates
-    int64_t lastSharedMemoryUpdateTime = 0;
+    // Rate limiting for shared memory updates (audio thread and timer)
+    std::atomic<int64_t> lastSharedMemoryUpdateTime { 0 };
+    
+    // Metering history window (accumulated on the audio thread, pushed at 20 Hz)
+    float historySumSquares = 0.0f;
+    float historyPeak = 0.0f;
+    int historySampleCount = 0;
+    int historyValueCount = 0;
+    
+    // Audio streaming state (audio thread only)
+    int streamDecimation = 0;
+    uint32_t streamSlotGeneration = 0;
+    float streamAccumL = 0.0f;
+    float streamAccumR = 0.0f;
+    int streamAccumCount = 0;
+    
+    // Per-satellite control as applied from the master's command queue (audio thread only)
+    struct SlotControl
+    {
+        bool active = false;
+        float gainDb = 0.0f;
+        float targetDb = -18.0f;
+        float riderAmount = 0.0f;
+        bool autoEnabled = false;
+    };
+    SlotControl slotControl;
+    std::atomic<bool> commandResyncPending { true };  // Re-read the control snapshot before draining
+    
+    // 1/3-octave band analysis of the post-gain signal (audio thread only)
+    ThirdOctaveAnalyzer bandAnalyzer;
+    
+    // K-weighted loudness and true peak of the post-gain signal (audio thread only)
+    LoudnessMeter loudnessMeter;
+    TruePeakDetector truePeakDetector;
+    std::atomic<int> activeAnalysisProfile { -1 };  // -1 forces a republish
+    
+    // processBlock cost against the block deadline, published with the metering
+    ProcessingLoadMeter loadMeter;
+    
+    // Last trace export request seen from the master (message thread only)
+    uint32_t lastTraceExportRequest = 0;
     
     void connectToSharedMemory();
+    bool claimSharedMemorySlot(bool allowTakeover);
+    int reclaimSlot(int lostIndex, bool onAudioThread, int64_t nowMs);
     void disconnectFromSharedMemory();
-    void updateSharedMemory();
+    void publishChannelName();
+    void updateSharedMemory(bool onAudioThread);
     void readMasterControls();
+    void drainMasterCommands(SatelliteData& sat);
+    void pushMeterHistory();
+    void streamAudioToMaster(const juce::AudioBuffer<float>& buffer);
+    void runAnalysisProfile(const juce::AudioBuffer<float>& buffer);
+    void analyseLoudness(const juce::AudioBuffer<float>& buffer);
+    void analyseBands(const juce::AudioBuffer<float>& buffer);
     void parameterChanged(const juce::String& parameterID, float newValue) override;
     void timerCallback() override;
 
@@ -1,10 +1,15 @@
 #pragma once
 
 #include <juce_core/juce_core.h>
+#include "Logger.h"
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <signal.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
 #include <cstring>
 #include <vector>
 
@@ -12,6 +17,40 @@
 // Max 32 satellite channels
 constexpr int MAX_SATELLITES = 32;
 
+// A slot whose owner is alive but has stopped heartbeating (hung host) is
+// considered abandoned after this long
+constexpr int64_t SATELLITE_STALE_TIMEOUT_MS = 5000;
+
+// 1/3-octave bands published by each satellite (31.5 Hz - 16 kHz)
+constexpr int NUM_ANALYSIS_BANDS = 28;
+
+// Heartbeats and control timestamps use the system-wide monotonic clock so
+// wall-clock jumps (NTP, DST, user changing the time) never evict live tracks.
+// steady_clock is CLOCK_MONOTONIC on Linux and mach_absolute_time on macOS: both
+// share their epoch across processes on the same machine, and both stop while
+// it sleeps, so heartbeats don't go stale just from the lid being closed.
+inline int64_t getMonotonicMillis()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Same clock in microseconds, for timing master -> satellite propagation
+inline int64_t getMonotonicMicros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// True if a process with this PID still exists (EPERM means it exists but
+// belongs to another user, which still counts as alive)
+inline bool isProcessAlive(int32_t pid)
+{
+    if (pid <= 0)
+        return false;
+    return ::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+}
+
 // Control data sent FROM master TO satellite
 struct SatelliteControlData
 {
@@ -25,7 +64,445 @@ struct SatelliteControlData
     std::atomic<float> noiseReductionDb { 12.0f }; // Noise gate reduction
     std::atomic<bool> controlledByMaster { false }; // Whether master is controlling this satellite (global/master control)
     std::atomic<bool> perSatelliteOverride { false }; // If true, use per-satellite values below
-    std::atomic<int64_t> controlUpdateTime { 0 };  // When controls were last updated
+    std::atomic<int64_t> controlUpdateTime { 0 };  // When controls were last updated (monotonic ms)
+    std::atomic<int> audioStreamDecimation { 0 }; // Audio streaming request: 0 = off, 1 = full rate, N = every Nth sample
+};
+
+// Satellite groups (drum/vocal/music buses). Group 0 means "not in a group".
+constexpr int MAX_SATELLITE_GROUPS = 8;
+
+inline const char* getSatelliteGroupName(int groupId)
+{
+    static const char* const names[MAX_SATELLITE_GROUPS + 1] = {
+        "None", "Drums", "Vocals", "Music", "Bass", "FX", "Group 6", "Group 7", "Group 8"
+    };
+    return (groupId >= 0 && groupId <= MAX_SATELLITE_GROUPS) ? names[groupId] : names[0];
+}
+
+// Group-level offsets, written once by the master and combined with each
+// member's own values by the satellites themselves
+struct SatelliteGroupData
+{
+    std::atomic<float> gainOffsetDb { 0.0f };
+    std::atomic<float> targetOffsetDb { 0.0f };
+    std::atomic<float> ceilingOffsetDb { 0.0f };
+};
+
+// Discrete commands sent FROM master TO one satellite
+enum class SatelliteCommandType : int32_t
+{
+    None = 0,
+    SetControl,      // Take per-satellite control with the given values
+    ReleaseControl   // Hand control back to the satellite
+};
+
+// Plain copy of a command, as built by the master and applied by the satellite
+struct SatelliteCommand
+{
+    SatelliteCommandType type = SatelliteCommandType::None;
+    uint64_t sequence = 0;   // Position in the slot's queue (1-based)
+    uint32_t batchId = 0;    // 0 = apply immediately, else wait until the batch is committed
+    float gainDb = 0.0f;
+    float targetDb = -18.0f;
+    float ceilingDb = 0.0f;
+    float riderAmount = 0.0f;
+    bool autoEnabled = false;
+    int64_t issuedAtUs = 0;  // Monotonic time the master queued it
+};
+
+struct SatelliteCommandEntry
+{
+    std::atomic<uint64_t> sequence { 0 };
+    std::atomic<uint32_t> batchId { 0 };
+    std::atomic<int32_t> type { 0 };
+    std::atomic<int64_t> issuedAtUs { 0 };
+    std::atomic<float> gainDb { 0.0f };
+    std::atomic<float> targetDb { -18.0f };
+    std::atomic<float> ceilingDb { 0.0f };
+    std::atomic<float> riderAmount { 0.0f };
+    std::atomic<bool> autoEnabled { false };
+};
+
+// Bounded single-producer (master) / single-consumer (satellite audio thread)
+// command ring. The satellite drains it at block boundaries so every command is
+// applied whole and in order. If the ring overflows the master flags a resync and
+// the satellite falls back to the slot's SatelliteCommandSnapshot.
+struct SatelliteCommandQueue
+{
+    static constexpr int CAPACITY = 64;
+    
+    std::atomic<uint64_t> writeIndex { 0 };          // Commands pushed (master)
+    std::atomic<uint64_t> readIndex { 0 };           // Commands consumed (satellite)
+    std::atomic<bool> resyncRequested { false };     // Commands were dropped
+    SatelliteCommandEntry entries[CAPACITY];
+    
+    // Producer only. Returns false (and requests a resync) when the ring is full.
+    bool push(const SatelliteCommand& command)
+    {
+        const auto w = writeIndex.load(std::memory_order_relaxed);
+        if (w - readIndex.load(std::memory_order_acquire) >= static_cast<uint64_t>(CAPACITY))
+        {
+            resyncRequested.store(true, std::memory_order_release);
+            return false;
+        }
+        
+        auto& entry = entries[w % CAPACITY];
+        entry.batchId.store(command.batchId, std::memory_order_relaxed);
+        entry.type.store(static_cast<int32_t>(command.type), std::memory_order_relaxed);
+        entry.gainDb.store(command.gainDb, std::memory_order_relaxed);
+        entry.targetDb.store(command.targetDb, std::memory_order_relaxed);
+        entry.ceilingDb.store(command.ceilingDb, std::memory_order_relaxed);
+        entry.riderAmount.store(command.riderAmount, std::memory_order_relaxed);
+        entry.autoEnabled.store(command.autoEnabled, std::memory_order_relaxed);
+        entry.issuedAtUs.store(command.issuedAtUs, std::memory_order_relaxed);
+        entry.sequence.store(w + 1, std::memory_order_relaxed);
+        writeIndex.store(w + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Consumer only. Pops the next command unless it belongs to a batch newer
+    // than committedBatch (those stay queued so the whole batch lands together).
+    bool pop(SatelliteCommand& command, uint32_t committedBatch)
+    {
+        const auto r = readIndex.load(std::memory_order_relaxed);
+        if (r == writeIndex.load(std::memory_order_acquire))
+            return false;
+        
+        const auto& entry = entries[r % CAPACITY];
+        command.sequence = entry.sequence.load(std::memory_order_relaxed);
+        command.batchId = entry.batchId.load(std::memory_order_relaxed);
+        if (command.batchId != 0 && command.batchId > committedBatch)
+            return false;
+        
+        command.type = static_cast<SatelliteCommandType>(entry.type.load(std::memory_order_relaxed));
+        command.gainDb = entry.gainDb.load(std::memory_order_relaxed);
+        command.targetDb = entry.targetDb.load(std::memory_order_relaxed);
+        command.ceilingDb = entry.ceilingDb.load(std::memory_order_relaxed);
+        command.riderAmount = entry.riderAmount.load(std::memory_order_relaxed);
+        command.autoEnabled = entry.autoEnabled.load(std::memory_order_relaxed);
+        command.issuedAtUs = entry.issuedAtUs.load(std::memory_order_relaxed);
+        readIndex.store(r + 1, std::memory_order_release);
+        
+        // A sequence mismatch means a torn or foreign entry - skip it
+        if (command.sequence != r + 1)
+            command.type = SatelliteCommandType::None;
+        return true;
+    }
+    
+    // Consumer only: drop everything queued (after a resync or a new slot owner)
+    void skipAll()
+    {
+        readIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+    }
+};
+
+// The last per-satellite command the master queued. Only the master's command path
+// writes it (the global push rewrites SatelliteControlData, so that can't stand in
+// for the per-track values); the satellite resyncs from it after an overflow.
+struct SatelliteCommandSnapshot
+{
+    std::atomic<uint32_t> sequence { 0 };  // Odd while the master is writing
+    std::atomic<bool> active { false };    // false = control released
+    std::atomic<float> gainDb { 0.0f };
+    std::atomic<float> targetDb { -18.0f };
+    std::atomic<float> riderAmount { 0.0f };
+    std::atomic<bool> autoEnabled { false };
+    
+    // Master only (under its command lock)
+    void store(const SatelliteCommand& command)
+    {
+        const auto next = sequence.load(std::memory_order_relaxed) + 1;
+        sequence.store(next, std::memory_order_relaxed);  // Odd = updating
+        std::atomic_thread_fence(std::memory_order_release);
+        active.store(command.type == SatelliteCommandType::SetControl, std::memory_order_relaxed);
+        gainDb.store(command.gainDb, std::memory_order_relaxed);
+        targetDb.store(command.targetDb, std::memory_order_relaxed);
+        riderAmount.store(command.riderAmount, std::memory_order_relaxed);
+        autoEnabled.store(command.autoEnabled, std::memory_order_relaxed);
+        sequence.store(next + 1, std::memory_order_release);
+    }
+    
+    // Copies the snapshot into command (SetControl or ReleaseControl).
+    // Returns false if the master kept rewriting it while we read.
+    bool load(SatelliteCommand& command) const
+    {
+        for (int attempt = 0; attempt < 4; ++attempt)
+        {
+            const auto expected = sequence.load(std::memory_order_acquire);
+            if (expected & 1u)
+                continue;
+            
+            command.type = active.load(std::memory_order_relaxed) ? SatelliteCommandType::SetControl
+                                                                  : SatelliteCommandType::ReleaseControl;
+            command.gainDb = gainDb.load(std::memory_order_relaxed);
+            command.targetDb = targetDb.load(std::memory_order_relaxed);
+            command.riderAmount = riderAmount.load(std::memory_order_relaxed);
+            command.autoEnabled = autoEnabled.load(std::memory_order_relaxed);
+            
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == expected)
+                return true;
+        }
+        
+        return false;
+    }
+    
+    void reset()
+    {
+        SatelliteCommand released;
+        released.type = SatelliteCommandType::ReleaseControl;
+        store(released);
+    }
+};
+
+// How long commands took from the master's push to the satellite applying them,
+// in log2 microsecond buckets (bucket k covers [2^k, 2^(k+1)) us). Written only
+// by the satellite that owns the slot; the master sums it across slots.
+struct IpcLatencyHistogram
+{
+    static constexpr int NUM_BUCKETS = 24;  // Last bucket holds everything from ~8 s up
+    
+    std::atomic<uint32_t> counts[NUM_BUCKETS] {};
+    std::atomic<int64_t> lastLatencyUs { 0 };
+    
+    static int bucketFor(int64_t latencyUs)
+    {
+        int bucket = 0;
+        while (latencyUs > 1 && bucket < NUM_BUCKETS - 1)
+        {
+            latencyUs >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+    
+    // Upper edge of a bucket, in microseconds
+    static int64_t bucketLimitUs(int bucket)
+    {
+        return int64_t { 1 } << (bucket + 1);
+    }
+    
+    void record(int64_t latencyUs)
+    {
+        latencyUs = std::max<int64_t>(0, latencyUs);
+        counts[bucketFor(latencyUs)].fetch_add(1, std::memory_order_relaxed);
+        lastLatencyUs.store(latencyUs, std::memory_order_relaxed);
+    }
+    
+    void reset()
+    {
+        for (auto& count : counts)
+            count.store(0, std::memory_order_relaxed);
+        lastLatencyUs.store(0, std::memory_order_relaxed);
+    }
+};
+
+// One timestamped metering frame in a satellite's history ring
+struct MeterHistoryFrame
+{
+    std::atomic<uint32_t> sequence { 0 };  // Odd while the satellite is writing the frame
+    std::atomic<int64_t> timeMs { 0 };     // Monotonic ms
+    std::atomic<float> rmsDb { -120.0f };
+    std::atomic<float> peakDb { -120.0f };
+    std::atomic<float> crestDb { 0.0f };
+};
+
+// Plain copy of a history frame handed out to readers
+struct MeterHistoryPoint
+{
+    int64_t timeMs = 0;
+    float rmsDb = -120.0f;
+    float peakDb = -120.0f;
+    float crestDb = 0.0f;
+};
+
+// Fixed-size metering history (20 Hz x 60 s). Single producer (the satellite's
+// audio thread), any number of readers. Each frame carries a seqlock-style
+// sequence number so readers skip frames that are overwritten mid-read; the
+// writer never waits on readers.
+struct MeterHistoryRing
+{
+    static constexpr int RATE_HZ = 20;
+    static constexpr int CAPACITY = RATE_HZ * 60;
+    
+    std::atomic<uint64_t> writeCount { 0 };  // Total frames ever written
+    MeterHistoryFrame frames[CAPACITY];
+    
+    // Writer only: forget everything (called when a slot changes owner)
+    void reset()
+    {
+        writeCount.store(0, std::memory_order_release);
+    }
+    
+    // Writer only
+    void push(int64_t timeMs, float rmsDb, float peakDb, float crestDb)
+    {
+        const auto n = writeCount.load(std::memory_order_relaxed);
+        auto& frame = frames[n % CAPACITY];
+        const auto sequence = static_cast<uint32_t>(n * 2 + 1);
+        
+        frame.sequence.store(sequence, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        frame.timeMs.store(timeMs, std::memory_order_relaxed);
+        frame.rmsDb.store(rmsDb, std::memory_order_relaxed);
+        frame.peakDb.store(peakDb, std::memory_order_relaxed);
+        frame.crestDb.store(crestDb, std::memory_order_relaxed);
+        frame.sequence.store(sequence + 1, std::memory_order_release);
+        
+        writeCount.store(n + 1, std::memory_order_release);
+    }
+    
+    // Copies up to maxFrames of the most recent frames (oldest first) into dest.
+    // Returns the number of frames copied.
+    int read(MeterHistoryPoint* dest, int maxFrames) const
+    {
+        const auto end = writeCount.load(std::memory_order_acquire);
+        const auto count = std::min<uint64_t>(end, static_cast<uint64_t>(std::min(maxFrames, CAPACITY)));
+        
+        int copied = 0;
+        for (auto n = end - count; n < end; ++n)
+        {
+            const auto& frame = frames[n % CAPACITY];
+            const auto expected = static_cast<uint32_t>(n * 2 + 2);
+            if (frame.sequence.load(std::memory_order_acquire) != expected)
+                continue;
+            
+            MeterHistoryPoint point;
+            point.timeMs = frame.timeMs.load(std::memory_order_relaxed);
+            point.rmsDb = frame.rmsDb.load(std::memory_order_relaxed);
+            point.peakDb = frame.peakDb.load(std::memory_order_relaxed);
+            point.crestDb = frame.crestDb.load(std::memory_order_relaxed);
+            
+            // Frame was overwritten while we copied it
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (frame.sequence.load(std::memory_order_relaxed) != expected)
+                continue;
+            
+            dest[copied++] = point;
+        }
+        
+        return copied;
+    }
+};
+
+// Post-gain audio streamed FROM satellite TO master for cross-track analysis.
+// Single producer (the satellite's audio thread), any number of readers. The
+// writer always overwrites the oldest audio and never waits; readers validate
+// after copying that the frames they read weren't overwritten underneath them.
+struct SatelliteAudioRing
+{
+    static constexpr int CAPACITY = 1 << 14;  // Frames per channel (~340 ms at 48 kHz full rate)
+    static constexpr int NUM_CHANNELS = 2;
+    
+    std::atomic<uint64_t> writePosition { 0 };  // Frames published so far
+    std::atomic<uint64_t> writeReserve { 0 };   // Frames the writer may currently be overwriting up to
+    std::atomic<uint64_t> streamStart { 0 };    // First frame of the current stream
+    std::atomic<int> decimation { 0 };          // Decimation in effect (0 = not streaming)
+    std::atomic<double> frameRate { 0.0 };      // Frames per second after decimation
+    
+    // Host timeline anchor: frame anchorFrame starts at anchorTimelineSamples
+    // (host sample position, -1 when the transport isn't running). The
+    // sequence number lets readers get a consistent pair.
+    std::atomic<uint32_t> anchorSequence { 0 };
+    std::atomic<uint64_t> anchorFrame { 0 };
+    std::atomic<int64_t> anchorTimelineSamples { -1 };
+    std::atomic<int64_t> anchorTimeMs { 0 };    // Monotonic ms at the anchor
+    
+    std::atomic<float> samples[NUM_CHANNELS][CAPACITY];
+    
+    // Writer only: start a new stream (decimation change or new slot owner)
+    void reset(int newDecimation, double newFrameRate)
+    {
+        const auto position = writePosition.load(std::memory_order_relaxed);
+        writeReserve.store(position + CAPACITY, std::memory_order_relaxed);  // Invalidate everything readers might hold
+        streamStart.store(position + CAPACITY, std::memory_order_relaxed);
+        decimation.store(newDecimation, std::memory_order_relaxed);
+        frameRate.store(newFrameRate, std::memory_order_relaxed);
+        anchorTimelineSamples.store(-1, std::memory_order_relaxed);
+        writePosition.store(position + CAPACITY, std::memory_order_release);
+    }
+    
+    // Writer only: record where the next published frame sits on the host timeline
+    void setAnchor(int64_t timelineSamples, int64_t timeMs)
+    {
+        const auto sequence = anchorSequence.load(std::memory_order_relaxed) + 1;
+        anchorSequence.store(sequence, std::memory_order_relaxed);  // Odd = updating
+        std::atomic_thread_fence(std::memory_order_release);
+        anchorFrame.store(writePosition.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        anchorTimelineSamples.store(timelineSamples, std::memory_order_relaxed);
+        anchorTimeMs.store(timeMs, std::memory_order_relaxed);
+        anchorSequence.store(sequence + 1, std::memory_order_release);
+    }
+    
+    // Writer only: announce how many frames are about to be written, so readers can
+    // tell which part of the ring is unsafe
+    void beginWrite(int numFrames)
+    {
+        writeReserve.store(writePosition.load(std::memory_order_relaxed) + static_cast<uint64_t>(numFrames),
+                           std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    
+    // Writer only: store one frame at offset frames past writePosition
+    void writeFrame(int offset, float left, float right)
+    {
+        const auto index = (writePosition.load(std::memory_order_relaxed) + static_cast<uint64_t>(offset)) % CAPACITY;
+        samples[0][index].store(left, std::memory_order_relaxed);
+        samples[1][index].store(right, std::memory_order_relaxed);
+    }
+    
+    // Writer only: publish frames written since beginWrite
+    void endWrite(int numFrames)
+    {
+        writePosition.store(writePosition.load(std::memory_order_relaxed) + static_cast<uint64_t>(numFrames),
+                            std::memory_order_release);
+    }
+    
+    // Copies numFrames frames ending at endFrame (exclusive) into dest.
+    // Returns false if any of them were overwritten before the copy finished.
+    bool read(uint64_t endFrame, int numFrames, float* const* dest, int numDestChannels) const
+    {
+        if (numFrames <= 0 || numFrames > CAPACITY || endFrame < static_cast<uint64_t>(numFrames))
+            return false;
+        
+        const auto startFrame = endFrame - static_cast<uint64_t>(numFrames);
+        if (endFrame > writePosition.load(std::memory_order_acquire)
+            || startFrame < streamStart.load(std::memory_order_relaxed))
+            return false;
+        
+        for (int ch = 0; ch < std::min(numDestChannels, NUM_CHANNELS); ++ch)
+            for (int i = 0; i < numFrames; ++i)
+                dest[ch][i] = samples[ch][(startFrame + static_cast<uint64_t>(i)) % CAPACITY].load(std::memory_order_relaxed);
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return startFrame + CAPACITY >= writeReserve.load(std::memory_order_relaxed);
+    }
+    
+    // Host timeline position of a frame, or -1 if the transport wasn't running
+    int64_t getTimelinePosition(uint64_t frame) const
+    {
+        for (int attempt = 0; attempt < 4; ++attempt)
+        {
+            const auto sequence = anchorSequence.load(std::memory_order_acquire);
+            if (sequence & 1u)
+                continue;
+            
+            const auto frameAtAnchor = anchorFrame.load(std::memory_order_relaxed);
+            const auto timelineAtAnchor = anchorTimelineSamples.load(std::memory_order_relaxed);
+            const auto factor = decimation.load(std::memory_order_relaxed);
+            
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (anchorSequence.load(std::memory_order_relaxed) != sequence)
+                continue;
+            
+            if (timelineAtAnchor < 0 || factor <= 0)
+                return -1;
+            
+            return timelineAtAnchor + (static_cast<int64_t>(frame) - static_cast<int64_t>(frameAtAnchor)) * factor;
+        }
+        
+        return -1;
+    }
 };
 
 // Metering data sent FROM satellite TO master
@@ -33,24 +510,68 @@ struct SatelliteData
 {
     std::atomic<bool> active { false };
     std::atomic<uint64_t> instanceId { 0 };  // Unique ID for this satellite instance
+    std::atomic<int32_t> ownerPid { 0 };     // Process that owns the slot (0 = free)
+    std::atomic<uint32_t> generation { 0 };  // Bumped on every claim, so stale writers can tell they lost the slot
     std::atomic<float> rmsDb { -120.0f };
     std::atomic<float> peakDb { -120.0f };
     std::atomic<float> crestDb { 0.0f };
     std::atomic<float> phaseCorrelation { 1.0f };
     std::atomic<float> currentGain { 1.0f };
-    std::atomic<int64_t> lastUpdateTime { 0 };
+    std::atomic<int64_t> lastUpdateTime { 0 };  // Heartbeat (monotonic ms)
     char channelName[64] { 0 };
     std::atomic<int> sourceType { 0 };  // 0=Vocals, 1=Drums, etc.
     std::atomic<int> situationType { 0 }; // 0=Tracking, 1=Mixing, etc.
+    std::atomic<int> groupId { 0 };       // Subscribed group (0 = none)
+    
+    // Post-gain 1/3-octave band energy (dB), for the master's masking matrix.
+    // bandsVersion is odd while an update is being written and even once it is complete,
+    // so readers copy the bands and recheck it, like the audio ring's anchor.
+    std::atomic<float> bandEnergyDb[NUM_ANALYSIS_BANDS] {};
+    std::atomic<uint32_t> bandsVersion { 0 };
+
+    // No band data (bandsVersion 0 = the master treats the track as silent in the matrix)
+    void clearBands()
+    {
+        bandsVersion.store(0, std::memory_order_release);
+        for (auto& band : bandEnergyDb)
+            band.store(-120.0f, std::memory_order_relaxed);
+    }
+    
+    // Loudness computed on the satellite (post-gain), so the master does no per-track DSP.
+    // analysisProfile: 0=Lite (RMS/peak only), 1=Standard (+ LUFS/true peak), 2=Full (+ bands).
+    // Readings are -120 when the profile does not compute them.
+    std::atomic<int> analysisProfile { 2 };
+    std::atomic<float> momentaryLufs { -120.0f };
+    std::atomic<float> shortTermLufs { -120.0f };
+    std::atomic<float> integratedLufs { -120.0f };
+    std::atomic<float> truePeakDb { -120.0f };
+    
+    // processBlock cost over the last ~1 s (loads are fractions of the block deadline)
+    std::atomic<float> cpuAverageMicros { 0.0f };
+    std::atomic<float> cpuMaxMicros { 0.0f };
+    std::atomic<float> cpuAverageLoad { 0.0f };
+    std::atomic<float> cpuPeakLoad { 0.0f };
+    std::atomic<uint32_t> overrunCount { 0 };   // Blocks past their deadline since the instance started
+    std::atomic<uint32_t> nearMissCount { 0 };  // Blocks over half their deadline
+    
+    // Recent metering history, read in bulk by the master
+    MeterHistoryRing history;
+    
+    // Post-gain audio, only written while the master requests it
+    SatelliteAudioRing audio;
     
-    // Control data from master
+    // Control data from master: latest snapshot plus the ordered command queue
     SatelliteControlData control;
+    SatelliteCommandQueue commands;
+    SatelliteCommandSnapshot lastCommand;
+    std::atomic<uint64_t> appliedCommandSequence { 0 };  // Last command the satellite applied
+    IpcLatencyHistogram commandLatency;
 };
 
 struct SharedPluginData
 {
     static constexpr uint32_t MAGIC = 0x41523353; // "AR3S"
-    static constexpr uint32_t VERSION = 3;
+    static constexpr uint32_t VERSION = 17;
     
     std::atomic<uint32_t> magic { MAGIC };
     std::atomic<uint32_t> version { VERSION };
@@ -71,6 +592,32 @@ struct SharedPluginData
     std::atomic<int64_t> masterInitTime { 0 }; // When master was initialized
     std::atomic<int> masterThemeIndex { 0 };   // Theme index for uniform appearance
     std::atomic<int> masterKnobStyle { 0 };    // Knob style for uniform appearance
+    std::atomic<uint32_t> committedBatch { 0 }; // Newest command batch satellites may apply
+    std::atomic<uint32_t> nextBatchId { 0 };    // Batch ids are shared by every master, across reloads
+
+    // A batch id no master has used since the file was created
+    uint32_t allocateBatchId() { return nextBatchId.fetch_add(1) + 1; }
+
+    // Never moves backwards: another master may have committed a newer batch meanwhile
+    void commitBatch(uint32_t batchId)
+    {
+        auto committed = committedBatch.load(std::memory_order_relaxed);
+        while (committed < batchId
+               && ! committedBatch.compare_exchange_weak(committed, batchId, std::memory_order_release))
+        {
+        }
+    }
+    
+    // Slot churn across every process sharing the file (cumulative since creation),
+    // for spotting hosts that keep tearing down and re-creating instances
+    std::atomic<uint64_t> slotClaims { 0 };
+    std::atomic<uint64_t> slotTakeovers { 0 };   // Claims of a dead or hung owner's slot
+    std::atomic<uint64_t> slotReleases { 0 };
+    std::atomic<uint64_t> slotsReaped { 0 };
+    std::atomic<uint64_t> slotClaimFailures { 0 };  // Outages: an instance found every slot busy
+    
+    // Bumped by the master to ask every process to dump its trace (tracing builds only)
+    std::atomic<uint32_t> traceExportRequest { 0 };
     
     // Master metering data (for AI access from any plugin)
     std::atomic<float> masterRmsDb { -60.0f };
@@ -80,47 +627,133 @@ struct SharedPluginData
     std::atomic<float> masterShortTermLufs { -24.0f };
     std::atomic<float> masterIntegratedLufs { -24.0f };
     
+    // Group table, indexed by group id (entry 0 stays at zero offsets)
+    SatelliteGroupData groups[MAX_SATELLITE_GROUPS + 1];
+    
     // Satellite data array
     SatelliteData satellites[MAX_SATELLITES];
     
-    // Clear all satellite slots (call when master initializes)
-    void clearAllSatellites()
+    // A slot is abandoned when its owning process is gone, or when the owner is
+    // alive but hasn't heartbeated for SATELLITE_STALE_TIMEOUT_MS (hung host)
+    bool isSlotAbandoned(int index, int64_t nowMs) const
     {
-        for (int i = 0; i < MAX_SATELLITES; ++i)
-        {
-            satellites[i].active.store(false);
-            satellites[i].lastUpdateTime.store(0);
-        }
-        activeSatelliteCount.store(0);
+        const auto& sat = satellites[index];
+        const auto owner = sat.ownerPid.load();
+        if (owner == 0)
+            return !sat.active.load();
+        
+        return !isProcessAlive(owner) || (nowMs - sat.lastUpdateTime.load() > SATELLITE_STALE_TIMEOUT_MS);
     }
     
-    // Find an available slot for a new satellite
-    // Also clears stale satellites that haven't updated in 5+ seconds
-    int findAvailableSlot() 
+    // Atomically claim a slot for a satellite instance. Free slots are preferred;
+    // with allowTakeover a slot whose owner died (or stopped heartbeating) is taken over.
+    // Spotting a dead owner takes kill(), a syscall, so the audio thread only asks for
+    // free slots. Returns the slot index (and the new ownership generation) or -1 if full;
+    // the caller counts the failure in slotClaimFailures once per outage.
+    int claimSlot(uint64_t newInstanceId, int32_t pid, uint32_t& claimedGeneration, bool allowTakeover = true)
     {
-        auto currentTime = juce::Time::currentTimeMillis();
+        const auto nowMs = getMonotonicMillis();
         
-        // First pass: find completely inactive slot
-        for (int i = 0; i < MAX_SATELLITES; ++i)
+        for (int pass = 0; pass < (allowTakeover ? 2 : 1); ++pass)
         {
-            if (!satellites[i].active.load())
+            for (int i = 0; i < MAX_SATELLITES; ++i)
+            {
+                auto& sat = satellites[i];
+                auto owner = sat.ownerPid.load();
+                
+                // First pass: completely free slots. Second pass: dead or hung owners.
+                const bool claimable = (pass == 0) ? (owner == 0 && !sat.active.load())
+                                                   : (owner != 0 && isSlotAbandoned(i, nowMs));
+                if (!claimable)
+                    continue;
+                
+                // The PID swap is the ownership handover - losing the race just means
+                // another instance got this slot first
+                if (!sat.ownerPid.compare_exchange_strong(owner, pid))
+                    continue;
+                
+                claimedGeneration = sat.generation.fetch_add(1) + 1;
+                sat.clearBands();  // The previous owner's spectrum isn't this track's
+                sat.lastCommand.reset();  // Nor is its per-track control
+                sat.instanceId.store(newInstanceId);
+                sat.lastUpdateTime.store(nowMs);
+                sat.active.store(true);
+                slotClaims.fetch_add(1, std::memory_order_relaxed);
+                if (pass == 1)
+                    slotTakeovers.fetch_add(1, std::memory_order_relaxed);
                 return i;
+            }
         }
         
-        // Second pass: find stale slot (active but not updated in 5+ seconds)
+        return -1;
+    }
+    
+    // True while this instance still owns the slot at the generation it claimed
+    bool ownsSlot(int index, uint64_t ownerInstanceId, uint32_t ownerGeneration) const
+    {
+        if (index < 0 || index >= MAX_SATELLITES)
+            return false;
+        
+        const auto& sat = satellites[index];
+        return sat.active.load()
+            && sat.instanceId.load() == ownerInstanceId
+            && sat.generation.load() == ownerGeneration;
+    }
+    
+    // Give a slot back. The PID is cleared before the active flag so nobody can
+    // claim the slot while it is half torn down.
+    void releaseSlot(int index, uint64_t ownerInstanceId)
+    {
+        if (index < 0 || index >= MAX_SATELLITES)
+            return;
+        
+        auto& sat = satellites[index];
+        if (sat.instanceId.load() != ownerInstanceId)
+            return;
+        
+        sat.instanceId.store(0);
+        sat.lastUpdateTime.store(0);
+        sat.ownerPid.store(0);
+        sat.active.store(false);
+        slotReleases.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // Free every slot whose owning process no longer exists. Makes ghost tracks
+    // from crashed hosts disappear immediately instead of after a timeout.
+    // Returns the number of slots reaped.
+    int reapDeadOwners()
+    {
+        int reaped = 0;
+        
         for (int i = 0; i < MAX_SATELLITES; ++i)
         {
-            auto lastUpdate = satellites[i].lastUpdateTime.load();
-            if (currentTime - lastUpdate > 5000)
-            {
-                // Clear the stale slot
-                satellites[i].active.store(false);
-                satellites[i].lastUpdateTime.store(0);
-                return i;
-            }
+            auto& sat = satellites[i];
+            auto owner = sat.ownerPid.load();
+            if (owner == 0 || isProcessAlive(owner))
+                continue;
+            
+            // If a new owner swapped in first, the slot is no longer ours to clear
+            if (!sat.ownerPid.compare_exchange_strong(owner, 0))
+                continue;
+            
+            sat.instanceId.store(0);
+            sat.lastUpdateTime.store(0);
+            sat.active.store(false);
+            ++reaped;
         }
         
-        return -1;
+        if (reaped > 0)
+            slotsReaped.fetch_add(static_cast<uint64_t>(reaped), std::memory_order_relaxed);
+        return reaped;
+    }
+    
+    // Live = claimed by a process and heartbeating within the timeout
+    bool isSlotLive(int index, int64_t nowMs, int64_t timeoutMs) const
+    {
+        const auto& sat = satellites[index];
+        return sat.active.load()
+            && sat.ownerPid.load() != 0
+            && (nowMs - sat.lastUpdateTime.load() < timeoutMs);
     }
 };
 
@@ -136,8 +769,10 @@ public:
     
     bool openOrCreate()
     {
-        // Use a file in /tmp for cross-plugin communication (works on macOS without sandboxing issues)
-        juce::File shmFile("/tmp/ar3s_shared_memory.bin");
+        // Use a file in /tmp for cross-plugin communication (works on macOS without sandboxing issues).
+        // AR3S_SHARED_MEMORY_FILE moves it, so the benchmarks never touch a running session's file.
+        const char* envPath = std::getenv("AR3S_SHARED_MEMORY_FILE");
+        juce::File shmFile(envPath != nullptr && *envPath != 0 ? juce::String(envPath) : juce::String("/tmp/ar3s_shared_memory.bin"));
         filePath = shmFile.getFullPathName();
         
         bool needsInit = false;
@@ -149,7 +784,7 @@ public:
             juce::FileOutputStream fos(shmFile);
             if (!fos.openedOk())
             {
-                DBG("AR3S SharedMemory: Failed to create file");
+                AR3S_LOG_ERROR("SharedMemory", "Failed to create file, errno={}", errno);
                 return false;
             }
             
@@ -159,14 +794,14 @@ public:
             fos.flush();
             needsInit = true;
             isCreator = true;
-            DBG("AR3S SharedMemory: Created new file");
+            AR3S_LOG_INFO("SharedMemory", "Created new file");
         }
         
         // Open the file for memory mapping
         fd = ::open(filePath.toRawUTF8(), O_RDWR);
         if (fd < 0)
         {
-            DBG("AR3S SharedMemory: Failed to open file, errno=" + juce::String(errno));
+            AR3S_LOG_ERROR("SharedMemory", "Failed to open file, errno={}", errno);
             return false;
         }
         
@@ -184,21 +819,29 @@ public:
         
         if (data == MAP_FAILED)
         {
-            DBG("AR3S SharedMemory: mmap failed, errno=" + juce::String(errno));
+            AR3S_LOG_ERROR("SharedMemory", "mmap failed, errno={}", errno);
             data = nullptr;
             ::close(fd);
             fd = -1;
             return false;
         }
         
+        // Re-initialize if the file was written by a build with a different layout
+        if (!needsInit && (data->magic.load() != SharedPluginData::MAGIC
+                           || data->version.load() != SharedPluginData::VERSION))
+        {
+            AR3S_LOG_WARNING("SharedMemory", "Layout version changed, re-initializing");
+            needsInit = true;
+        }
+        
         // Initialize if we created it or it's new
         if (needsInit)
         {
             new (data) SharedPluginData();
-            DBG("AR3S SharedMemory: Initialized new shared data");
+            AR3S_LOG_INFO("SharedMemory", "Initialized new shared data (layout version {})", SharedPluginData::VERSION);
         }
         
-        DBG("AR3S SharedMemory: Successfully mapped, data=" + juce::String::toHexString((int64_t)data));
+        AR3S_LOG_INFO("SharedMemory", "Mapped shared data");
         return true;
     }
     
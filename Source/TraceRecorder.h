@@ -0,0 +1,199 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <chrono>
+#include <unistd.h>
+#include "DataDirectory.h"
+
+// Scoped begin/end tracing for dropout hunting, exported as Chrome trace JSON
+// (loads in chrome://tracing and ui.perfetto.dev).
+//
+// Compiled in only with AR3S_ENABLE_TRACING=1 (CMake option AR3S_TRACING). When
+// it is off AR3S_TRACE_SCOPE expands to nothing, so release builds pay nothing.
+// When it is on, each scope costs two clock reads and one store into the calling
+// thread's own ring - no locks, no allocation after the thread's first event.
+//
+// Rings are handed out per thread for the life of the process and never recycled
+// (that would need thread-exit hooks, which aren't safe in a plugin the host can
+// unload). Threads beyond MAX_THREADS are not recorded; the export notes how many.
+#ifndef AR3S_ENABLE_TRACING
+ #define AR3S_ENABLE_TRACING 0
+#endif
+
+class TraceRecorder
+{
+public:
+    static constexpr int MAX_THREADS = 32;
+    static constexpr int EVENTS_PER_THREAD = 16384;  // Oldest events are overwritten
+
+    struct Event
+    {
+        const char* name = nullptr;  // Must be a string literal
+        int64_t startNs = 0;
+        int64_t endNs = 0;
+    };
+
+    static TraceRecorder& getInstance()
+    {
+        static TraceRecorder instance;
+        return instance;
+    }
+
+    static int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Names the calling thread in the exported trace (string literal)
+    void setThreadName(const char* name)
+    {
+        if (auto* buffer = getThreadBuffer())
+            buffer->threadName.store(name, std::memory_order_relaxed);
+    }
+
+    void record(const char* name, int64_t startNs, int64_t endNs)
+    {
+        auto* buffer = getThreadBuffer();
+        if (buffer == nullptr)
+            return;  // More threads than buffers - drop rather than block
+
+        // The fence keeps the slot's stores after the previous writeIndex store, so a
+        // reader that sees any of them also sees the writer has lapped its entry
+        const auto w = buffer->writeIndex.load(std::memory_order_relaxed);
+        auto& slot = buffer->events[w % EVENTS_PER_THREAD];
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.startNs.store(startNs, std::memory_order_relaxed);
+        slot.endNs.store(endNs, std::memory_order_relaxed);
+        buffer->writeIndex.store(w + 1, std::memory_order_release);
+    }
+
+    // Every instance in a process watches the same export request, but the rings are
+    // process-wide: true for the first caller to see this request, false for the rest
+    bool claimExport(uint32_t request)
+    {
+        return lastExportRequest.exchange(request, std::memory_order_acq_rel) != request;
+    }
+
+    // Writes every buffered event as Chrome trace JSON. Safe to call while other
+    // threads keep recording; events that may have been overwritten are skipped.
+    bool writeChromeTrace(const juce::File& file) const
+    {
+        const auto pid = static_cast<int>(::getpid());
+        juce::String json;
+        json << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+
+        const int registeredThreads = threadCount.load(std::memory_order_acquire);
+        const int numThreads = std::min(registeredThreads, MAX_THREADS);
+        if (registeredThreads > MAX_THREADS)
+        {
+            json << "{\"name\":\"process_labels\",\"ph\":\"M\",\"pid\":" << pid << ",\"args\":{\"labels\":\""
+                 << juce::String(registeredThreads - MAX_THREADS) << " threads not traced\"}}";
+            first = false;
+        }
+        for (int t = 0; t < numThreads; ++t)
+        {
+            const auto& buffer = threads[t];
+            const char* threadName = buffer.threadName.load(std::memory_order_relaxed);
+            json << (first ? "" : ",") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+                 << ",\"tid\":" << t << ",\"args\":{\"name\":\""
+                 << (threadName != nullptr ? juce::String(threadName) : "thread " + juce::String(t)) << "\"}}";
+            first = false;
+
+            const auto end = buffer.writeIndex.load(std::memory_order_acquire);
+            const auto begin = end > static_cast<uint64_t>(EVENTS_PER_THREAD) ? end - EVENTS_PER_THREAD : 0;
+            for (auto i = begin; i < end; ++i)
+            {
+                const auto& slot = buffer.events[i % EVENTS_PER_THREAD];
+                Event event;
+                event.name = slot.name.load(std::memory_order_relaxed);
+                event.startNs = slot.startNs.load(std::memory_order_relaxed);
+                event.endNs = slot.endNs.load(std::memory_order_relaxed);
+
+                // Once the writer has reached entry i + EVENTS_PER_THREAD it may have been
+                // mid-way through overwriting this slot while we copied it
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (buffer.writeIndex.load(std::memory_order_relaxed) - i >= static_cast<uint64_t>(EVENTS_PER_THREAD)
+                    || event.name == nullptr)
+                    continue;
+
+                json << ",{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << t
+                     << ",\"ts\":" << juce::String(static_cast<double>(event.startNs) / 1000.0, 3)
+                     << ",\"dur\":" << juce::String(static_cast<double>(event.endNs - event.startNs) / 1000.0, 3) << "}";
+            }
+        }
+
+        json << "]}";
+        file.getParentDirectory().createDirectory();
+        return file.replaceWithText(json);
+    }
+
+    // Default export location: ARES/traces/ar3s_<pid>_<time>.json
+    static juce::File getDefaultTraceFile()
+    {
+        return getAresDataDirectory()
+            .getChildFile("traces")
+            .getChildFile("ar3s_" + juce::String(static_cast<int>(::getpid())) + "_"
+                          + juce::Time::getCurrentTime().formatted("%Y%m%d_%H%M%S") + ".json");
+    }
+
+private:
+    // One Event, stored field by field so the exporter can read it while it's rewritten
+    struct EventSlot
+    {
+        std::atomic<const char*> name { nullptr };
+        std::atomic<int64_t> startNs { 0 };
+        std::atomic<int64_t> endNs { 0 };
+    };
+
+    struct ThreadBuffer
+    {
+        std::atomic<uint64_t> writeIndex { 0 };
+        std::atomic<const char*> threadName { nullptr };
+        EventSlot events[EVENTS_PER_THREAD];
+    };
+
+    TraceRecorder() = default;
+
+    ThreadBuffer* getThreadBuffer()
+    {
+        thread_local ThreadBuffer* buffer = nullptr;
+        thread_local bool registered = false;
+        if (!registered)
+        {
+            registered = true;
+            const int index = threadCount.fetch_add(1, std::memory_order_acq_rel);
+            buffer = index < MAX_THREADS ? &threads[index] : nullptr;
+        }
+        return buffer;
+    }
+
+    std::atomic<int> threadCount { 0 };  // Threads that ever recorded, including dropped ones
+    std::atomic<uint32_t> lastExportRequest { 0 };
+    ThreadBuffer threads[MAX_THREADS];
+};
+
+// Records the enclosing scope as one complete ("X") event
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* scopeName) : name(scopeName), startNs(TraceRecorder::nowNs()) {}
+    ~TraceScope() { TraceRecorder::getInstance().record(name, startNs, TraceRecorder::nowNs()); }
+
+private:
+    const char* name;
+    int64_t startNs;
+};
+
+#if AR3S_ENABLE_TRACING
+ #define AR3S_TRACE_CONCAT_INNER(a, b) a##b
+ #define AR3S_TRACE_CONCAT(a, b) AR3S_TRACE_CONCAT_INNER(a, b)
+ #define AR3S_TRACE_SCOPE(name) const TraceScope AR3S_TRACE_CONCAT(traceScope_, __COUNTER__) (name)
+ #define AR3S_TRACE_THREAD_NAME(name) TraceRecorder::getInstance().setThreadName(name)
+#else
+ #define AR3S_TRACE_SCOPE(name)
+ #define AR3S_TRACE_THREAD_NAME(name)
+#endif